@@ -0,0 +1,115 @@
+#version 330 core
+
+// Horizonte artificial analítico (AttitudeIndicator): un quad, todo acá.
+// vTexCoord = posición en píxeles del HUD relativa al centro (y hacia abajo)
+
+in vec4 vColor;
+in vec2 vTexCoord;
+in vec2 vPos;
+flat in vec4 vClip;
+out vec4 FragColor;
+
+uniform vec4 uParams; // pitch (°), roll (°, derecha positivo), píxeles por grado, radio (px)
+
+const vec4 SKY = vec4(0.10, 0.35, 0.75, 0.30);
+const vec4 GROUND = vec4(0.45, 0.28, 0.10, 0.30);
+const float LINE = 1.0;       // media línea (px)
+const float RUNG_STEP = 5.0;  // grados entre peldaños
+
+// Cobertura de una línea a distancia d (en px de pantalla): 1 px de borde suave
+float line(float d, float halfWidth, float px)
+{
+    return clamp(halfWidth + 0.5 - d / px, 0.0, 1.0);
+}
+
+// Distancia a un segmento
+float segment(vec2 p, vec2 a, vec2 b)
+{
+    vec2 ab = b - a;
+    float t = clamp(dot(p - a, ab) / dot(ab, ab), 0.0, 1.0);
+    return length(p - a - ab * t);
+}
+
+void main() {
+    // Derivadas antes de cualquier discard: después el control de flujo ya no es
+    // uniforme en el quad de 2x2 y fwidth queda indefinido
+    vec2 p = vTexCoord;
+    float px = max(length(fwidth(p)) * 0.7071, 1e-4); // unidades del HUD por píxel real
+
+    if (vPos.x < vClip.x || vPos.y < vClip.y || vPos.x > vClip.z || vPos.y > vClip.w)
+        discard;
+
+    float radius = uParams.w;
+    float r = length(p);
+    float inside = clamp((radius - r) / px + 0.5, 0.0, 1.0);
+    if (inside <= 0.0)
+        discard;
+
+    // Marco del horizonte: con roll a la derecha el mundo gira a la izquierda
+    float roll = radians(uParams.y);
+    vec2 along = vec2(cos(roll), -sin(roll));
+    vec2 down = vec2(sin(roll), cos(roll));
+    vec2 h = vec2(dot(p, along), dot(p, down));
+    float ppd = uParams.z;
+    float y = h.y - uParams.x * ppd; // 0 en el horizonte, > 0 tierra
+
+    // Cielo/tierra con el borde suavizado
+    vec4 color = mix(SKY, GROUND, clamp(y / px + 0.5, 0.0, 1.0));
+    float ink = 0.0;
+
+    // Horizonte, de lado a lado
+    ink = max(ink, line(abs(y), LINE, px));
+
+    // Escalera: peldaño más cercano (sin el 0, que es el horizonte)
+    float deg = -y / ppd;
+    float rung = RUNG_STEP * floor(deg / RUNG_STEP + 0.5);
+    if (rung != 0.0 && abs(rung) <= 90.0)
+    {
+        bool major = mod(rung, 10.0) == 0.0;
+        float halfLength = radius * (major ? 0.30 : 0.15);
+        float gap = radius * 0.08;
+        vec2 q = vec2(abs(h.x), (deg - rung) * ppd);
+        float d = segment(q, vec2(gap, 0.0), vec2(halfLength, 0.0));
+        // Patas hacia el horizonte en las puntas de los mayores
+        if (major)
+            d = min(d, segment(q, vec2(halfLength, 0.0), vec2(halfLength, -sign(rung) * radius * 0.04)));
+        float coverage = line(d, LINE * (major ? 1.0 : 0.75), px);
+        // Abajo del horizonte, punteados
+        if (rung < 0.0)
+            coverage *= step(fract(abs(h.x) / (radius * 0.05)), 0.6);
+        ink = max(ink, coverage);
+    }
+
+    // Escala de roll fija arriba: 0, 10, 20, 30, 45, 60 a cada lado
+    float angle = degrees(atan(p.x, -p.y));
+    float tick = 1e6;
+    float tickLength = 0.0;
+    const float TICKS[6] = float[](0.0, 10.0, 20.0, 30.0, 45.0, 60.0);
+    for (int i = 0; i < 6; ++i)
+    {
+        float d = abs(abs(angle) - TICKS[i]);
+        if (d < tick)
+        {
+            tick = d;
+            tickLength = (TICKS[i] == 30.0 || TICKS[i] == 60.0) ? 0.10 : 0.06;
+        }
+    }
+    float rOuter = radius * 0.95;
+    float radial = max(rOuter - tickLength * radius - r, r - rOuter);
+    ink = max(ink, line(max(radians(tick) * r, radial), LINE, px) * step(abs(angle), 61.0));
+
+    // Puntero de roll: triángulo que gira con el horizonte, apuntando a la escala
+    vec2 t = vec2(abs(h.x), h.y + rOuter - radius * 0.11); // punta en (0, 0), bajo las marcas
+    float tri = max(max(-t.y, (t.x - 0.6 * t.y) / 1.166), t.y - radius * 0.06);
+    ink = max(ink, clamp(0.5 - tri / px, 0.0, 1.0));
+
+    // Avión fijo: alas y punto central
+    vec2 a = vec2(abs(p.x), p.y);
+    float wing = min(segment(a, vec2(radius * 0.12, 0.0), vec2(radius * 0.32, 0.0)),
+                     segment(a, vec2(radius * 0.12, 0.0), vec2(radius * 0.12, radius * 0.05)));
+    ink = max(ink, line(wing, LINE * 1.5, px));
+    ink = max(ink, line(r, LINE * 2.0, px));
+
+    color = mix(color, vColor, ink);
+    FragColor = vec4(color.rgb, color.a * inside);
+}
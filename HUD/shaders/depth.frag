@@ -0,0 +1,5 @@
+#version 330 core
+
+// Pre-pass de profundidad: sin salida de color, solo escribe el depth buffer
+void main() {
+}
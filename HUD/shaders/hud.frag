@@ -1,8 +1,16 @@
 #version 330 core
 
 in vec4 vColor;
+in vec2 vTexCoord;
+in vec2 vPos;
+flat in vec4 vClip;
 out vec4 FragColor;
 
+uniform sampler2D uTexture; // blanca 1x1 si la primitiva no tiene textura
+
 void main() {
-    FragColor = vColor;
+    // Recorte por rectángulo (pushClipRect): va en el vértice, no corta el batch
+    if (vPos.x < vClip.x || vPos.y < vClip.y || vPos.x > vClip.z || vPos.y > vClip.w)
+        discard;
+    FragColor = vColor * texture(uTexture, vTexCoord);
 }
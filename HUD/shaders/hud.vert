@@ -2,12 +2,27 @@
 
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in vec4 aClip; // x0, y0, x1, y1 en píxeles del HUD
+layout (location = 4) in uint aViewBits; // grupos del vértice (Renderer2D::setViewBits)
 
 out vec4 vColor;
+out vec2 vTexCoord;
+out vec2 vPos;
+flat out vec4 vClip;
 
-uniform mat4 uProjection;
+uniform mat4 uProjection; // región del lienzo de la vista → NDC
+uniform uint uViewMask;   // grupos que muestra la vista
 
 void main() {
-    gl_Position = uProjection * vec4(aPos, 0.0, 1.0);
+    // Fuera de la vista: todos los vértices de la primitiva caen fuera del
+    // volumen de recorte y el rasterizador la descarta entera
+    if ((aViewBits & uViewMask) == 0u)
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    else
+        gl_Position = uProjection * vec4(aPos, 0.0, 1.0);
     vColor = aColor;
+    vTexCoord = aTexCoord;
+    vPos = aPos;
+    vClip = aClip;
 }
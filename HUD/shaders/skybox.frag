@@ -7,5 +7,5 @@ in vec3 TexCoords;
 uniform samplerCube uCube;
 
 void main() {
-    FragColor = texture(uCube, TexCoords);
+    FragColor = texture(uCube, normalize(TexCoords));
 }
@@ -1,14 +1,17 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-
 out vec3 TexCoords;
 
-uniform mat4 uView;
-uniform mat4 uProj;
+uniform mat4 uInvViewProj; // inversa de (proyección * vista sin traslación)
 
 void main() {
-    TexCoords = aPos;
-    vec4 pos = uProj * uView * vec4(aPos, 1.0);
-    gl_Position = pos.xyww; // Trick para que el skybox esté siempre en el fondo
+    // Triángulo que cubre toda la pantalla sin VBO: (-1,-1), (3,-1), (-1,3)
+    vec2 ndc = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+
+    // Rayo de vista: punto del plano lejano en mundo (la vista no tiene traslación)
+    vec4 world = uInvViewProj * vec4(ndc, 1.0, 1.0);
+    TexCoords = world.xyz / world.w;
+
+    // z = w → profundidad 1.0: solo pasa el test donde no se dibujó geometría
+    gl_Position = vec4(ndc, 1.0, 1.0);
 }
@@ -0,0 +1,17 @@
+#version 330 core
+
+// Skybox anterior (cubo de 36 vértices dibujado antes de la geometría).
+// Solo lo usa SkyboxRenderer::measureCubePath para comparar fragmentos.
+
+layout (location = 0) in vec3 aPos;
+
+out vec3 TexCoords;
+
+uniform mat4 uView;
+uniform mat4 uProj;
+
+void main() {
+    TexCoords = aPos;
+    vec4 pos = uProj * uView * vec4(aPos, 1.0);
+    gl_Position = pos.xyww; // Trick para que el skybox esté siempre en el fondo
+}
@@ -5,12 +5,37 @@ layout(location=1) in vec3 aNormal;
 uniform mat4 uViewProj;
 uniform vec3 uGridOffset;   // XZ del "snap", y = groundY
 
+// Relieve (Heightfield de CPU como GL_R32F); uHeightSpacing = 0 → plano
+uniform sampler2D uHeightmap;
+uniform float uHeightScale;   // uv = xz * scale + bias
+uniform float uHeightBias;
+uniform float uHeightSpacing; // m entre muestras
+
 out vec3 vWorldPos;
 out vec3 vNormal;
 
+// El pre-pass de profundidad (depth.frag) y el de color se linkean por separado:
+// sin invariant el compilador puede dar otra profundidad y el GL_LEQUAL fallar
+invariant gl_Position;
+
+float terrainHeight(vec2 xz) {
+    return textureLod(uHeightmap, xz * uHeightScale + uHeightBias, 0.0).r;
+}
+
 void main() {
     vec3 wp = aPos + uGridOffset;
+    vec3 n = aNormal; // (0,1,0) para plano
+
+    if (uHeightSpacing > 0.0) {
+        // Mismo bilineal que las consultas de colisión; normal por diferencias centrales
+        wp.y += terrainHeight(wp.xz);
+        float e = uHeightSpacing;
+        float dx = terrainHeight(wp.xz + vec2(e, 0.0)) - terrainHeight(wp.xz - vec2(e, 0.0));
+        float dz = terrainHeight(wp.xz + vec2(0.0, e)) - terrainHeight(wp.xz - vec2(0.0, e));
+        n = normalize(vec3(-dx, 2.0 * e, -dz));
+    }
+
     vWorldPos = wp;
-    vNormal = aNormal; // (0,1,0) para plano
+    vNormal = n;
     gl_Position = uViewProj * vec4(wp, 1.0);
 }
@@ -0,0 +1,193 @@
+#include "flight/AirData.h"
+#include "flight/FlightData.h"
+#include <algorithm>
+#include <cmath>
+
+namespace flight
+{
+
+    // Exponente de la troposfera: g/(R·L) ≈ 5.2559
+    static constexpr double PRESSURE_EXPONENT =
+        AirData::kGravity / (static_cast<double>(AirData::kGasConstant) * AirData::kLapseRate);
+    static constexpr double TROPOPAUSE_TEMPERATURE =
+        AirData::kSeaLevelTemperature - AirData::kLapseRate * AirData::kTropopause;
+
+    // δ en la tropopausa. Static local y no global: std::pow no es constexpr y hay
+    // AirData globales (main.cpp) cuyo constructor llega acá durante la inicialización
+    // estática, sin orden garantizado entre unidades de traducción
+    static double tropopausePressureRatio()
+    {
+        static const double ratio = std::pow(TROPOPAUSE_TEMPERATURE / AirData::kSeaLevelTemperature, PRESSURE_EXPONENT);
+        return ratio;
+    }
+
+    // ============================== Fórmulas ISA ==============================
+
+    float AirData::isaPressureRatio(float h)
+    {
+        if (h <= kTropopause)
+            return static_cast<float>(std::pow(1.0 - kLapseRate * h / kSeaLevelTemperature, PRESSURE_EXPONENT));
+        // Estratosfera baja: isoterma
+        return static_cast<float>(tropopausePressureRatio() *
+                                  std::exp(-kGravity * (h - kTropopause) / (kGasConstant * TROPOPAUSE_TEMPERATURE)));
+    }
+
+    float AirData::isaPressureAltitude(float p)
+    {
+        const double delta = p / static_cast<double>(kSeaLevelPressure);
+        const double tropopauseDelta = tropopausePressureRatio();
+        if (delta >= tropopauseDelta)
+            return static_cast<float>(kSeaLevelTemperature / kLapseRate * (1.0 - std::pow(delta, 1.0 / PRESSURE_EXPONENT)));
+        return static_cast<float>(kTropopause + kGasConstant * TROPOPAUSE_TEMPERATURE / kGravity *
+                                                    std::log(tropopauseDelta / delta));
+    }
+
+    // ============================== Tablas ==============================
+
+    AirData::AirData(const AirDataConfig &config)
+    {
+        configure(config);
+    }
+
+    void AirData::configure(const AirDataConfig &config)
+    {
+        config_ = config;
+        std::sort(config_.wind.begin(), config_.wind.end(),
+                  [](const WindLayer &a, const WindLayer &b) { return a.altitude < b.altitude; });
+
+        datumOffset_ = config_.fieldElevation.value() - FlightData::kAltitudeDatum.value();
+        count_ = static_cast<std::size_t>((kMaxAltitude - kMinAltitude) / kTableStep) + 1;
+
+        for (std::vector<float> *t : {&pressure_, &density_, &sqrtDensityRatio_, &pressureAltitude_,
+                                      &indicatedAltitude_, &windX_, &windZ_})
+            t->assign(count_, 0.0f);
+
+        // El altímetro resta la altitud de presión de su ajuste
+        const float settingAltitude = isaPressureAltitude(config_.altimeterSetting);
+        const double pressureScale = config_.seaLevelPressure / static_cast<double>(kSeaLevelPressure);
+
+        // Viento por componentes (hacia donde sopla: del 270 → hacia +X)
+        auto windComponents = [](const WindLayer &l, float &x, float &z)
+        {
+            const float from = units::Radians(l.fromDirection).value();
+            const float speed = units::MetersPerSecond(l.speed).value();
+            x = -speed * std::sin(from);
+            z = speed * std::cos(from);
+        };
+
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            const float h = kMinAltitude + static_cast<float>(i) * kTableStep;
+
+            // Presión: perfil ISA escalado por la presión real al nivel del mar
+            const double p = pressureScale * kSeaLevelPressure * isaPressureRatio(h);
+            const double isaT = h <= kTropopause ? kSeaLevelTemperature - kLapseRate * h : TROPOPAUSE_TEMPERATURE;
+            const double rho = p / (kGasConstant * (isaT + config_.temperatureOffset));
+
+            pressure_[i] = static_cast<float>(p);
+            density_[i] = static_cast<float>(rho);
+            sqrtDensityRatio_[i] = static_cast<float>(std::sqrt(rho / kSeaLevelDensity));
+            pressureAltitude_[i] = isaPressureAltitude(static_cast<float>(p));
+            indicatedAltitude_[i] = pressureAltitude_[i] - settingAltitude;
+
+            // Viento: interpolar entre las capas que rodean h
+            const std::vector<WindLayer> &layers = config_.wind;
+            if (layers.empty())
+                continue;
+            const float above = h - config_.fieldElevation.value(); // las capas son sobre el campo
+            auto hi = std::find_if(layers.begin(), layers.end(),
+                                   [above](const WindLayer &l) { return l.altitude.value() > above; });
+            float x0, z0, x1, z1;
+            if (hi == layers.begin() || hi == layers.end())
+            {
+                windComponents(hi == layers.end() ? layers.back() : layers.front(), x0, z0);
+                windX_[i] = x0;
+                windZ_[i] = z0;
+                continue;
+            }
+            const WindLayer &lo = *(hi - 1);
+            windComponents(lo, x0, z0);
+            windComponents(*hi, x1, z1);
+            const float t = (above - lo.altitude.value()) / (hi->altitude - lo.altitude).value();
+            windX_[i] = x0 + (x1 - x0) * t;
+            windZ_[i] = z0 + (z1 - z0) * t;
+        }
+    }
+
+    // ============================== Consultas ==============================
+
+    float AirData::pressure(float altitude) const
+    {
+        std::size_t i;
+        float t;
+        locate(altitude, i, t);
+        return lerp(pressure_, i, t);
+    }
+
+    float AirData::density(float altitude) const
+    {
+        std::size_t i;
+        float t;
+        locate(altitude, i, t);
+        return lerp(density_, i, t);
+    }
+
+    glm::vec3 AirData::wind(float altitude) const
+    {
+        std::size_t i;
+        float t;
+        locate(altitude, i, t);
+        return glm::vec3(lerp(windX_, i, t), 0.0f, lerp(windZ_, i, t));
+    }
+
+    units::Meters AirData::altitudeOf(const glm::vec3 &worldPosition) const
+    {
+        return units::Meters(worldPosition.y + datumOffset_);
+    }
+
+    AirDataSample AirData::evaluate(const glm::vec3 &position, const glm::vec3 &velocity) const
+    {
+        std::size_t i;
+        float t;
+        locate(position.y + datumOffset_, i, t);
+
+        AirDataSample s;
+        s.wind = glm::vec3(lerp(windX_, i, t), 0.0f, lerp(windZ_, i, t));
+        const units::MetersPerSecond tas(glm::length(velocity - s.wind));
+        const float sqrtSigma = lerp(sqrtDensityRatio_, i, t);
+
+        s.trueAirspeed = tas;
+        s.indicatedAirspeed = tas * sqrtSigma;
+        s.densityRatio = sqrtSigma * sqrtSigma;
+        s.pressureAltitude = units::Meters(lerp(pressureAltitude_, i, t));
+        s.indicatedAltitude = units::Meters(lerp(indicatedAltitude_, i, t));
+        return s;
+    }
+
+    void AirData::evaluate(const float *posY, const float *velX, const float *velY, const float *velZ,
+                           float *trueAirspeed, float *indicatedAirspeed, float *indicatedAltitude,
+                           std::size_t count) const
+    {
+        constexpr float MPS_TO_KT = units::factor<units::MetersPerSecond, units::Knots>();
+        constexpr float M_TO_FT = units::factor<units::Meters, units::Feet>();
+        const float *__restrict WX = windX_.data(), *__restrict WZ = windZ_.data();
+        const float *__restrict SS = sqrtDensityRatio_.data(), *__restrict IA = indicatedAltitude_.data();
+
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            std::size_t i;
+            float t;
+            locate(posY[k] + datumOffset_, i, t);
+
+            const float wx = WX[i] + (WX[i + 1] - WX[i]) * t;
+            const float wz = WZ[i] + (WZ[i + 1] - WZ[i]) * t;
+            const float ax = velX[k] - wx, ay = velY[k], az = velZ[k] - wz;
+            const float tas = std::sqrt(ax * ax + ay * ay + az * az);
+
+            trueAirspeed[k] = tas * MPS_TO_KT;
+            indicatedAirspeed[k] = tas * (SS[i] + (SS[i + 1] - SS[i]) * t) * MPS_TO_KT;
+            indicatedAltitude[k] = (IA[i] + (IA[i + 1] - IA[i]) * t) * M_TO_FT;
+        }
+    }
+
+} // namespace flight
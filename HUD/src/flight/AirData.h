@@ -0,0 +1,118 @@
+// flight/AirData.h
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "flight/Units.h"
+
+namespace flight
+{
+    // Capa de viento: entre capas se interpola por componentes; fuera, constante
+    struct WindLayer
+    {
+        units::Meters altitude{0.0f};      // sobre el nivel del campo
+        units::Degrees fromDirection{0.0f}; // de dónde viene (meteorológico: 270 = del oeste)
+        units::Knots speed{0.0f};
+    };
+
+    struct AirDataConfig
+    {
+        float seaLevelPressure = 101325.0f;  // Pa, presión real al nivel del campo (QNH del clima)
+        float temperatureOffset = 0.0f;      // K, desvío ISA (ISA+ΔT); sólo afecta la densidad
+        float altimeterSetting = 101325.0f;  // Pa, lo que el piloto puso en el altímetro
+        units::Meters fieldElevation{0.0f};  // altitud del campo (y = FlightData::kAltitudeDatum)
+        std::vector<WindLayer> wind;         // vacío = calma
+    };
+
+    // Datos de aire de un avión
+    struct AirDataSample
+    {
+        units::Knots trueAirspeed{0.0f};
+        units::Knots indicatedAirspeed{0.0f};
+        units::Feet pressureAltitude{0.0f};  // altímetro en 1013.25 hPa
+        units::Feet indicatedAltitude{0.0f}; // altímetro en altimeterSetting
+        float densityRatio = 1.0f;           // σ = ρ/ρ0
+        glm::vec3 wind = glm::vec3(0.0f);    // m/s (mundo, hacia donde sopla)
+    };
+
+    /**
+     * Atmósfera ISA + campo de viento, tabulados.
+     *
+     * configure() evalúa las fórmulas ISA (pow/exp) una vez sobre una grilla de
+     * altitud geométrica cada kTableStep metros; después todo es interpolación
+     * lineal en tablas de ~30 KB: un índice, un par de lerps por magnitud y una
+     * raíz (|v − viento|) por avión. Error de tabla < 1e-5 relativo (ver --bench airdata).
+     *
+     * La altitud se mide desde la posición del mundo: y − kAltitudeDatum +
+     * fieldElevation. IAS se aproxima como EAS = TAS·√σ (sin compresibilidad,
+     * error < 1 % por debajo de ~200 kt).
+     *
+     * Sólo lectura después de configure(): se puede compartir entre hilos.
+     */
+    class AirData
+    {
+    public:
+        static constexpr float kMinAltitude = -1000.0f; // m (MSL)
+        static constexpr float kMaxAltitude = 20000.0f; // m; más arriba se recorta
+        static constexpr float kTableStep = 25.0f;      // m
+
+        // Constantes ISA
+        static constexpr float kSeaLevelPressure = 101325.0f; // Pa
+        static constexpr float kSeaLevelTemperature = 288.15f; // K
+        static constexpr float kSeaLevelDensity = 1.225f;     // kg/m³
+        static constexpr float kLapseRate = 0.0065f;          // K/m (troposfera)
+        static constexpr float kTropopause = 11000.0f;        // m
+        static constexpr float kGasConstant = 287.053f;       // J/(kg·K)
+        static constexpr float kGravity = 9.80665f;           // m/s²
+
+        explicit AirData(const AirDataConfig &config = AirDataConfig{});
+
+        // Recalcula las tablas (no mientras otro hilo lee)
+        void configure(const AirDataConfig &config);
+        const AirDataConfig &config() const { return config_; }
+
+        // --- Consultas por altitud MSL (m) ---
+        float pressure(float altitude) const;     // Pa
+        float density(float altitude) const;      // kg/m³
+        glm::vec3 wind(float altitude) const;     // m/s
+        units::Meters altitudeOf(const glm::vec3 &worldPosition) const; // MSL
+
+        // Un avión: posición y velocidad respecto del suelo (mundo)
+        AirDataSample evaluate(const glm::vec3 &position, const glm::vec3 &velocity) const;
+
+        // Lote SoA [0, count): TAS/IAS en kt, altitud indicada en ft
+        void evaluate(const float *posY, const float *velX, const float *velY, const float *velZ,
+                      float *trueAirspeed, float *indicatedAirspeed, float *indicatedAltitude,
+                      std::size_t count) const;
+
+        // --- Fórmulas directas (pow/exp): construir tablas y verificarlas ---
+        static float isaPressureRatio(float pressureAltitude); // δ(h) estándar
+        static float isaPressureAltitude(float pressure);      // inversa de δ, m
+
+    private:
+        // Índice y fracción en la grilla (recortado a la tabla)
+        void locate(float altitude, std::size_t &index, float &t) const
+        {
+            float x = (altitude - kMinAltitude) * (1.0f / kTableStep);
+            x = glm::clamp(x, 0.0f, static_cast<float>(count_ - 1) - 1e-3f);
+            index = static_cast<std::size_t>(x);
+            t = x - static_cast<float>(index);
+        }
+        static float lerp(const std::vector<float> &table, std::size_t i, float t)
+        {
+            return table[i] + (table[i + 1] - table[i]) * t;
+        }
+
+        AirDataConfig config_;
+        std::size_t count_ = 0;
+        float datumOffset_ = 0.0f; // m: MSL = y + datumOffset_
+
+        std::vector<float> pressure_;          // Pa
+        std::vector<float> density_;           // kg/m³
+        std::vector<float> sqrtDensityRatio_;  // √σ (EAS = TAS·√σ)
+        std::vector<float> pressureAltitude_;  // m
+        std::vector<float> indicatedAltitude_; // m (altímetro en altimeterSetting)
+        std::vector<float> windX_, windZ_;     // m/s
+    };
+
+} // namespace flight
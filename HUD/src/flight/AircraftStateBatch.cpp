@@ -0,0 +1,313 @@
+#include "flight/AircraftStateBatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace flight
+{
+
+    static constexpr float GRAVITY = 9.80665f;
+    static constexpr float MIN_AERO_SPEED = 1.0f;
+    static constexpr float GROUND_FRICTION = 0.04f;
+    // Factores de Units.h (constantes de compilación): el loop SoA sigue siendo float
+    static constexpr float RAD_TO_DEG = units::factor<units::Radians, units::Degrees>();
+    static constexpr float MPS_TO_KT = units::factor<units::MetersPerSecond, units::Knots>();
+    static constexpr float MPS_TO_FTPM = units::factor<units::MetersPerSecond, units::FeetPerMinute>();
+    static constexpr float M_TO_FT = units::factor<units::Meters, units::Feet>();
+    static constexpr float ALTITUDE_DATUM_M = FlightData::kAltitudeDatum.value();
+    static constexpr float MAX_VERTICAL_SPEED_FPM = 6000.0f;
+
+    // v' = q·v·q*  (q unitario), expandido para que el loop no dependa de glm::quat
+    static inline void rotate(float w, float x, float y, float z,
+                              float vx, float vy, float vz,
+                              float &ox, float &oy, float &oz)
+    {
+        // t = 2 (q.xyz × v);  v' = v + w t + q.xyz × t
+        const float tx = 2.0f * (y * vz - z * vy);
+        const float ty = 2.0f * (z * vx - x * vz);
+        const float tz = 2.0f * (x * vy - y * vx);
+        ox = vx + w * tx + (y * tz - z * ty);
+        oy = vy + w * ty + (z * tx - x * tz);
+        oz = vz + w * tz + (x * ty - y * tx);
+    }
+
+    AircraftStateBatch::AircraftStateBatch(float rateHz)
+        : step_(1.0f / (rateHz > 0.0f ? rateHz : kDefaultRateHz))
+    {
+    }
+
+    void AircraftStateBatch::resize(std::size_t n)
+    {
+        for (std::vector<float> *v : {&posX, &posY, &posZ, &velX, &velY, &velZ,
+                                      &qx, &qy, &qz, &angX, &angY, &angZ,
+                                      &elevator, &aileron, &rudder,
+                                      &pitch, &roll, &heading, &airspeed, &trueAirspeed, &verticalSpeed, &altitude,
+                                      &frameDensity_, &frameWindX_, &frameWindZ_, &frameGround_})
+            v->resize(n, 0.0f);
+        qw.resize(n, 1.0f);
+        throttle.resize(n, ControlInputs{}.throttle);
+    }
+
+    void AircraftStateBatch::spawn(std::size_t i, const glm::vec3 &position, float headingDeg, float speed)
+    {
+        // Rotación −heading alrededor de +Y (misma convención que FlightDynamics::reset)
+        const float half = -0.5f * headingDeg / RAD_TO_DEG;
+        qw[i] = std::cos(half);
+        qx[i] = 0.0f;
+        qy[i] = std::sin(half);
+        qz[i] = 0.0f;
+
+        posX[i] = position.x;
+        posY[i] = std::max(position.y, (terrain_ ? terrain_->height(position.x, position.z) : 0.0f) + params_.groundY);
+        posZ[i] = position.z;
+
+        float fx, fy, fz;
+        rotate(qw[i], qx[i], qy[i], qz[i], 0.0f, 0.0f, -1.0f, fx, fy, fz);
+        velX[i] = fx * speed;
+        velY[i] = fy * speed;
+        velZ[i] = fz * speed;
+        angX[i] = angY[i] = angZ[i] = 0.0f;
+    }
+
+    void AircraftStateBatch::setControls(std::size_t i, const ControlInputs &c)
+    {
+        elevator[i] = glm::clamp(c.elevator, -1.0f, 1.0f);
+        aileron[i] = glm::clamp(c.aileron, -1.0f, 1.0f);
+        rudder[i] = glm::clamp(c.rudder, -1.0f, 1.0f);
+        throttle[i] = glm::clamp(c.throttle, 0.0f, 1.0f);
+    }
+
+    int AircraftStateBatch::stepsForFrame(float frameDt)
+    {
+        if (!(frameDt > 0.0f))
+            return 0;
+        accumulator_ += frameDt;
+        int steps = static_cast<int>(accumulator_ / step_);
+        accumulator_ -= steps * static_cast<double>(step_);
+
+        // Mismo tope anti-pausa que FlightDynamics
+        if (steps > FlightDynamics::kMaxStepsPerAdvance)
+        {
+            steps = FlightDynamics::kMaxStepsPerAdvance;
+            accumulator_ = 0.0;
+        }
+        return steps;
+    }
+
+    int AircraftStateBatch::advance(float frameDt)
+    {
+        const int steps = stepsForFrame(frameDt);
+        stepRange(0, size(), steps);
+        updateInstruments();
+        return steps;
+    }
+
+    int AircraftStateBatch::advanceParallel(float frameDt, util::WorkerPool &pool)
+    {
+        const int steps = stepsForFrame(frameDt);
+        const std::size_t n = size();
+
+        // Bloques de 256 aviones: el pool reparte índices de bloque y roba entre hilos
+        const std::size_t blocks = (n + kParallelBlock - 1) / kParallelBlock;
+        pool.parallelFor(blocks, [this, n, steps](std::size_t block)
+                         {
+                             const std::size_t begin = block * kParallelBlock;
+                             const std::size_t end = std::min(n, begin + kParallelBlock);
+                             stepRange(begin, end, steps);
+                             updateInstruments(begin, end);
+                         });
+        return steps;
+    }
+
+    /**
+     * Integra [begin, end) durante `steps` pasos fijos.
+     * Loop interno por avión sin ramas: las condiciones son selects (?:) sobre floats.
+     */
+    void AircraftStateBatch::stepRange(std::size_t begin, std::size_t end, int steps)
+    {
+        const AircraftParams &p = params_;
+        const float h = step_;
+        const float Ix = p.inertia.x, Iy = p.inertia.y, Iz = p.inertia.z;
+        const float S = p.wingArea, b = p.wingSpan, c = p.chord;
+        const float invMass = 1.0f / p.mass;
+        const float frictionDv = GROUND_FRICTION * GRAVITY * h;
+
+        float *__restrict PX = posX.data(), *__restrict PY = posY.data(), *__restrict PZ = posZ.data();
+        float *__restrict VX = velX.data(), *__restrict VY = velY.data(), *__restrict VZ = velZ.data();
+        float *__restrict QW = qw.data(), *__restrict QX = qx.data(), *__restrict QY = qy.data(), *__restrict QZ = qz.data();
+        float *__restrict WX = angX.data(), *__restrict WY = angY.data(), *__restrict WZ = angZ.data();
+        const float *__restrict EL = elevator.data(), *__restrict AI = aileron.data();
+        const float *__restrict RU = rudder.data(), *__restrict TH = throttle.data();
+        float *__restrict RHO = frameDensity_.data(), *__restrict AWX = frameWindX_.data(), *__restrict AWZ = frameWindZ_.data();
+        float *__restrict GY = frameGround_.data();
+
+        // Tablas de AirData y terreno fuera del loop de pasos: lo que un avión se
+        // mueve en un frame no cambia de forma apreciable densidad, viento ni piso
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            GY[i] = (terrain_ ? terrain_->height(PX[i], PZ[i]) : 0.0f) + p.groundY;
+            if (airData_)
+            {
+                const float altitude = airData_->altitudeOf(glm::vec3(0.0f, PY[i], 0.0f)).value();
+                const glm::vec3 wind = airData_->wind(altitude);
+                RHO[i] = airData_->density(altitude);
+                AWX[i] = wind.x;
+                AWZ[i] = wind.z;
+            }
+            else
+            {
+                RHO[i] = p.airDensity;
+                AWX[i] = 0.0f;
+                AWZ[i] = 0.0f;
+            }
+        }
+
+        for (int s = 0; s < steps; ++s)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const float w = QW[i], x = QX[i], y = QY[i], z = QZ[i];
+                float wx = WX[i], wy = WY[i], wz = WZ[i];
+
+                // Velocidad respecto del aire, en ejes de cuerpo (rotación por el conjugado)
+                float bx, by, bz;
+                rotate(w, -x, -y, -z, VX[i] - AWX[i], VY[i], VZ[i] - AWZ[i], bx, by, bz);
+
+                const float V = std::sqrt(bx * bx + by * by + bz * bz);
+                const float aero = V > MIN_AERO_SPEED ? 1.0f : 0.0f;
+                const float Vs = std::max(V, MIN_AERO_SPEED);
+                const float u = -bz;
+                const float alpha = std::atan2(-by, u) * aero;
+                const float beta = std::atan2(bx, u) * aero;
+                const float qbar = 0.5f * RHO[i] * V * V * aero;
+
+                // CL con pérdida (misma forma que liftCoefficient en FlightDynamics)
+                const float absA = std::abs(alpha);
+                const float linear = p.CL0 + p.CLalpha * alpha;
+                const float clMax = p.CL0 + p.CLalpha * std::copysign(p.alphaStall, alpha);
+                const float plate = 0.9f * std::sin(2.0f * alpha);
+                const float t = std::min(1.0f, (absA - p.alphaStall) / p.alphaStall);
+                const float CL = absA <= p.alphaStall ? linear : clMax + (plate - clMax) * t;
+                const float CD = p.CD0 + p.inducedK * CL * CL;
+
+                // Direcciones: vDir = v/|v|, lift = X × vDir = (0, −vDir.z, vDir.y)
+                const float dx = bx / Vs, dy = by / Vs, dz = bz / Vs;
+                const float liftLen = std::max(std::sqrt(dy * dy + dz * dz), 1e-4f);
+                const float L = qbar * S * CL / liftLen;
+                const float D = qbar * S * CD;
+                const float Y = qbar * S * p.CYbeta * beta;
+
+                const float fbx = -dx * D + Y;
+                const float fby = -dz * L - dy * D;
+                const float fbz = dy * L - dz * D - TH[i] * p.maxThrust;
+
+                // Momentos (tasas aeronáuticas p/q/r como en FlightDynamics)
+                const float bHat = b / (2.0f * Vs);
+                const float cHat = c / (2.0f * Vs);
+                const float Mpitch = qbar * S * c * (p.Cm0 + p.Cmalpha * alpha + p.Cmq * wx * cHat + p.CmElevator * EL[i]);
+                const float Mroll = qbar * S * b * (p.ClAileron * AI[i] + p.Clp * (-wz) * bHat);
+                const float Myaw = qbar * S * b * (p.Cnbeta * beta + p.Cnr * (-wy) * bHat + p.CnRudder * RU[i]);
+                const float tx = Mpitch, ty = -Myaw, tz = -Mroll;
+
+                // Lineal (mundo)
+                float ax, ay, az;
+                rotate(w, x, y, z, fbx, fby, fbz, ax, ay, az);
+                float vx = VX[i] + ax * invMass * h;
+                float vy = VY[i] + (ay * invMass - GRAVITY) * h;
+                float vz = VZ[i] + az * invMass * h;
+
+                // Angular: I·ω̇ = τ − ω × (I·ω)
+                const float gx = wy * Iz * wz - wz * Iy * wy;
+                const float gy = wz * Ix * wx - wx * Iz * wz;
+                const float gz = wx * Iy * wy - wy * Ix * wx;
+                wx += (tx - gx) / Ix * h;
+                wy += (ty - gy) / Iy * h;
+                wz += (tz - gz) / Iz * h;
+
+                float px = PX[i] + vx * h;
+                float py = PY[i] + vy * h;
+                float pz = PZ[i] + vz * h;
+
+                // q += ½ h q ⊗ (0, ω), renormalizado
+                float nw = w + 0.5f * h * (-x * wx - y * wy - z * wz);
+                float nx = x + 0.5f * h * (w * wx + y * wz - z * wy);
+                float ny = y + 0.5f * h * (w * wy + z * wx - x * wz);
+                float nz = z + 0.5f * h * (w * wz + x * wy - y * wx);
+                const float invLen = 1.0f / std::sqrt(nw * nw + nx * nx + ny * ny + nz * nz);
+
+                // Contacto con el piso (selects en lugar de if)
+                const bool ground = py < GY[i];
+                py = ground ? GY[i] : py;
+                vy = ground ? std::max(vy, 0.0f) : vy;
+                const float hs = std::sqrt(vx * vx + vz * vz);
+                const float keep = ground && hs > 0.0f ? 1.0f - std::min(hs, frictionDv) / hs : 1.0f;
+                vx *= keep;
+                vz *= keep;
+                const float damp = ground ? 0.9f : 1.0f;
+                wx *= damp;
+                wz *= damp;
+
+                PX[i] = px; PY[i] = py; PZ[i] = pz;
+                VX[i] = vx; VY[i] = vy; VZ[i] = vz;
+                QW[i] = nw * invLen; QX[i] = nx * invLen; QY[i] = ny * invLen; QZ[i] = nz * invLen;
+                WX[i] = wx; WY[i] = wy; WZ[i] = wz;
+            }
+        }
+    }
+
+    void AircraftStateBatch::updateInstruments(std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const float w = qw[i], x = qx[i], y = qy[i], z = qz[i];
+            float fx, fy, fz, ux, uy, uz;
+            rotate(w, x, y, z, 0.0f, 0.0f, -1.0f, fx, fy, fz);
+            rotate(w, x, y, z, 0.0f, 1.0f, 0.0f, ux, uy, uz);
+
+            pitch[i] = std::asin(glm::clamp(fy, -1.0f, 1.0f)) * RAD_TO_DEG;
+
+            const float h = std::atan2(fx, -fz) * RAD_TO_DEG;
+            heading[i] = h < 0.0f ? h + 360.0f : h;
+
+            // Alabeo: up real contra el up "sin alabeo" (refR = f × Y, refU = refR × f)
+            const float rl = std::max(std::sqrt(fz * fz + fx * fx), 1e-4f);
+            const float rx = -fz / rl, rz = fx / rl;
+            const float rux = -rz * fy, ruy = rz * fx - rx * fz, ruz = rx * fy;
+            const float cx = uy * ruz - uz * ruy, cy = uz * rux - ux * ruz, cz = ux * ruy - uy * rux;
+            roll[i] = std::atan2(fx * cx + fy * cy + fz * cz, ux * rux + uy * ruy + uz * ruz) * RAD_TO_DEG;
+
+            const float speed = std::sqrt(velX[i] * velX[i] + velY[i] * velY[i] + velZ[i] * velZ[i]);
+            airspeed[i] = speed * MPS_TO_KT;
+            trueAirspeed[i] = airspeed[i];
+            verticalSpeed[i] = glm::clamp(velY[i] * MPS_TO_FTPM, -MAX_VERTICAL_SPEED_FPM, MAX_VERTICAL_SPEED_FPM);
+            altitude[i] = (posY[i] - ALTITUDE_DATUM_M) * M_TO_FT;
+        }
+
+        // Con AirData: IAS y altitud barométrica pisan a los valores geométricos
+        if (airData_ && end > begin)
+            airData_->evaluate(posY.data() + begin, velX.data() + begin, velY.data() + begin, velZ.data() + begin,
+                               trueAirspeed.data() + begin, airspeed.data() + begin, altitude.data() + begin,
+                               end - begin);
+    }
+
+    FlightData AircraftStateBatch::view(std::size_t i) const
+    {
+        FlightData d;
+        d.pitch = units::Degrees(pitch[i]);
+        d.roll = units::Degrees(roll[i]);
+        d.heading = units::Degrees(heading[i]);
+        d.yaw = units::Degrees(heading[i]);
+        d.airspeed = units::Knots(airspeed[i]);
+        d.trueAirspeed = units::Knots(trueAirspeed[i]);
+        d.groundSpeed = units::MetersPerSecond(std::sqrt(velX[i] * velX[i] + velZ[i] * velZ[i]));
+        d.verticalSpeed = units::FeetPerMinute(verticalSpeed[i]);
+        d.altitude = units::Feet(altitude[i]);
+        d.position = glm::vec3(posX[i], posY[i], posZ[i]);
+        d.velocity = glm::vec3(velX[i], velY[i], velZ[i]);
+
+        rotate(qw[i], qx[i], qy[i], qz[i], 0.0f, 0.0f, -1.0f, d.cameraFront.x, d.cameraFront.y, d.cameraFront.z);
+        rotate(qw[i], qx[i], qy[i], qz[i], 0.0f, 1.0f, 0.0f, d.cameraUp.x, d.cameraUp.y, d.cameraUp.z);
+        d.cameraRight = glm::cross(d.cameraFront, d.cameraUp);
+        return d;
+    }
+
+} // namespace flight
@@ -0,0 +1,98 @@
+// flight/AircraftStateBatch.h
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "flight/FlightData.h"
+#include "flight/FlightDynamics.h"
+#include "flight/AirData.h"
+#include "flight/Heightfield.h"
+#include "util/WorkerPool.h"
+
+namespace flight
+{
+
+    /**
+     * AircraftStateBatch: muchos aviones (tráfico IA, replays) en estructura de arrays.
+     *
+     * Cada componente vive en su propio array contiguo (posX[], posY[], qw[]...),
+     * así el paso de integración recorre memoria secuencial. Las ecuaciones son
+     * las mismas de FlightDynamics::step, con selects en lugar de ramas y un
+     * único AircraftParams compartido por todo el lote. El loop no se vectoriza
+     * (sqrt/atan2/sin son llamadas a libm): la ganancia viene del acceso
+     * secuencial y de repartir el lote entre hilos.
+     *
+     * Los aviones son independientes entre sí: advanceParallel reparte bloques
+     * de kParallelBlock aviones en un WorkerPool persistente y cada bloque hace
+     * todos los pasos fijos del frame (un parallelFor por frame, sin sincronizar
+     * por paso).
+     *
+     * Los instrumentos (pitch/roll/heading/airspeed/...) se derivan en una
+     * pasada aparte; view(i) arma un FlightData de un elemento para el HUD.
+     */
+    class AircraftStateBatch
+    {
+    public:
+        static constexpr float kDefaultRateHz = 100.0f; // el tráfico no necesita 1 kHz
+        static constexpr std::size_t kParallelBlock = 256;  // aviones por tarea de advanceParallel
+
+        explicit AircraftStateBatch(float rateHz = kDefaultRateHz);
+
+        void resize(std::size_t count);
+        std::size_t size() const { return posX.size(); }
+
+        void setParams(const AircraftParams &params) { params_ = params; }
+        const AircraftParams &params() const { return params_; }
+
+        // Densidad y viento por altitud para todo el lote (no es dueño); nullptr = calma ISA fija
+        void setAirData(const AirData *airData) { airData_ = airData; }
+        // Piso = terreno + groundY (no es dueño); nullptr = plano en y = 0
+        void setTerrain(const Heightfield *terrain) { terrain_ = terrain; }
+
+        // Vuelo recto y nivelado con rumbo headingDeg (0 = −Z)
+        void spawn(std::size_t i, const glm::vec3 &position, float headingDeg, float speed);
+        void setControls(std::size_t i, const ControlInputs &controls);
+
+        // Avanza todos los aviones; devuelve la cantidad de pasos fijos ejecutados
+        int advance(float frameDt);
+        int advanceParallel(float frameDt, util::WorkerPool &pool);
+
+        // Recalcula los instrumentos derivados de [begin, end)
+        void updateInstruments(std::size_t begin, std::size_t end);
+        void updateInstruments() { updateInstruments(0, size()); }
+
+        // Copia un elemento como FlightData (lo que consumen el HUD y los instrumentos)
+        FlightData view(std::size_t i) const;
+
+        float stepSize() const { return step_; }
+
+        // --- Estado (SoA) ---
+        std::vector<float> posX, posY, posZ;     // m (mundo)
+        std::vector<float> velX, velY, velZ;     // m/s (mundo)
+        std::vector<float> qw, qx, qy, qz;       // cuerpo→mundo
+        std::vector<float> angX, angY, angZ;     // rad/s (cuerpo)
+
+        // --- Mandos ---
+        std::vector<float> elevator, aileron, rudder, throttle;
+
+        // --- Instrumentos derivados ---
+        std::vector<float> pitch, roll, heading; // grados
+        std::vector<float> airspeed;             // kt (IAS con AirData)
+        std::vector<float> trueAirspeed;         // kt
+        std::vector<float> verticalSpeed;        // ft/min
+        std::vector<float> altitude;             // ft
+
+    private:
+        int stepsForFrame(float frameDt);
+        void stepRange(std::size_t begin, std::size_t end, int steps);
+
+        AircraftParams params_;
+        const AirData *airData_ = nullptr;
+        const Heightfield *terrain_ = nullptr;
+        // Aire y piso muestreados al comienzo de cada frame (constantes durante sus pasos)
+        std::vector<float> frameDensity_, frameWindX_, frameWindZ_, frameGround_;
+        float step_;
+        double accumulator_ = 0.0;
+    };
+
+} // namespace flight
@@ -0,0 +1,95 @@
+#include "flight/AttitudeBatch.h"
+#include "flight/FastMath.h"
+#include "flight/Units.h"
+#include <algorithm>
+#include <cmath>
+
+namespace flight
+{
+
+    static constexpr float EPS = 1e-4f; // mismas tolerancias que FlightData.cpp
+    static constexpr float RAD_TO_DEG = units::factor<units::Radians, units::Degrees>();
+
+    void AttitudeBatch::resize(std::size_t n)
+    {
+        for (std::vector<float> *v : {&frontX, &frontY, &upX, &upZ, &pitch, &roll, &heading})
+            v->resize(n, 0.0f);
+        frontZ.resize(n, -1.0f);
+        upY.resize(n, 1.0f);
+    }
+
+    void AttitudeBatch::update(float deltaTime, float tauAttitude)
+    {
+        update(0, size(), deltaTime, tauAttitude);
+    }
+
+    /**
+     * El loop del lote. Los arrays llegan como parámetros __restrict (en punteros
+     * locales GCC no lo aprovecha y pide versionar por alias). Sin ramas ni libm
+     * salvo sqrt, que con -fno-math-errno (make RELEASE=1) es una instrucción;
+     * con esos flags GCC lo vectoriza (comprobar con -fopt-info-vec).
+     */
+    static void updateKernel(const float *__restrict FX, const float *__restrict FY, const float *__restrict FZ,
+                             const float *__restrict UX, const float *__restrict UY, const float *__restrict UZ,
+                             float *__restrict P, float *__restrict R, float *__restrict H,
+                             std::size_t n, float alpha)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            // 1) Base ortonormal {f, r, u}
+            const float fl = 1.0f / std::sqrt(FX[i] * FX[i] + FY[i] * FY[i] + FZ[i] * FZ[i]);
+            const float fx = FX[i] * fl, fy = FY[i] * fl, fz = FZ[i] * fl;
+
+            float rx = fy * UZ[i] - fz * UY[i];
+            float ry = fz * UX[i] - fx * UZ[i];
+            float rz = fx * UY[i] - fy * UX[i];
+            const float rl = 1.0f / std::max(std::sqrt(rx * rx + ry * ry + rz * rz), 1e-20f);
+            rx *= rl; ry *= rl; rz *= rl;
+            const float ux = ry * fz - rz * fy;
+            const float uy = rz * fx - rx * fz;
+            const float uz = rx * fy - ry * fx;
+
+            // 2) Pitch, heading y roll objetivo
+            const float newPitch = fastAsin(fy) * RAD_TO_DEG;
+
+            const float horiz2 = fx * fx + fz * fz;
+            const bool hasHeading = horiz2 >= EPS * EPS;
+            // atan2 en grados cae en [-180,180]: se lleva a [0,360) con un select (un floor
+            // dentro del ?: quedaría como llamada enmascarada y GCC no vectoriza el loop)
+            const float rawHeading = fastAtan2(fx, -fz) * RAD_TO_DEG;
+            const float newHeading = hasHeading ? (rawHeading < 0.0f ? rawHeading + 360.0f : rawHeading) : H[i];
+
+            // refR = f × Y = (−fz, 0, fx);  refU = refR × f
+            const float hl = 1.0f / std::max(std::sqrt(horiz2), 1e-20f);
+            const float qx = -fz * hl, qz = fx * hl;
+            const float vx = -qz * fy, vy = qz * fx - qx * fz, vz = qx * fy;
+            const float cx = uy * vz - uz * vy, cy = uz * vx - ux * vz, cz = ux * vy - uy * vx;
+            const float s = fx * cx + fy * cy + fz * cz;
+            const float c = ux * vx + uy * vy + uz * vz;
+            const float newRoll = hasHeading ? fastAtan2(s, c) * RAD_TO_DEG : R[i];
+
+            // 3) Suavizado por el arco corto + clamps
+            const float p = P[i] + shortestDeltaFast(P[i], newPitch) * alpha;
+            const float r = R[i] + shortestDeltaFast(R[i], newRoll) * alpha;
+            const float h = H[i] + shortestDeltaFast(H[i], newHeading) * alpha;
+
+            P[i] = std::min(std::max(p, -90.0f), 90.0f);
+            R[i] = std::min(std::max(r, -180.0f), 180.0f);
+            H[i] = wrap360(h);
+        }
+    }
+
+    void AttitudeBatch::update(std::size_t begin, std::size_t end, float deltaTime, float tauAttitude)
+    {
+        if (deltaTime <= 0.0f || end <= begin)
+            return;
+
+        // Una sola exp por lote
+        const float alpha = 1.0f - std::exp(-std::min(deltaTime, 0.25f) / tauAttitude);
+
+        updateKernel(frontX.data() + begin, frontY.data() + begin, frontZ.data() + begin,
+                     upX.data() + begin, upY.data() + begin, upZ.data() + begin,
+                     pitch.data() + begin, roll.data() + begin, heading.data() + begin, end - begin, alpha);
+    }
+
+} // namespace flight
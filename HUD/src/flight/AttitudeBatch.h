@@ -0,0 +1,42 @@
+// flight/AttitudeBatch.h
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace flight
+{
+
+    /**
+     * AttitudeBatch: FlightData::updateAttitude (la parte de actitud de
+     * updateFromCamera: pitch/roll/heading + suavizado exponencial) para N bases
+     * de cámara a la vez.
+     *
+     * Pensado para procesar muchas trayectorias grabadas. Diferencias con la
+     * versión escalar:
+     * - asin/atan2 se reemplazan por fastAsin/fastAtan2 (FastMath.h, ≤ 5e-7 rad).
+     * - El factor de suavizado 1 − e^(−dt/τ) se calcula una vez por lote (τ común).
+     * - Los wraps con fmod pasan a fastFloor, y los "mantener el valor previo" a selects.
+     * - Las bases deben ser finitas (sin el fallback anti-NaN de makeCameraBasis);
+     *   sí se re-ortonormalizan.
+     *
+     * Tolerancia frente a la escalar: ver `--bench attitude`.
+     */
+    class AttitudeBatch
+    {
+    public:
+        void resize(std::size_t count);
+        std::size_t size() const { return frontX.size(); }
+
+        // Un frame para todas las bases: mismo dt y τ (s) que FlightData
+        void update(float deltaTime, float tauAttitude);
+        void update(std::size_t begin, std::size_t end, float deltaTime, float tauAttitude);
+
+        // --- Entrada: base de cámara de cada track ---
+        std::vector<float> frontX, frontY, frontZ;
+        std::vector<float> upX, upY, upZ;
+
+        // --- Salida suavizada (grados, mismas convenciones que FlightData) ---
+        std::vector<float> pitch, roll, heading;
+    };
+
+} // namespace flight
@@ -0,0 +1,73 @@
+#include "flight/CameraAttitude.h"
+#include <cmath>
+
+namespace flight
+{
+
+    static constexpr float EPS = 1e-4f;
+
+    // Ejes de cuerpo (ver RigidBodyState)
+    static const glm::vec3 BODY_FORWARD(0.0f, 0.0f, -1.0f);
+    static const glm::vec3 BODY_UP(0.0f, 1.0f, 0.0f);
+    static const glm::vec3 BODY_RIGHT(1.0f, 0.0f, 0.0f);
+
+    static inline bool isFiniteVec(const glm::vec3 &v)
+    {
+        return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+    }
+
+    void CameraAttitude::rotate(units::Radians pitch, units::Radians yaw, units::Radians roll)
+    {
+        // Post-multiplicar = girar en ejes de cuerpo. Yaw positivo (a la derecha)
+        // es un giro negativo alrededor de +Y; roll positivo, alrededor de la nariz
+        const glm::quat delta = glm::angleAxis(-yaw.value(), BODY_UP) *
+                                glm::angleAxis(pitch.value(), BODY_RIGHT) *
+                                glm::angleAxis(roll.value(), BODY_FORWARD);
+        orientation_ = glm::normalize(orientation_ * delta);
+        updateBasis();
+    }
+
+    void CameraAttitude::set(const glm::vec3 &front, const glm::vec3 &up)
+    {
+        if (!isFiniteVec(front) || glm::dot(front, front) < EPS * EPS)
+            return; // pose inválida: se conserva la actual
+
+        const glm::vec3 f = glm::normalize(front);
+        glm::vec3 r = isFiniteVec(up) ? glm::cross(f, up) : glm::vec3(0.0f);
+        if (glm::dot(r, r) < EPS * EPS)
+            r = glm::cross(f, basis_.up); // up paralelo a front: conservar el alabeo actual
+        if (glm::dot(r, r) < EPS * EPS)
+        {
+            const glm::vec3 any = (std::abs(f.y) < 0.9f) ? BODY_UP : BODY_RIGHT;
+            r = glm::cross(f, any);
+        }
+        r = glm::normalize(r);
+        const glm::vec3 u = glm::cross(r, f);
+
+        // Columnas = ejes de cuerpo en mundo (+X, +Y, +Z = −front)
+        setOrientation(glm::quat_cast(glm::mat3(r, u, -f)));
+    }
+
+    void CameraAttitude::setOrientation(const glm::quat &orientation)
+    {
+        orientation_ = glm::normalize(orientation);
+        updateBasis();
+    }
+
+    void CameraAttitude::level()
+    {
+        const glm::vec3 &f = basis_.front;
+        if (f.x * f.x + f.z * f.z < EPS)
+            return; // mirando casi vertical: el alabeo no está definido
+        set(f, BODY_UP);
+    }
+
+    void CameraAttitude::updateBasis()
+    {
+        const glm::mat3 m = glm::mat3_cast(orientation_);
+        basis_.right = m[0];
+        basis_.up = m[1];
+        basis_.front = -m[2];
+    }
+
+} // namespace flight
@@ -0,0 +1,61 @@
+// flight/CameraAttitude.h
+#pragma once
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "flight/Units.h"
+
+namespace flight
+{
+    // Base ortonormal de cámara/cuerpo en mundo (derecha = front × up)
+    struct CameraBasis
+    {
+        glm::vec3 front = glm::vec3(0.0f, 0.0f, -1.0f);
+        glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::vec3 right = glm::vec3(1.0f, 0.0f, 0.0f);
+    };
+
+    /**
+     * Actitud de cámara/avión como quaternion cuerpo→mundo (misma convención
+     * que RigidBodyState: identidad = nariz hacia −Z, arriba +Y, derecha +X).
+     *
+     * Los giros se aplican en ejes de cuerpo, así que no hay límite de pitch
+     * ni gimbal lock: se puede rolar 360° y hacer loops. La base se recalcula
+     * una vez por cambio (un mat3_cast) y queda cacheada: leerla no cuesta nada
+     * y se puede pasar tal cual a FlightData::updateFromCamera, que con una
+     * base ya ortonormal se saltea el saneamiento.
+     *
+     * El quaternion se renormaliza en cada giro para que el error de redondeo
+     * no se acumule (la base sale ortonormal sin Gram-Schmidt).
+     */
+    class CameraAttitude
+    {
+    public:
+        CameraAttitude() = default;
+        CameraAttitude(const glm::vec3 &front, const glm::vec3 &up) { set(front, up); }
+
+        // Giro incremental en ejes de cuerpo: pitch positivo = nariz arriba,
+        // yaw positivo = nariz a la derecha, roll positivo = ala derecha abajo
+        void rotate(units::Radians pitch, units::Radians yaw, units::Radians roll);
+
+        // Pose absoluta; up se ortogonaliza contra front. Si son paralelos se
+        // conserva el alabeo actual en lo posible
+        void set(const glm::vec3 &front, const glm::vec3 &up);
+        void setOrientation(const glm::quat &orientation);
+
+        // Alas niveladas conservando hacia dónde mira (sin efecto mirando vertical)
+        void level();
+
+        const glm::quat &orientation() const { return orientation_; }
+        const CameraBasis &basis() const { return basis_; }
+        const glm::vec3 &front() const { return basis_.front; }
+        const glm::vec3 &up() const { return basis_.up; }
+        const glm::vec3 &right() const { return basis_.right; }
+
+    private:
+        void updateBasis();
+
+        glm::quat orientation_ = glm::quat(1.0f, 0.0f, 0.0f, 0.0f); // cuerpo→mundo
+        CameraBasis basis_;
+    };
+
+} // namespace flight
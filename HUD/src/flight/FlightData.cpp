@@ -1,4 +1,7 @@
 #include "flight/FlightData.h"
+#include "flight/FlightDynamics.h"
+#include "flight/AirData.h"
+#include "flight/Heightfield.h"
 #include <cmath>
 #include <algorithm>
 
@@ -6,10 +9,12 @@ namespace flight
 {
 
     // ======================= Helpers internos  =========================
+    using namespace units::literals;
+
     static constexpr float EPS = 1e-4f; // tolerancias numéricas
-    static constexpr float MPS_TO_KT = 1.94384f;
-    static constexpr float MPS_TO_FTPM = 196.8504f;
-    static constexpr float M_TO_FT = 3.28084f;
+    static constexpr units::Degrees MAX_PITCH = 90_deg;
+    static constexpr units::Degrees MAX_ROLL = 180_deg;
+    static constexpr units::FeetPerMinute MAX_VERTICAL_SPEED = 6000_fpm; // tope del VSI
 
     static inline bool isFiniteVec(const glm::vec3 &v)
     {
@@ -24,17 +29,18 @@ namespace flight
             a += 360.0f;
         return a;
     }
+    static inline units::Degrees normAngle360(units::Degrees a) { return units::Degrees(normAngle360(a.value())); }
 
     // delta (a->b) corto en [-180,180)
-    static inline float shortestDelta(float a, float b)
+    static inline units::Degrees shortestDelta(units::Degrees a, units::Degrees b)
     {
-        return std::fmod(b - a + 540.0f, 360.0f) - 180.0f;
+        return units::Degrees(std::fmod(b.value() - a.value() + 540.0f, 360.0f) - 180.0f);
     }
 
     // conserva prev si now es NaN/inf
-    static inline float keepSane(float prev, float now)
+    static inline units::Degrees keepSane(units::Degrees prev, units::Degrees now)
     {
-        return std::isfinite(now) ? now : prev;
+        return std::isfinite(now.value()) ? now : prev;
     }
 
     // Ortonormaliza base (f,u) con fallback robusto; devuelve {f,r,u}
@@ -69,41 +75,28 @@ namespace flight
         u = glm::normalize(glm::cross(r, f));
     }
 
-    // ============================== Implementación ==============================
-    void FlightData::updateFromCamera(const glm::vec3 &frontIn,
-                                      const glm::vec3 &upIn,
-                                      const glm::vec3 &pos,
-                                      float deltaTime)
+    // Pitch/rumbo/alabeo (grados) desde una base ortonormal {f,u}; si no están
+    // definidos (mirando casi vertical) se conservan los valores previos
+    static inline void attitudeFromBasis(const glm::vec3 &f, const glm::vec3 &u,
+                                         units::Degrees prevHeading, units::Degrees prevRoll,
+                                         units::Degrees &outPitch, units::Degrees &outHeading, units::Degrees &outRoll)
     {
-        if (deltaTime <= 0.0f)
-            return;
-
-        // 1) Base de cámara robusta
-        glm::vec3 f, r, u;
-        makeCameraBasis(frontIn, upIn, cameraFront, cameraUp, f, r, u);
-        cameraFront = f;
-        cameraRight = r;
-        cameraUp = u; // expone base saneada
-
-        // 2) Actitud y rumbo desde base
         //    Pitch: componente vertical de "hacia dónde miro".
-        const float newPitch = glm::degrees(std::asin(glm::clamp(f.y, -1.0f, 1.0f)));
+        outPitch = units::Radians(std::asin(glm::clamp(f.y, -1.0f, 1.0f)));
 
         //    Heading: azimut en XZ. 0° = -Z (norte). atan2(x, -z).
-        float newHeading;
         const float horizLen2 = f.x * f.x + f.z * f.z;
         if (horizLen2 >= EPS * EPS)
         {
-            newHeading = glm::degrees(std::atan2(f.x, -f.z));
-            newHeading = normAngle360(newHeading);
+            outHeading = normAngle360(units::Degrees(units::Radians(std::atan2(f.x, -f.z))));
         }
         else
         {
-            newHeading = heading; // mirando casi vertical → mantener
+            outHeading = prevHeading; // mirando casi vertical → mantener
         }
 
         //    Roll: giro alrededor de f; derecha positivo. Compara up real vs up de referencia.
-        float newRoll = roll;
+        outRoll = prevRoll;
         const glm::vec3 worldUp(0, 1, 0);
         glm::vec3 refR = glm::cross(f, worldUp);
         const float refRL2 = glm::dot(refR, refR);
@@ -113,26 +106,68 @@ namespace flight
             const glm::vec3 refU = glm::normalize(glm::cross(refR, f)); // up “sin alabeo”
             const float s = glm::dot(f, glm::cross(u, refU));           // seno firmado alrededor de f
             const float c = glm::dot(u, refU);                          // coseno
-            newRoll = glm::degrees(std::atan2(s, c));                   // (−180,180]
+            outRoll = units::Radians(std::atan2(s, c));                 // (−180,180]
         }
         // Nota: si f≈worldUp, el alabeo no está bien definido → se preserva el valor anterior.
+    }
+
+    // ============================== Implementación ==============================
+    void FlightData::updateFromCamera(const glm::vec3 &frontIn,
+                                      const glm::vec3 &upIn,
+                                      const glm::vec3 &pos,
+                                      float deltaTime)
+    {
+        if (deltaTime <= 0.0f)
+            return;
+
+        // Base de cámara robusta
+        CameraBasis basis;
+        makeCameraBasis(frontIn, upIn, cameraFront, cameraUp, basis.front, basis.right, basis.up);
+        updateFromCamera(basis, pos, deltaTime);
+    }
+
+    void FlightData::updateAttitude(const glm::vec3 &frontIn, const glm::vec3 &upIn, float deltaTime)
+    {
+        if (deltaTime <= 0.0f)
+            return;
+
+        CameraBasis basis;
+        makeCameraBasis(frontIn, upIn, cameraFront, cameraUp, basis.front, basis.right, basis.up);
+        updateAttitude(basis, deltaTime);
+    }
+
+    void FlightData::updateAttitude(const CameraBasis &basis, float deltaTime)
+    {
+        if (deltaTime <= 0.0f)
+            return;
+
+        // 1) Base de cámara: ya ortonormal (saneada arriba o cacheada por CameraAttitude)
+        const glm::vec3 &f = basis.front;
+        const glm::vec3 &u = basis.up;
+        cameraFront = f;
+        cameraRight = basis.right;
+        cameraUp = u;
+
+        // 2) Actitud y rumbo desde base
+        units::Degrees newPitch, newHeading, newRoll;
+        attitudeFromBasis(f, u, heading, roll, newPitch, newHeading, newRoll);
 
         // 3) Suavizado exponencial (evita jitter) + shortest-arc para ángulos
         const float dtClamped = glm::min(deltaTime, 0.25f);               // cap anti-pause
         const float alphaAtt = 1.0f - std::exp(-dtClamped / tauAttitude); // [0..1]
 
-        const float prevPitch = pitch;
-        const float prevRoll = roll;
-        const float prevHeading = heading;
-        const float prevYaw = yaw;
+        const units::Degrees prevPitch = pitch;
+        const units::Degrees prevRoll = roll;
+        const units::Degrees prevHeading = heading;
+        const units::Degrees prevYaw = yaw;
 
         pitch += shortestDelta(pitch, newPitch) * alphaAtt;
         roll += shortestDelta(roll, newRoll) * alphaAtt;
         heading += shortestDelta(heading, newHeading) * alphaAtt;
 
         // clamps/normalizaciones (post-suavizado)
-        pitch = glm::clamp(pitch, -90.0f, 90.0f);
-        roll = glm::clamp(roll, -180.0f, 180.0f);
+        pitch = std::clamp(pitch, -MAX_PITCH, MAX_PITCH);
+        roll = std::clamp(roll, -MAX_ROLL, MAX_ROLL);
         heading = normAngle360(heading);
         yaw = heading; // sin derrape
 
@@ -141,8 +176,20 @@ namespace flight
         roll = keepSane(prevRoll, roll);
         heading = keepSane(prevHeading, heading);
         yaw = keepSane(prevYaw, yaw);
+    }
+
+    void FlightData::updateFromCamera(const CameraBasis &basis,
+                                      const glm::vec3 &pos,
+                                      float deltaTime)
+    {
+        if (deltaTime <= 0.0f)
+            return;
+
+        // 1-3) Base, actitud y suavizado
+        updateAttitude(basis, deltaTime);
 
         // 4) Telemetría de posición/velocidad
+        const float dtClamped = glm::min(deltaTime, 0.25f); // cap anti-pause
         const glm::vec3 dP = pos - position;
         const float disp = glm::length(dP);
 
@@ -155,25 +202,82 @@ namespace flight
 
         position = pos;
 
-        // 5) Derivados para instrumentos
-        const float speed_mps = glm::length(velocity);
-        airspeed = speed_mps * MPS_TO_KT; // “groundspeed” si no modelamos viento
-        verticalSpeed = velocity.y * MPS_TO_FTPM;
+        // 5) Derivados para instrumentos (velocidades, altitudes)
+        updateAirData();
+        updateRadarAltitude();
+
+        // 6) Saneamiento final para instrumentos (HUD-ready)
+        pitch = std::clamp(pitch, -MAX_PITCH, MAX_PITCH);
+        roll = std::clamp(roll, -MAX_ROLL, MAX_ROLL);
+    }
+
+    void FlightData::simulatePhysics(float deltaTime)
+    {
+        // Sin modelo asignado: modo telemetría, todo sale de updateFromCamera
+        if (!dynamics || deltaTime <= 0.0f)
+            return;
+
+        dynamics->advance(deltaTime);
+        const RigidBodyState s = dynamics->interpolated();
+
+        // Base de cámara = ejes de cuerpo (la física ya es suave: sin filtro extra)
+        cameraFront = glm::normalize(s.orientation * glm::vec3(0.0f, 0.0f, -1.0f));
+        cameraUp = glm::normalize(s.orientation * glm::vec3(0.0f, 1.0f, 0.0f));
+        cameraRight = glm::normalize(glm::cross(cameraFront, cameraUp));
+
+        units::Degrees newPitch, newHeading, newRoll;
+        attitudeFromBasis(cameraFront, cameraUp, heading, roll, newPitch, newHeading, newRoll);
+        pitch = keepSane(pitch, std::clamp(newPitch, -MAX_PITCH, MAX_PITCH));
+        roll = keepSane(roll, newRoll);
+        heading = keepSane(heading, newHeading);
+        yaw = heading;
 
-        // 6) Altitud “QFE”: cero a ~altura de ojos (1.8 m). Fácil de visualizar en el HUD.
-        static constexpr float EYE_LEVEL_Y_METERS = 1.8f;
-        altitude = (position.y - EYE_LEVEL_Y_METERS) * M_TO_FT;
+        position = s.position;
+        velocity = s.velocity;
 
-        // 7) Saneamiento final para instrumentos (HUD-ready)
-        pitch = glm::clamp(pitch, -90.0f, 90.0f);
-        roll = glm::clamp(roll, -180.0f, 180.0f);
-        airspeed = glm::max(0.0f, airspeed);
-        verticalSpeed = glm::clamp(verticalSpeed, -6000.0f, 6000.0f);
+        updateAirData();
+        updateRadarAltitude();
     }
 
-    void FlightData::simulatePhysics(float /*deltaTime*/)
+    void FlightData::updateAirData()
     {
-        // TODO No implementado: en modo telemetría sólo se actualiza desde cámara
+        groundSpeed = units::MetersPerSecond(glm::length(glm::vec3(velocity.x, 0.0f, velocity.z)));
+        verticalSpeed = std::clamp<units::FeetPerMinute>(units::MetersPerSecond(velocity.y), -MAX_VERTICAL_SPEED, MAX_VERTICAL_SPEED);
+
+        if (airData)
+        {
+            const AirDataSample air = airData->evaluate(position, velocity);
+            trueAirspeed = air.trueAirspeed;
+            airspeed = air.indicatedAirspeed;
+            altitude = air.indicatedAltitude;
+        }
+        else
+        {
+            // Sin atmósfera: velocidad respecto del suelo y altitud “QFE” (cero a la altura de ojos)
+            trueAirspeed = units::MetersPerSecond(glm::length(velocity));
+            airspeed = trueAirspeed;
+            altitude = units::Meters(position.y) - kAltitudeDatum;
+        }
+    }
+
+    void FlightData::updateRadarAltitude()
+    {
+        radarAltitudeValid = false;
+        if (!terrain)
+            return;
+
+        // La antena apunta por el "abajo" del avión; con mucha inclinación pierde el suelo
+        const glm::vec3 down = -cameraUp;
+        if (down.y > -0.5f) // más de ~60° de alabeo o cabeceo
+            return;
+
+        // El rango se mide desde la altura de ojos: 0 ft apoyado en el piso
+        TerrainHit hit;
+        const float range = units::Meters(kRadarAltimeterRange).value() + kAltitudeDatum.value();
+        if (!terrain->raycast(position, down, range, hit))
+            return;
+        radarAltitude = std::max(0_ft, units::Feet(units::Meters(hit.distance) - kAltitudeDatum));
+        radarAltitudeValid = true;
     }
 
     float FlightData::normalizeAngle(float angle) { return normAngle360(angle); }
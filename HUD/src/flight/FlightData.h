@@ -2,17 +2,23 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "flight/CameraAttitude.h"
+#include "flight/Units.h"
 
 namespace flight
 {
+    class FlightDynamics;
+    class AirData;
+    class Heightfield;
+    class InstrumentHistory;
 
     /**
      * FlightData: datos que el HUD necesita para “instrumentos”
      *
-     * Convenciones de unidades:
-     * - Ángulos: grados.
-     * - position/velocity: metros y m/s (mundo).
-     * - airspeed: nudos (kt). verticalSpeed: pies/min (ft/min). altitude: pies (ft).
+     * Unidades: las salidas de instrumentos llevan la unidad en el tipo
+     * (units::Degrees, Knots, FeetPerMinute, Feet; ver Units.h). Asignarles
+     * una cantidad en otra unidad de la misma dimensión convierte sola; otra
+     * dimensión no compila. position/velocity quedan en glm::vec3: metros y m/s (mundo).
      *
      * Vocabulario llano:
      * - pitch (cabeceo): levantar/bajar la nariz (−90°..+90°).
@@ -22,16 +28,23 @@ namespace flight
      */
     struct FlightData
     {
+        // Altura de la cámara que el altímetro muestra como 0 ft (QFE, altura de ojos)
+        static constexpr units::Meters kAltitudeDatum{1.8f};
+
         // Actitud
-        float pitch = 0.0f;
-        float roll = 0.0f;
-        float yaw = 0.0f;
+        units::Degrees pitch{0.0f};
+        units::Degrees roll{0.0f};
+        units::Degrees yaw{0.0f};
 
         // Navegación
-        float heading = 0.0f;       // 0..360
-        float airspeed = 0.0f;      // kt
-        float altitude = 1000.0f;   // ft
-        float verticalSpeed = 0.0f; // ft/min
+        units::Degrees heading{0.0f}; // 0..360
+        units::Knots airspeed{0.0f};  // IAS con airData; si no, groundspeed
+        units::Feet altitude{1000.0f}; // barométrica con airData; si no, QFE sobre kAltitudeDatum
+        units::FeetPerMinute verticalSpeed{0.0f};
+        units::Knots trueAirspeed{0.0f}; // TAS (= groundspeed sin airData)
+        units::Knots groundSpeed{0.0f};
+        units::Feet radarAltitude{0.0f}; // sobre el terreno, por el eje vertical del avión
+        bool radarAltitudeValid = false;  // false: sin terreno, fuera de alcance o alabeo excesivo
 
         // Estado en mundo (m / m/s)
         glm::vec3 position = glm::vec3(0.0f, 304.8f, 0.0f); // ≈ 1000 ft
@@ -47,17 +60,49 @@ namespace flight
         float tauVelocity = 0.15f;        // s (velocity)
         float maxPlausibleSpeed = 300.0f; // m/s (anti-teleport)
 
-        // Deriva instrumentos desde cámara
+        // Modelo de vuelo opcional (no es dueño). Si está asignado,
+        // simulatePhysics integra la dinámica y la cámara sigue al avión.
+        FlightDynamics *dynamics = nullptr;
+
+        // Atmósfera y viento opcionales (no es dueño, sólo lectura): con airData
+        // los instrumentos muestran IAS y altitud de altímetro en lugar de valores geométricos
+        const AirData *airData = nullptr;
+
+        // Terreno opcional (no es dueño, sólo lectura) para el radioaltímetro
+        const Heightfield *terrain = nullptr;
+        static constexpr units::Feet kRadarAltimeterRange{2500.0f};
+
+        // Historia y tendencias opcionales (no es dueño): la graba un único
+        // productor (ver InstrumentHistory); los instrumentos sólo la leen
+        const InstrumentHistory *history = nullptr;
+
+        // Deriva instrumentos desde cámara (front/up arbitrarios: se sanean y ortonormalizan)
         void updateFromCamera(const glm::vec3 &front,
                               const glm::vec3 &up,
                               const glm::vec3 &pos,
                               float deltaTime);
+        // Igual, con una base ya ortonormal (CameraAttitude::basis()): se usa tal cual
+        void updateFromCamera(const CameraBasis &basis,
+                              const glm::vec3 &pos,
+                              float deltaTime);
 
-        // En modo telemetría sólo acota valores (no integra dinámica)
+        // Sólo la actitud de updateFromCamera (base, pitch/roll/heading y suavizado),
+        // sin posición, velocidad ni instrumentos derivados. Referencia de AttitudeBatch
+        void updateAttitude(const glm::vec3 &front, const glm::vec3 &up, float deltaTime);
+        void updateAttitude(const CameraBasis &basis, float deltaTime);
+
+        // Con dynamics: avanza el modelo a paso fijo y deriva instrumentos
+        // del estado interpolado. Sin dynamics (telemetría): no hace nada.
         void simulatePhysics(float deltaTime);
 
         // Utilidad pública (legado)
         float normalizeAngle(float angle);
+
+    private:
+        // Velocidades y altitud de instrumentos desde position/velocity (+ airData)
+        void updateAirData();
+        // Radioaltímetro: rayo por −cameraUp contra el terreno
+        void updateRadarAltitude();
     };
 
 } // namespace flight
\ No newline at end of file
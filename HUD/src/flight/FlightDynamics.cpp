@@ -0,0 +1,204 @@
+#include "flight/FlightDynamics.h"
+#include "flight/AirData.h"
+#include "flight/Heightfield.h"
+#include <cmath>
+#include <algorithm>
+
+namespace flight
+{
+
+    static constexpr float GRAVITY = 9.80665f;     // m/s²
+    static constexpr float MIN_AERO_SPEED = 1.0f;  // m/s, por debajo no hay aerodinámica
+    static constexpr float GROUND_FRICTION = 0.04f; // coeficiente de rodadura
+
+    static const glm::vec3 BODY_RIGHT(1.0f, 0.0f, 0.0f);
+    static const glm::vec3 BODY_FORWARD(0.0f, 0.0f, -1.0f);
+
+    // CL con pérdida: lineal hasta alphaStall, luego cae hacia placa plana
+    static inline float liftCoefficient(const AircraftParams &p, float alpha)
+    {
+        const float linear = p.CL0 + p.CLalpha * alpha;
+        const float a = std::abs(alpha);
+        if (a <= p.alphaStall)
+            return linear;
+
+        const float clMax = p.CL0 + p.CLalpha * std::copysign(p.alphaStall, alpha);
+        const float plate = 0.9f * std::sin(2.0f * alpha);
+        const float t = std::min(1.0f, (a - p.alphaStall) / p.alphaStall); // transición suave
+        return clMax + (plate - clMax) * t;
+    }
+
+    FlightDynamics::FlightDynamics(float rateHz)
+        : step_(1.0 / static_cast<double>(rateHz > 0.0f ? rateHz : kDefaultRateHz))
+    {
+    }
+
+    void FlightDynamics::reset(const glm::vec3 &position, const glm::vec3 &front, float speed)
+    {
+        // Sólo rumbo: alas niveladas y nariz en el horizonte
+        const float heading = std::atan2(front.x, -front.z);
+
+        current_ = RigidBodyState{};
+        const float groundHeight = (terrain_ ? terrain_->height(position.x, position.z) : 0.0f) + params_.groundY;
+        current_.position = glm::vec3(position.x, std::max(position.y, groundHeight), position.z);
+        current_.orientation = glm::angleAxis(-heading, glm::vec3(0.0f, 1.0f, 0.0f));
+        current_.velocity = current_.orientation * BODY_FORWARD * speed;
+        previous_ = current_;
+        accumulator_ = 0.0;
+        alpha_ = beta_ = 0.0f;
+    }
+
+    void FlightDynamics::setControls(const ControlInputs &controls)
+    {
+        controls_.elevator = glm::clamp(controls.elevator, -1.0f, 1.0f);
+        controls_.aileron = glm::clamp(controls.aileron, -1.0f, 1.0f);
+        controls_.rudder = glm::clamp(controls.rudder, -1.0f, 1.0f);
+        controls_.throttle = glm::clamp(controls.throttle, 0.0f, 1.0f);
+    }
+
+    int FlightDynamics::advance(float frameDt)
+    {
+        if (!(frameDt > 0.0f))
+            return 0;
+
+        accumulator_ += frameDt;
+
+        int steps = 0;
+        while (accumulator_ >= step_ && steps < kMaxStepsPerAdvance)
+        {
+            previous_ = current_;
+            step(static_cast<float>(step_));
+            accumulator_ -= step_;
+            ++steps;
+        }
+
+        // Tras una pausa larga se descarta el atraso en lugar de intentar recuperarlo
+        if (steps == kMaxStepsPerAdvance && accumulator_ >= step_)
+            accumulator_ = 0.0;
+
+        return steps;
+    }
+
+    RigidBodyState FlightDynamics::interpolated() const
+    {
+        const float t = interpolationAlpha();
+        RigidBodyState s;
+        s.position = glm::mix(previous_.position, current_.position, t);
+        s.velocity = glm::mix(previous_.velocity, current_.velocity, t);
+        s.orientation = glm::slerp(previous_.orientation, current_.orientation, t);
+        s.angularVelocity = glm::mix(previous_.angularVelocity, current_.angularVelocity, t);
+        return s;
+    }
+
+    /**
+     * Un paso de Euler semi-implícito (velocidades primero, luego posición/actitud).
+     * Con h = 1 ms es estable para los modos rápidos de cabeceo y alabeo.
+     */
+    void FlightDynamics::step(float h)
+    {
+        const AircraftParams &p = params_;
+        RigidBodyState &s = current_;
+
+        // Aerodinámica con la velocidad respecto del aire
+        float rho = p.airDensity;
+        glm::vec3 vAir = s.velocity;
+        if (airData_)
+        {
+            const float altitude = airData_->altitudeOf(s.position).value();
+            rho = airData_->density(altitude);
+            vAir -= airData_->wind(altitude);
+        }
+
+        const glm::quat toBody = glm::conjugate(s.orientation);
+        const glm::vec3 vBody = toBody * vAir;
+        const glm::vec3 &w = s.angularVelocity;
+        const float V = glm::length(vBody);
+
+        glm::vec3 forceBody(0.0f);
+        glm::vec3 torqueBody(0.0f);
+
+        // --- Empuje ---
+        forceBody += BODY_FORWARD * (controls_.throttle * p.maxThrust);
+
+        // --- Aerodinámica ---
+        if (V > MIN_AERO_SPEED)
+        {
+            const float u = -vBody.z; // velocidad hacia la nariz
+            alpha_ = std::atan2(-vBody.y, u);
+            beta_ = std::atan2(vBody.x, u);
+
+            const float qbar = 0.5f * rho * V * V;
+            const glm::vec3 vDir = vBody / V;
+
+            const float CL = liftCoefficient(p, alpha_);
+            const float CD = p.CD0 + p.inducedK * CL * CL;
+
+            // Sustentación ⟂ velocidad, en el plano de simetría
+            glm::vec3 liftDir = glm::cross(BODY_RIGHT, vDir);
+            const float liftLen2 = glm::dot(liftDir, liftDir);
+            if (liftLen2 > 1e-8f)
+                forceBody += liftDir * (qbar * p.wingArea * CL / std::sqrt(liftLen2));
+
+            forceBody -= vDir * (qbar * p.wingArea * CD);
+            forceBody += BODY_RIGHT * (qbar * p.wingArea * p.CYbeta * beta_);
+
+            // Tasas en convención aeronáutica (p: alabeo der., q: nariz arriba, r: nariz der.)
+            const float rollRate = -w.z;
+            const float pitchRate = w.x;
+            const float yawRate = -w.y;
+            const float bHat = p.wingSpan / (2.0f * V);
+            const float cHat = p.chord / (2.0f * V);
+
+            const float pitchMoment = qbar * p.wingArea * p.chord *
+                                      (p.Cm0 + p.Cmalpha * alpha_ + p.Cmq * pitchRate * cHat +
+                                       p.CmElevator * controls_.elevator);
+            const float rollMoment = qbar * p.wingArea * p.wingSpan *
+                                     (p.ClAileron * controls_.aileron + p.Clp * rollRate * bHat);
+            const float yawMoment = qbar * p.wingArea * p.wingSpan *
+                                    (p.Cnbeta * beta_ + p.Cnr * yawRate * bHat + p.CnRudder * controls_.rudder);
+
+            torqueBody += glm::vec3(pitchMoment, -yawMoment, -rollMoment);
+        }
+
+        // --- Lineal (mundo) ---
+        glm::vec3 accel = (s.orientation * forceBody) / p.mass;
+        accel.y -= GRAVITY;
+        s.velocity += accel * h;
+
+        // --- Angular (cuerpo): I·ω̇ = τ − ω × (I·ω) ---
+        const glm::vec3 Iw = p.inertia * w;
+        const glm::vec3 angAccel = (torqueBody - glm::cross(w, Iw)) / p.inertia;
+        s.angularVelocity += angAccel * h;
+
+        // --- Integración de posición y actitud ---
+        s.position += s.velocity * h;
+
+        const glm::vec3 &wn = s.angularVelocity;
+        const glm::quat spin(0.0f, wn.x, wn.y, wn.z);
+        s.orientation = glm::normalize(s.orientation + (s.orientation * spin) * (0.5f * h));
+
+        // --- Contacto con el piso (simplificado: sin tren de aterrizaje) ---
+        glm::vec3 groundNormal(0.0f, 1.0f, 0.0f);
+        const float groundHeight = (terrain_ ? terrain_->height(s.position.x, s.position.z, groundNormal) : 0.0f) + p.groundY;
+        if (s.position.y < groundHeight)
+        {
+            s.position.y = groundHeight;
+            // Se anula la componente que entra al terreno; en plano es vy = max(vy, 0)
+            const float into = glm::dot(s.velocity, groundNormal);
+            if (into < 0.0f)
+                s.velocity -= groundNormal * into;
+
+            glm::vec3 tangent = s.velocity - groundNormal * glm::dot(s.velocity, groundNormal);
+            const float speed = glm::length(tangent);
+            if (speed > 0.0f)
+            {
+                const float dv = std::min(speed, GROUND_FRICTION * GRAVITY * h);
+                s.velocity -= tangent * (dv / speed);
+            }
+            // El piso impide alabear o picar
+            s.angularVelocity.x *= 0.9f;
+            s.angularVelocity.z *= 0.9f;
+        }
+    }
+
+} // namespace flight
@@ -0,0 +1,127 @@
+// flight/FlightDynamics.h
+#pragma once
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace flight
+{
+
+    /**
+     * Modelo de vuelo 6-DOF de cuerpo rígido (avioneta tipo C172).
+     *
+     * Ejes de cuerpo = ejes OpenGL de la cámara:
+     *   +X derecha (ala), +Y arriba, −Z adelante (nariz).
+     * La orientación es el quaternion cuerpo→mundo; con identidad la nariz
+     * apunta a −Z, que es rumbo 0° (norte) en FlightData.
+     *
+     * Fuerzas: sustentación (CL lineal + caída tras pérdida), resistencia
+     * (CD0 + K·CL²), fuerza lateral por derrape, empuje y gravedad.
+     * Momentos: estabilidad estática (Cmα, Cnβ), amortiguamiento (Cmq, Clp, Cnr)
+     * y superficies de control.
+     *
+     * Paso fijo (1 kHz por defecto) con acumulador, independiente del framerate.
+     * El estado para mostrar se interpola entre los dos últimos pasos.
+     * No hace ninguna reserva de memoria: todo el estado es de tamaño fijo.
+     */
+    struct AircraftParams
+    {
+        float mass = 1100.0f;                                 // kg
+        glm::vec3 inertia = glm::vec3(1825.0f, 2667.0f, 1285.0f); // kg·m² (cabeceo X, guiñada Y, alabeo Z)
+        float wingArea = 16.2f;                               // m²
+        float wingSpan = 11.0f;                               // m
+        float chord = 1.5f;                                   // m (cuerda media)
+        float maxThrust = 2500.0f;                            // N
+
+        // Sustentación y resistencia
+        float CL0 = 0.30f;
+        float CLalpha = 5.0f;      // 1/rad
+        float alphaStall = 0.27f;  // rad (~15°)
+        float CD0 = 0.030f;
+        float inducedK = 0.053f;   // 1/(π·e·AR)
+        float CYbeta = -0.5f;      // fuerza lateral por derrape
+
+        // Momentos (coeficientes adimensionales)
+        float Cm0 = 0.0f;
+        float Cmalpha = -0.9f;     // estabilidad longitudinal
+        float Cmq = -12.0f;        // amortiguamiento de cabeceo
+        float CmElevator = 1.1f;   // +1 = tirar (nariz arriba)
+        float Clp = -0.47f;        // amortiguamiento de alabeo
+        float ClAileron = 0.18f;   // +1 = alabear a la derecha
+        float Cnbeta = 0.065f;     // estabilidad direccional (veleta)
+        float Cnr = -0.10f;        // amortiguamiento de guiñada
+        float CnRudder = 0.07f;    // +1 = nariz a la derecha
+
+        float airDensity = 1.225f; // kg/m³ (ISA nivel del mar; sin AirData)
+        float groundY = 1.8f;      // m, altura mínima sobre el terreno (misma que la cámara)
+    };
+
+    // Mandos normalizados; se mantienen constantes durante los sub-pasos del frame
+    struct ControlInputs
+    {
+        float elevator = 0.0f; // −1..1 (+ tirar)
+        float aileron = 0.0f;  // −1..1 (+ derecha)
+        float rudder = 0.0f;   // −1..1 (+ derecha)
+        float throttle = 0.5f; // 0..1
+    };
+
+    struct RigidBodyState
+    {
+        glm::vec3 position = glm::vec3(0.0f, 300.0f, 0.0f); // m (mundo)
+        glm::vec3 velocity = glm::vec3(0.0f, 0.0f, -55.0f); // m/s (mundo)
+        glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f); // cuerpo→mundo
+        glm::vec3 angularVelocity = glm::vec3(0.0f);        // rad/s (cuerpo)
+    };
+
+    class AirData;
+    class Heightfield;
+
+    class FlightDynamics
+    {
+    public:
+        static constexpr float kDefaultRateHz = 1000.0f;
+        static constexpr int kMaxStepsPerAdvance = 250; // tope anti "espiral de la muerte"
+
+        explicit FlightDynamics(float rateHz = kDefaultRateHz);
+
+        // Coloca el avión en vuelo recto y nivelado mirando hacia front
+        void reset(const glm::vec3 &position, const glm::vec3 &front, float speed);
+
+        void setParams(const AircraftParams &params) { params_ = params; }
+        const AircraftParams &params() const { return params_; }
+        void setControls(const ControlInputs &controls);
+        const ControlInputs &controls() const { return controls_; }
+
+        // Densidad y viento por altitud (no es dueño); nullptr = airDensity fija y calma
+        void setAirData(const AirData *airData) { airData_ = airData; }
+        // Piso = altura del terreno + groundY (no es dueño); nullptr = plano en y = 0
+        void setTerrain(const Heightfield *terrain) { terrain_ = terrain; }
+
+        // Acumula frameDt y ejecuta los pasos fijos que correspondan; devuelve cuántos
+        int advance(float frameDt);
+
+        // Estado interpolado entre el paso anterior y el actual (para mostrar)
+        RigidBodyState interpolated() const;
+        const RigidBodyState &current() const { return current_; }
+        float interpolationAlpha() const { return static_cast<float>(accumulator_ / step_); }
+        float stepSize() const { return static_cast<float>(step_); }
+
+        // Ángulo de ataque y derrape del último paso (rad), útiles para el HUD
+        float angleOfAttack() const { return alpha_; }
+        float sideslip() const { return beta_; }
+
+    private:
+        void step(float h);
+
+        AircraftParams params_;
+        ControlInputs controls_;
+        const AirData *airData_ = nullptr;
+        const Heightfield *terrain_ = nullptr;
+        RigidBodyState previous_;
+        RigidBodyState current_;
+        double step_;
+        double accumulator_ = 0.0;
+        float alpha_ = 0.0f;
+        float beta_ = 0.0f;
+    };
+
+} // namespace flight
@@ -0,0 +1,359 @@
+#include "flight/Heightfield.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace flight
+{
+
+    static constexpr int TILE_SAMPLES = Heightfield::kTileCells + 1;
+    static constexpr int NOISE_OCTAVES = 5;
+    static constexpr float SLAB_MARGIN = 1e-2f; // m
+
+    // ============================== Generación ==============================
+
+    // Valor pseudoaleatorio en [-1, 1] por vértice de la grilla de ruido
+    static float latticeValue(int x, int z, unsigned seed)
+    {
+        std::uint32_t h = static_cast<std::uint32_t>(x) * 0x8da6b343u ^ static_cast<std::uint32_t>(z) * 0xd8163841u ^ seed * 0xcb1ab31fu;
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        h ^= h >> 15;
+        return static_cast<float>(h & 0xffffu) * (2.0f / 65535.0f) - 1.0f;
+    }
+
+    static float valueNoise(float x, float z, unsigned seed)
+    {
+        const float fx = std::floor(x), fz = std::floor(z);
+        const int ix = static_cast<int>(fx), iz = static_cast<int>(fz);
+        float u = x - fx, v = z - fz;
+        u = u * u * (3.0f - 2.0f * u);
+        v = v * v * (3.0f - 2.0f * v);
+        const float a = latticeValue(ix, iz, seed), b = latticeValue(ix + 1, iz, seed);
+        const float c = latticeValue(ix, iz + 1, seed), d = latticeValue(ix + 1, iz + 1, seed);
+        return glm::mix(glm::mix(a, b, u), glm::mix(c, d, u), v);
+    }
+
+    float Heightfield::generate(float x, float z) const
+    {
+        const HeightfieldConfig &c = config_;
+        float n = 0.0f, amplitude = 0.5f, frequency = 1.0f / c.featureSize;
+        for (int o = 0; o < NOISE_OCTAVES; ++o)
+        {
+            n += amplitude * valueNoise(x * frequency, z * frequency, c.seed + static_cast<unsigned>(o));
+            amplitude *= 0.5f;
+            frequency *= 2.0f;
+        }
+
+        // Zona de despegue plana, transición suave hasta 2·flatRadius
+        const float r = std::sqrt(x * x + z * z);
+        const float mask = glm::smoothstep(c.flatRadius, 2.0f * c.flatRadius, r);
+        return c.relief * glm::clamp(n + 0.5f, 0.0f, 1.0f) * mask;
+    }
+
+    void Heightfield::build(const HeightfieldConfig &config)
+    {
+        config_ = config;
+        cells_ = std::max(kTileCells, config.cells) / kTileCells * kTileCells;
+        if ((cells_ & (cells_ - 1)) != 0)
+        {
+            std::cerr << "Heightfield cells must be a power of two, got " << config.cells << std::endl;
+            cells_ = 1024;
+        }
+        config_.cells = cells_;
+        tilesPerSide_ = cells_ / kTileCells;
+        half_ = halfExtent();
+        invSpacing_ = 1.0f / config_.spacing;
+
+        // --- Muestras, tile por tile ---
+        tiles_.assign(static_cast<std::size_t>(tilesPerSide_) * tilesPerSide_ * TILE_SAMPLES * TILE_SAMPLES, 0.0f);
+        for (int tj = 0; tj < tilesPerSide_; ++tj)
+            for (int ti = 0; ti < tilesPerSide_; ++ti)
+            {
+                float *tile = &tiles_[(static_cast<std::size_t>(tj) * tilesPerSide_ + ti) * TILE_SAMPLES * TILE_SAMPLES];
+                for (int lj = 0; lj < TILE_SAMPLES; ++lj)
+                    for (int li = 0; li < TILE_SAMPLES; ++li)
+                    {
+                        const float x = static_cast<float>(ti * kTileCells + li) * config_.spacing - half_;
+                        const float z = static_cast<float>(tj * kTileCells + lj) * config_.spacing - half_;
+                        tile[lj * TILE_SAMPLES + li] = config_.relief > 0.0f ? generate(x, z) : 0.0f;
+                    }
+            }
+
+        // --- Jerarquía min/max: nivel 0 = bloques de 2×2 celdas, cada nivel agrupa 2×2 ---
+        // Sin nivel por celda: las hojas leen sus esquinas de la tile, que el impacto
+        // necesita igual. Los 4 hijos de cada bloque quedan contiguos (una línea de caché).
+        mips_.clear();
+        mips_.emplace_back(static_cast<std::size_t>(cells_ / 2) * (cells_ / 2));
+        for (int j = 0; j < cells_ / 2; ++j)
+            for (int i = 0; i < cells_ / 2; ++i)
+            {
+                MinMax m = {sample(2 * i, 2 * j), sample(2 * i, 2 * j)};
+                for (int dj = 0; dj <= 2; ++dj)
+                    for (int di = 0; di <= 2; ++di)
+                    {
+                        const float h = sample(2 * i + di, 2 * j + dj);
+                        m.lo = std::min(m.lo, h);
+                        m.hi = std::max(m.hi, h);
+                    }
+                mips_[0][quadIndex(cells_ / 2, i, j)] = m;
+            }
+        for (int n = cells_ / 4; n >= 1; n /= 2)
+        {
+            const std::vector<MinMax> &child = mips_.back();
+            std::vector<MinMax> parent(static_cast<std::size_t>(n) * n);
+            for (int j = 0; j < n; ++j)
+                for (int i = 0; i < n; ++i)
+                {
+                    const MinMax *c = &child[(static_cast<std::size_t>(j) * n + i) * 4];
+                    parent[quadIndex(n, i, j)] = {std::min(std::min(c[0].lo, c[1].lo), std::min(c[2].lo, c[3].lo)),
+                                                  std::max(std::max(c[0].hi, c[1].hi), std::max(c[2].hi, c[3].hi))};
+                }
+            mips_.push_back(std::move(parent));
+        }
+    }
+
+    // ============================== Muestras ==============================
+
+    float Heightfield::sample(int i, int j) const
+    {
+        const int ti = std::min(i / kTileCells, tilesPerSide_ - 1);
+        const int tj = std::min(j / kTileCells, tilesPerSide_ - 1);
+        const float *tile = &tiles_[(static_cast<std::size_t>(tj) * tilesPerSide_ + ti) * TILE_SAMPLES * TILE_SAMPLES];
+        return tile[(j - tj * kTileCells) * TILE_SAMPLES + (i - ti * kTileCells)];
+    }
+
+    void Heightfield::cellCorners(int i, int j, float &h00, float &h10, float &h01, float &h11) const
+    {
+        // La celda entera vive en una tile (el borde derecho/inferior está repetido)
+        const int ti = i / kTileCells, tj = j / kTileCells;
+        const float *tile = &tiles_[(static_cast<std::size_t>(tj) * tilesPerSide_ + ti) * TILE_SAMPLES * TILE_SAMPLES];
+        const float *row = tile + (j - tj * kTileCells) * TILE_SAMPLES + (i - ti * kTileCells);
+        h00 = row[0];
+        h10 = row[1];
+        h01 = row[TILE_SAMPLES];
+        h11 = row[TILE_SAMPLES + 1];
+    }
+
+    void Heightfield::copySamples(std::vector<float> &rowMajor) const
+    {
+        const int n = samplesPerSide();
+        rowMajor.resize(static_cast<std::size_t>(n) * n);
+        for (int j = 0; j < n; ++j)
+            for (int i = 0; i < n; ++i)
+                rowMajor[static_cast<std::size_t>(j) * n + i] = sample(i, j);
+    }
+
+    // ============================== Consultas ==============================
+
+    float Heightfield::height(float x, float z) const
+    {
+        if (cells_ == 0)
+            return 0.0f;
+        int i, j;
+        float u, v, h00, h10, h01, h11;
+        locate(x, z, i, j, u, v);
+        cellCorners(i, j, h00, h10, h01, h11);
+        return glm::mix(glm::mix(h00, h10, u), glm::mix(h01, h11, u), v);
+    }
+
+    float Heightfield::height(float x, float z, glm::vec3 &normal) const
+    {
+        if (cells_ == 0)
+        {
+            normal = glm::vec3(0.0f, 1.0f, 0.0f);
+            return 0.0f;
+        }
+        int i, j;
+        float u, v, h00, h10, h01, h11;
+        locate(x, z, i, j, u, v);
+        cellCorners(i, j, h00, h10, h01, h11);
+
+        // Gradiente del parche bilineal (m/m)
+        const float dhdx = ((h10 - h00) * (1.0f - v) + (h11 - h01) * v) * invSpacing_;
+        const float dhdz = ((h01 - h00) * (1.0f - u) + (h11 - h10) * u) * invSpacing_;
+        normal = glm::normalize(glm::vec3(-dhdx, 1.0f, -dhdz));
+        return glm::mix(glm::mix(h00, h10, u), glm::mix(h01, h11, u), v);
+    }
+
+    glm::vec3 Heightfield::normal(float x, float z) const
+    {
+        glm::vec3 n;
+        height(x, z, n);
+        return n;
+    }
+
+    /**
+     * Rayo contra el parche bilineal de la celda (i, j) en [t0, t1].
+     * o y d están en coordenadas de grilla (x/z en celdas, y en metros).
+     */
+    bool Heightfield::intersectCell(int i, int j, const glm::vec3 &o, const glm::vec3 &d, float t0, float t1, float &t) const
+    {
+        float h00, h10, h01, h11;
+        cellCorners(i, j, h00, h10, h01, h11);
+        const float a = h10 - h00, b = h01 - h00, c = h00 - h10 - h01 + h11;
+
+        // Reparametrizar desde t0 evita cancelar con orígenes lejanos
+        const float u0 = o.x + d.x * t0 - static_cast<float>(i);
+        const float v0 = o.z + d.z * t0 - static_cast<float>(j);
+        const float y0 = o.y + d.y * t0;
+
+        // f(s) = y(s) − h(u(s), v(s)) = C + B s + A s²
+        const float C = y0 - (h00 + a * u0 + b * v0 + c * u0 * v0);
+        const float B = d.y - (a * d.x + b * d.z + c * (u0 * d.z + v0 * d.x));
+        const float A = -c * d.x * d.z;
+        const float len = t1 - t0;
+
+        if (C <= 0.0f)
+        {
+            t = t0; // entra a la celda ya por debajo (origen bajo tierra)
+            return true;
+        }
+
+        float s = -1.0f;
+        if (std::abs(A) < 1e-9f)
+        {
+            if (B < 0.0f)
+                s = -C / B;
+        }
+        else
+        {
+            const float disc = B * B - 4.0f * A * C;
+            if (disc >= 0.0f)
+            {
+                // Raíces estables numéricamente; la primera ≥ 0
+                const float q = -0.5f * (B + std::copysign(std::sqrt(disc), B));
+                float r0 = q / A, r1 = q != 0.0f ? C / q : r0;
+                if (r0 > r1)
+                    std::swap(r0, r1);
+                s = r0 >= 0.0f ? r0 : r1;
+            }
+        }
+
+        if (s < 0.0f || s > len)
+            return false;
+        t = t0 + s;
+        return true;
+    }
+
+    // Recorta [tIn, tOut] a los t donde o + t/inv cae en [a, b]. Sin avance en el eje
+    // (inv = ±inf) el rayo está adentro siempre o nunca: con el origen justo en un borde,
+    // (a − o)·inf daría 0·inf = NaN y descartaría los dos bloques vecinos
+    static bool clipAxis(float a, float b, float o, float inv, float &tIn, float &tOut)
+    {
+        if (std::isinf(inv))
+            return o >= a && o <= b;
+        const float ta = (a - o) * inv, tb = (b - o) * inv;
+        tIn = std::max(tIn, std::min(ta, tb));
+        tOut = std::min(tOut, std::max(ta, tb));
+        return tIn <= tOut;
+    }
+
+    bool Heightfield::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, TerrainHit &hit) const
+    {
+        const float length = glm::length(direction);
+        if (cells_ == 0 || !(length > 0.0f) || !(maxDistance > 0.0f))
+            return false;
+
+        // A coordenadas de grilla; t sigue midiendo metros de mundo
+        const glm::vec3 dir = direction / length;
+        const glm::vec3 o((origin.x + half_) * invSpacing_, origin.y, (origin.z + half_) * invSpacing_);
+        const glm::vec3 d(dir.x * invSpacing_, dir.y, dir.z * invSpacing_);
+        const glm::vec3 inv(1.0f / d.x, 1.0f / d.y, 1.0f / d.z); // ±inf en ejes sin avance
+
+        // Intervalo del rayo dentro del bloque [x0,x1]×[lo,hi]×[z0,z1]
+        // Margen en y: un bloque plano (lo == hi) no deja un intervalo de largo cero
+        auto slab = [&](float x0, float x1, float lo, float hi, float z0, float z1, float &tIn, float &tOut)
+        {
+            tIn = 0.0f;
+            tOut = maxDistance;
+            return clipAxis(x0, x1, o.x, inv.x, tIn, tOut) &&
+                   clipAxis(lo - SLAB_MARGIN, hi + SLAB_MARGIN, o.y, inv.y, tIn, tOut) &&
+                   clipAxis(z0, z1, o.z, inv.z, tIn, tOut);
+        };
+
+        struct Node
+        {
+            int level, i, j;
+            float tIn, tOut;
+        };
+        Node stack[4 * 32];
+        int top = 0;
+
+        const int root = static_cast<int>(mips_.size()) - 1;
+        {
+            const MinMax &m = mips_[root][0];
+            float tIn, tOut;
+            const float n = static_cast<float>(cells_);
+            if (!slab(0.0f, n, m.lo, m.hi, 0.0f, n, tIn, tOut))
+                return false;
+            stack[top++] = {root, 0, 0, tIn, tOut};
+        }
+
+        while (top > 0)
+        {
+            const Node node = stack[--top];
+
+            if (node.level < 0)
+            {
+                float t;
+                if (intersectCell(node.i, node.j, o, d, node.tIn, node.tOut, t))
+                {
+                    hit.distance = t;
+                    hit.point = origin + dir * t;
+                    hit.normal = normal(hit.point.x, hit.point.z);
+                    return true;
+                }
+                continue;
+            }
+
+            // Hijos que el rayo cruza: bloques del nivel de abajo o, bajo el nivel 0, celdas
+            const int level = node.level - 1;
+            const float size = level >= 0 ? static_cast<float>(2 << level) : 1.0f; // celdas por lado
+            MinMax bounds[4];
+            if (level >= 0)
+            {
+                const int n = cells_ >> (level + 1);
+                const MinMax *quad = &mips_[level][(static_cast<std::size_t>(node.j) * (n / 2) + node.i) * 4];
+                std::copy(quad, quad + 4, bounds);
+            }
+            else
+            {
+                for (int k = 0; k < 4; ++k)
+                {
+                    float h00, h10, h01, h11;
+                    cellCorners(2 * node.i + (k & 1), 2 * node.j + (k >> 1), h00, h10, h01, h11);
+                    bounds[k] = {std::min(std::min(h00, h10), std::min(h01, h11)),
+                                 std::max(std::max(h00, h10), std::max(h01, h11))};
+                }
+            }
+
+            // Inserción en la pila ordenada por entrada: el más cercano queda arriba
+            const int base = top;
+            for (int k = 0; k < 4; ++k)
+            {
+                const int ci = 2 * node.i + (k & 1), cj = 2 * node.j + (k >> 1);
+                Node child = {level, ci, cj, 0.0f, 0.0f};
+                if (!slab(ci * size, (ci + 1) * size, bounds[k].lo, bounds[k].hi, cj * size, (cj + 1) * size,
+                          child.tIn, child.tOut))
+                    continue;
+                int at = top++;
+                while (at > base && stack[at - 1].tIn < child.tIn)
+                {
+                    stack[at] = stack[at - 1];
+                    --at;
+                }
+                stack[at] = child;
+            }
+        }
+        return false;
+    }
+
+    bool Heightfield::lineOfSight(const glm::vec3 &a, const glm::vec3 &b) const
+    {
+        TerrainHit hit;
+        return !raycast(a, b - a, glm::length(b - a), hit);
+    }
+
+} // namespace flight
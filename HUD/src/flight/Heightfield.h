@@ -0,0 +1,111 @@
+// flight/Heightfield.h
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace flight
+{
+    struct HeightfieldConfig
+    {
+        int cells = 1024;            // celdas por lado (potencia de 2; el área es cells·spacing)
+        float spacing = 8.0f;        // m entre muestras
+        float relief = 120.0f;       // m, amplitud del relieve (0 = plano)
+        float featureSize = 1600.0f; // m, longitud de onda de la octava más grande
+        float flatRadius = 400.0f;   // m alrededor del origen que quedan a cota 0 (despegue)
+        unsigned seed = 1;
+    };
+
+    // Intersección de un rayo con el terreno
+    struct TerrainHit
+    {
+        float distance = 0.0f;               // m desde el origen del rayo
+        glm::vec3 point = glm::vec3(0.0f);   // mundo
+        glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    };
+
+    /**
+     * Terreno de alturas para consultas de CPU: colisión, radioaltímetro y
+     * línea de vista. La grilla está centrada en el origen; fuera de ella la
+     * altura es la del borde más cercano.
+     *
+     * Muestras en tiles de (kTileCells+1)² floats (el borde se repite): una
+     * consulta bilineal toca una sola tile, es decir una o dos líneas de caché.
+     *
+     * raycast recorre una jerarquía min/max (nivel 0 = bloques de 2×2 celdas,
+     * cada nivel agrupa 2×2) de adelante hacia atrás, descartando bloques
+     * enteros cuyo rango de alturas el rayo no cruza; en las celdas hoja
+     * resuelve la cuadrática rayo/parche bilineal, así el impacto coincide con height().
+     *
+     * Sólo lectura después de build(): se puede compartir entre hilos.
+     */
+    class Heightfield
+    {
+    public:
+        static constexpr int kTileCells = 32;
+
+        Heightfield() = default;
+        explicit Heightfield(const HeightfieldConfig &config) { build(config); }
+
+        // Genera las muestras (ruido fBm determinista) y la jerarquía
+        void build(const HeightfieldConfig &config);
+        bool empty() const { return cells_ == 0; }
+        const HeightfieldConfig &config() const { return config_; }
+
+        // --- Consultas puntuales (x, z en metros de mundo) ---
+        float height(float x, float z) const;
+        float height(float x, float z, glm::vec3 &normal) const;
+        glm::vec3 normal(float x, float z) const;
+
+        // Primer impacto de origin + t·direction con t en [0, maxDistance], dentro
+        // de la grilla (direction no necesita estar normalizada: distance se mide en m)
+        bool raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, TerrainHit &hit) const;
+        // true si el segmento a→b no toca el terreno
+        bool lineOfSight(const glm::vec3 &a, const glm::vec3 &b) const;
+
+        // --- Grilla completa (subir como textura) ---
+        int samplesPerSide() const { return cells_ + 1; }
+        float spacing() const { return config_.spacing; }
+        float halfExtent() const { return 0.5f * static_cast<float>(cells_) * config_.spacing; }
+        void copySamples(std::vector<float> &rowMajor) const; // [z][x], samplesPerSide()²
+
+    private:
+        struct MinMax
+        {
+            float lo, hi;
+        };
+
+        float generate(float x, float z) const;
+        float sample(int i, int j) const; // i = columna (x), j = fila (z)
+        void cellCorners(int i, int j, float &h00, float &h10, float &h01, float &h11) const;
+        bool intersectCell(int i, int j, const glm::vec3 &o, const glm::vec3 &d, float t0, float t1, float &t) const;
+
+        // Celda (i, j) y fracción (u, v) de un punto del mundo, recortados a la grilla
+        void locate(float x, float z, int &i, int &j, float &u, float &v) const
+        {
+            const float max = static_cast<float>(cells_) - 1e-3f;
+            const float gx = glm::clamp((x + half_) * invSpacing_, 0.0f, max);
+            const float gz = glm::clamp((z + half_) * invSpacing_, 0.0f, max);
+            i = static_cast<int>(gx);
+            j = static_cast<int>(gz);
+            u = gx - static_cast<float>(i);
+            v = gz - static_cast<float>(j);
+        }
+
+        // Posición del bloque (i, j) de un nivel de n×n: los hermanos 2×2 quedan juntos
+        static std::size_t quadIndex(int n, int i, int j)
+        {
+            return (static_cast<std::size_t>(j >> 1) * (n >> 1) + (i >> 1)) * 4 + ((j & 1) << 1) + (i & 1);
+        }
+
+        HeightfieldConfig config_;
+        int cells_ = 0;
+        int tilesPerSide_ = 0;
+        float half_ = 0.0f;
+        float invSpacing_ = 0.0f;
+
+        std::vector<float> tiles_;               // tile por tile, (kTileCells+1)² cada una
+        std::vector<std::vector<MinMax>> mips_;  // mips_[k]: (cells >> (k+1))² bloques, en grupos 2×2 (quadIndex)
+    };
+
+} // namespace flight
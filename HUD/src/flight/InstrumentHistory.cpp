@@ -0,0 +1,79 @@
+#include "flight/InstrumentHistory.h"
+#include <algorithm>
+
+namespace flight
+{
+
+    InstrumentHistory::InstrumentHistory(float windowSec, std::size_t capacity)
+        : window_(std::max(windowSec, 0.0f)), ring_(capacity)
+    {
+        const std::size_t cap = ring_.capacity();
+        mask_ = cap - 1;
+        times_.resize(cap);
+        for (int c = 0; c < TrendSample::kChannels; ++c)
+        {
+            values_[c].resize(cap);
+            minQueue_[c].items.resize(cap);
+            minQueue_[c].mask = mask_;
+            maxQueue_[c].items.resize(cap);
+            maxQueue_[c].mask = mask_;
+        }
+    }
+
+    void InstrumentHistory::record(const FlightData &data, double time)
+    {
+        const std::uint64_t n = count_++;
+        if (n > 0 && time < times_[(n - 1) & mask_])
+        {
+            // El reloj volvió atrás (seek, reinicio): la ventana arranca de cero
+            windowStart_ = n;
+            for (int c = 0; c < TrendSample::kChannels; ++c)
+            {
+                minQueue_[c].clear();
+                maxQueue_[c].clear();
+            }
+        }
+
+        TrendSample sample;
+        sample.time = time;
+        sample.value[static_cast<int>(TrendChannel::Airspeed)] = data.airspeed.value();
+        sample.value[static_cast<int>(TrendChannel::Altitude)] = data.altitude.value();
+        sample.value[static_cast<int>(TrendChannel::VerticalSpeed)] = data.verticalSpeed.value();
+
+        times_[n & mask_] = time;
+        for (int c = 0; c < TrendSample::kChannels; ++c)
+            values_[c][n & mask_] = sample.value[c];
+
+        // Inicio de la ventana: sólo avanza (fuera de tiempo o pisada por el anillo)
+        while (windowStart_ < n && (time - times_[windowStart_ & mask_] > window_ || windowStart_ + mask_ < n))
+            ++windowStart_;
+        const std::uint64_t first = windowStart_ & mask_;
+        sample.span = static_cast<float>(time - times_[first]);
+
+        for (int c = 0; c < TrendSample::kChannels; ++c)
+        {
+            const std::vector<float> &v = values_[c];
+            const float value = sample.value[c];
+            sample.rate[c] = sample.span > 0.0f ? (value - v[first]) / sample.span : 0.0f;
+
+            // Colas monótonas: el frente es el extremo de la ventana
+            MonotonicQueue &lo = minQueue_[c];
+            MonotonicQueue &hi = maxQueue_[c];
+            while (!lo.empty() && lo.front() < windowStart_)
+                lo.popFront();
+            while (!hi.empty() && hi.front() < windowStart_)
+                hi.popFront();
+            while (!lo.empty() && v[lo.back() & mask_] >= value)
+                lo.popBack();
+            while (!hi.empty() && v[hi.back() & mask_] <= value)
+                hi.popBack();
+            lo.push(n);
+            hi.push(n);
+            sample.min[c] = v[lo.front() & mask_];
+            sample.max[c] = v[hi.front() & mask_];
+        }
+
+        ring_.push(sample);
+    }
+
+} // namespace flight
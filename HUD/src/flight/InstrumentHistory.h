@@ -0,0 +1,100 @@
+// flight/InstrumentHistory.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "flight/FlightData.h"
+#include "util/HistoryRing.h"
+
+namespace flight
+{
+    // Valores con historia (los que tienen tendencia en el HUD)
+    enum class TrendChannel
+    {
+        Airspeed,      // kt
+        Altitude,      // ft
+        VerticalSpeed, // ft/min
+        Count
+    };
+
+    // Una muestra de la historia: el valor y su ventana hasta ese instante
+    struct TrendSample
+    {
+        static constexpr int kChannels = static_cast<int>(TrendChannel::Count);
+
+        double time = 0.0;       // s, reloj del productor
+        float span = 0.0f;       // s cubiertos por la ventana (< window al arrancar)
+        float value[kChannels] = {};
+        float rate[kChannels] = {}; // unidad/s: (valor − valor al inicio de la ventana) / span
+        float min[kChannels] = {};  // en la ventana
+        float max[kChannels] = {};
+
+        float valueOf(TrendChannel c) const { return value[static_cast<int>(c)]; }
+        float rateOf(TrendChannel c) const { return rate[static_cast<int>(c)]; }
+        float minOf(TrendChannel c) const { return min[static_cast<int>(c)]; }
+        float maxOf(TrendChannel c) const { return max[static_cast<int>(c)]; }
+    };
+
+    /**
+     * Historia de valores de instrumentos con tendencias en ventana deslizante.
+     *
+     * Un único productor (el hilo de simulación, o el de render si no hay
+     * hilo) llama a record() una vez por tick. Cada registro calcula, en O(1)
+     * amortizado sin importar el largo de la ventana:
+     * - rate: derivada media en la ventana, contra la muestra más vieja que
+     *   sigue adentro (el puntero de inicio sólo avanza).
+     * - min/max: colas monótonas de índices (cada muestra entra y sale una vez).
+     * y publica valor + tendencias como una muestra del HistoryRing. El HUD
+     * lee latest() desde cualquier hilo, sin locks y sin recorrer la ventana.
+     *
+     * La ventana efectiva nunca supera lo que entra en el anillo (capacity
+     * muestras). Si el tiempo retrocede (seek de un log) se vacía la ventana.
+     */
+    class InstrumentHistory
+    {
+    public:
+        explicit InstrumentHistory(float windowSec = 6.0f, std::size_t capacity = 4096);
+
+        InstrumentHistory(const InstrumentHistory &) = delete;
+        InstrumentHistory &operator=(const InstrumentHistory &) = delete;
+
+        // --- Productor ---
+        void record(const FlightData &data, double time);
+
+        // --- Lectores ---
+        bool latest(TrendSample &out) const { return ring_.latest(out); }
+        const util::HistoryRing<TrendSample> &ring() const { return ring_; }
+        float window() const { return window_; }
+
+    private:
+        // Cola monótona de números de muestra sobre un buffer fijo (capacidad del anillo)
+        struct MonotonicQueue
+        {
+            std::vector<std::uint64_t> items;
+            std::size_t mask = 0;
+            std::uint64_t head = 0, tail = 0; // [head, tail)
+
+            bool empty() const { return head == tail; }
+            std::uint64_t front() const { return items[head & mask]; }
+            std::uint64_t back() const { return items[(tail - 1) & mask]; }
+            void push(std::uint64_t n) { items[tail++ & mask] = n; }
+            void popFront() { ++head; }
+            void popBack() { --tail; }
+            void clear() { head = tail = 0; }
+        };
+
+        float window_;
+        util::HistoryRing<TrendSample> ring_;
+
+        // Copia privada del productor (mismo tamaño e índices que ring_) para
+        // comparar y restar sin pasar por el seqlock
+        std::size_t mask_;
+        std::vector<double> times_;
+        std::vector<float> values_[TrendSample::kChannels];
+        std::uint64_t count_ = 0;
+        std::uint64_t windowStart_ = 0; // muestra más vieja dentro de la ventana
+        MonotonicQueue minQueue_[TrendSample::kChannels];
+        MonotonicQueue maxQueue_[TrendSample::kChannels];
+    };
+
+} // namespace flight
@@ -0,0 +1,146 @@
+#include "flight/SimulationThread.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "flight/InstrumentHistory.h"
+#include "util/TelemetryLog.h"
+
+namespace flight
+{
+
+    using Clock = std::chrono::steady_clock;
+
+    // Atraso tolerado antes de re-sincronizar el reloj (en ticks)
+    static constexpr int MAX_LAG_TICKS = 8;
+
+    SimulationThread::SimulationThread(const Config &config)
+        : config_(config)
+    {
+        if (!(config_.rateHz > 0.0f))
+            config_.rateHz = Config{}.rateHz;
+    }
+
+    SimulationThread::~SimulationThread()
+    {
+        stop();
+    }
+
+    void SimulationThread::start(const FlightData &initial, const SimInput &input)
+    {
+        stop();
+
+        data_ = initial;
+        data_.dynamics = nullptr;
+        physics_ = false;
+        lastInputTime_ = input.time;
+        simTime_ = 0.0;
+
+        input_.writeBuffer() = input;
+        input_.publish();
+        output_.writeBuffer() = data_;
+        output_.publish();
+
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread(&SimulationThread::run, this);
+    }
+
+    void SimulationThread::stop()
+    {
+        running_.store(false, std::memory_order_release);
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    void SimulationThread::submit(const SimInput &input)
+    {
+        input_.writeBuffer() = input;
+        input_.publish();
+    }
+
+    const FlightData &SimulationThread::latest()
+    {
+        output_.update();
+        return output_.read();
+    }
+
+    SimulationThread::Stats SimulationThread::stats() const
+    {
+        Stats s;
+        s.ticks = ticks_.load(std::memory_order_relaxed);
+        s.lateTicks = lateTicks_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void SimulationThread::run()
+    {
+        const float dt = 1.0f / config_.rateHz;
+        const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dt));
+        Clock::time_point next = Clock::now();
+
+        while (running_.load(std::memory_order_acquire))
+        {
+            const bool newInput = input_.update();
+            tick(input_.read(), newInput, dt);
+
+            output_.writeBuffer() = data_;
+            output_.publish();
+            ticks_.fetch_add(1, std::memory_order_relaxed);
+
+            simTime_ += dt;
+            if (telemetry_)
+                telemetry_->push(data_, simTime_);
+            if (history_)
+                history_->record(data_, simTime_);
+
+            // Tasa fija: si el atraso es grande (debugger, SO) se descarta en lugar de
+            // encadenar ticks sin dormir; FlightDynamics ya acota los sub-pasos por llamada
+            next += period;
+            const Clock::time_point now = Clock::now();
+            if (now > next + period * MAX_LAG_TICKS)
+            {
+                next = now;
+                lateTicks_.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                std::this_thread::sleep_until(next);
+            }
+        }
+    }
+
+    void SimulationThread::tick(const SimInput &in, bool newInput, float dt)
+    {
+        // Cambio de modo pedido por el render
+        if (in.physics != physics_)
+        {
+            physics_ = in.physics;
+            if (physics_)
+            {
+                const glm::vec3 start(in.cameraPos.x, std::max(in.cameraPos.y, config_.physicsStartAltitude), in.cameraPos.z);
+                dynamics_.reset(start, in.camera.front, config_.physicsStartSpeed);
+                dynamics_.setAirData(data_.airData);
+                dynamics_.setTerrain(data_.terrain);
+                data_.dynamics = &dynamics_;
+            }
+            else
+            {
+                data_.dynamics = nullptr;
+            }
+        }
+
+        if (physics_)
+        {
+            dynamics_.setControls(in.controls);
+            data_.simulatePhysics(dt);
+        }
+        else if (newInput)
+        {
+            const float inputDt = static_cast<float>(in.time - lastInputTime_);
+            data_.updateFromCamera(in.camera, in.cameraPos, inputDt);
+            data_.simulatePhysics(inputDt);
+        }
+        if (newInput)
+            lastInputTime_ = in.time;
+    }
+
+} // namespace flight
@@ -0,0 +1,109 @@
+// flight/SimulationThread.h
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <glm/glm.hpp>
+#include "flight/FlightData.h"
+#include "flight/FlightDynamics.h"
+#include "util/TripleBuffer.h"
+
+namespace util
+{
+    class TelemetryWriter;
+}
+
+namespace flight
+{
+    class InstrumentHistory;
+
+    // Lo que el hilo de render (dueño de GLFW/input) le manda a la simulación
+    struct SimInput
+    {
+        glm::vec3 cameraPos = glm::vec3(0.0f, 1.8f, 0.0f);
+        CameraBasis camera; // ortonormal (CameraAttitude::basis())
+        ControlInputs controls;
+        bool physics = false; // false: instrumentos desde la cámara
+        double time = 0.0;    // s, reloj del render al tomar la muestra
+    };
+
+    /**
+     * Simulación en su propio hilo a tasa fija.
+     *
+     * Entrada y salida pasan por triple buffers lock-free: el render publica
+     * el input del frame sin esperar y lee el último FlightData publicado sin
+     * esperar. Un frame lento no frena la física y un pico de la física no
+     * frena el frame; lo peor que pasa es leer un snapshot un tick más viejo.
+     *
+     * - Modo física: cada tick avanza FlightDynamics (sub-pasos de 1 ms).
+     * - Modo cámara: updateFromCamera sólo cuando llega una muestra nueva, con
+     *   dt = diferencia de timestamps (si no, la velocidad medida serpentea).
+     *
+     * El FlightData publicado tiene `dynamics` apuntando al modelo del hilo de
+     * simulación: el render no debe usarlo.
+     *
+     * Con setTelemetry cada tick empuja una muestra (tiempo de simulación) a la
+     * cola del TelemetryWriter desde este hilo, que pasa a ser su único productor.
+     * Lo mismo con setHistory: cada tick se graba en la InstrumentHistory.
+     */
+    class SimulationThread
+    {
+    public:
+        struct Config
+        {
+            float rateHz = 240.0f;
+            float physicsStartSpeed = 55.0f;     // m/s al entrar en modo física
+            float physicsStartAltitude = 150.0f; // m, altura mínima al entrar
+        };
+
+        struct Stats
+        {
+            std::uint64_t ticks = 0;
+            std::uint64_t lateTicks = 0; // ticks que llegaron tarde (se re-sincronizó el reloj)
+        };
+
+        explicit SimulationThread(const Config &config);
+        ~SimulationThread();
+
+        SimulationThread(const SimulationThread &) = delete;
+        SimulationThread &operator=(const SimulationThread &) = delete;
+
+        // Antes de start(); nullptr la desactiva
+        void setTelemetry(util::TelemetryWriter *telemetry) { telemetry_ = telemetry; }
+        void setHistory(InstrumentHistory *history) { history_ = history; }
+
+        void start(const FlightData &initial, const SimInput &input);
+        void stop();
+        bool running() const { return thread_.joinable(); }
+
+        // --- Hilo de render (nunca bloquean) ---
+        void submit(const SimInput &input);
+        const FlightData &latest(); // válido hasta la próxima llamada a latest()
+
+        Stats stats() const;
+
+    private:
+        void run();
+        void tick(const SimInput &input, bool newInput, float dt);
+
+        Config config_;
+
+        // Sólo los toca el hilo de simulación
+        FlightData data_;
+        FlightDynamics dynamics_;
+        bool physics_ = false;
+        double lastInputTime_ = 0.0;
+        double simTime_ = 0.0;
+        util::TelemetryWriter *telemetry_ = nullptr;
+        InstrumentHistory *history_ = nullptr;
+
+        util::TripleBuffer<SimInput> input_;
+        util::TripleBuffer<FlightData> output_;
+
+        std::atomic<bool> running_{false};
+        std::atomic<std::uint64_t> ticks_{0};
+        std::atomic<std::uint64_t> lateTicks_{0};
+        std::thread thread_;
+    };
+
+} // namespace flight
@@ -0,0 +1,66 @@
+// flight/Units.cpp
+// Pruebas en compilación de Units.h: si alguna falla, el proyecto no compila.
+#include "flight/Units.h"
+#include <type_traits>
+
+namespace flight
+{
+    namespace units
+    {
+        namespace
+        {
+            using namespace literals;
+
+            constexpr bool near(float a, float b, float tolerance)
+            {
+                return (a > b ? a - b : b - a) <= tolerance;
+            }
+
+            // --- Sin costo: un float, copiable como tal (telemetría, memcpy, SoA) ---
+            static_assert(sizeof(Meters) == sizeof(float) && sizeof(Degrees) == sizeof(float), "sin overhead de tamaño");
+            static_assert(std::is_trivially_copyable<Feet>::value, "copiable con memcpy");
+            static_assert(std::is_standard_layout<Knots>::value, "layout de un float");
+
+            // --- Seguridad de tipos ---
+            static_assert(std::is_convertible<Meters, Feet>::value, "misma dimensión: implícita");
+            static_assert(std::is_convertible<Radians, Degrees>::value, "misma dimensión: implícita");
+            static_assert(!std::is_convertible<Knots, Feet>::value, "velocidad no es longitud");
+            static_assert(!std::is_convertible<Degrees, Meters>::value, "ángulo no es longitud");
+            static_assert(!std::is_convertible<float, Feet>::value, "un float suelto no tiene unidad");
+            static_assert(!std::is_convertible<Feet, float>::value, "salir de las unidades es explícito (value())");
+
+            // --- Factores (definiciones exactas) ---
+            static_assert(near(factor<Meters, Feet>(), 3.2808399f, 1e-6f), "m → ft");
+            static_assert(near(factor<MetersPerSecond, Knots>(), 1.9438445f, 1e-6f), "m/s → kt");
+            static_assert(near(factor<MetersPerSecond, FeetPerMinute>(), 196.85039f, 1e-4f), "m/s → ft/min");
+            static_assert(near(factor<Radians, Degrees>(), 57.295780f, 1e-5f), "rad → °");
+            static_assert(factor<Feet, Feet>() == 1.0f, "identidad");
+
+            // --- Conversiones resueltas al compilar ---
+            static_assert(near(Feet(304.8_m).value(), 1000.0f, 1e-3f), "304.8 m = 1000 ft");
+            static_assert(near(Meters(1000_ft).value(), 304.8f, 1e-4f), "ida y vuelta");
+            static_assert(near(Knots(1_mps).value(), 1.9438445f, 1e-5f), "1 m/s ≈ 1.944 kt");
+            static_assert(near(MetersPerSecond(100_kt).value(), 51.444444f, 1e-4f), "100 kt = 51.44 m/s");
+            static_assert(near(FeetPerMinute(5.08_mps).value(), 1000.0f, 1e-2f), "5.08 m/s = 1000 ft/min");
+            static_assert(near(Degrees(Radians(3.14159265f)).value(), 180.0f, 1e-4f), "π rad = 180°");
+            static_assert(near(Radians(90_deg).value(), 1.5707964f, 1e-6f), "90° = π/2");
+
+            // --- Aritmética dentro de la unidad ---
+            static_assert((1000_ft + 500_ft).value() == 1500.0f, "suma");
+            static_assert((Feet(1_m) - Feet(1_m)).value() == 0.0f, "resta entre unidades convertidas");
+            static_assert((-10_deg).value() == -10.0f, "negación");
+            static_assert((2.0f * 30_kt).value() == 60.0f && (30_kt * 2.0f).value() == 60.0f, "escala");
+            static_assert(250_ft / 100_ft == 2.5f, "cociente adimensional");
+            static_assert(100_kt > 90_kt && 90_kt <= 90_kt && 10_deg != 11_deg, "comparación");
+            static_assert([] {
+                Feet f = 100_ft;
+                f += 50_ft;
+                f -= 25_ft;
+                f *= 2.0f;
+                f /= 5.0f;
+                return f.value() == 50.0f;
+            }(), "operadores compuestos en constexpr");
+
+        } // namespace
+    } // namespace units
+} // namespace flight
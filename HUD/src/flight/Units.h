@@ -0,0 +1,124 @@
+// flight/Units.h
+#pragma once
+#include <type_traits>
+
+namespace flight
+{
+    namespace units
+    {
+        /**
+         * Cantidades con unidad en el tipo, sin costo en ejecución.
+         *
+         * Quantity<Dim, Scale> es un float con la dimensión (longitud, velocidad,
+         * ángulo) y la escala a la unidad base (SI; radián para ángulos) como
+         * parámetros de plantilla:
+         *
+         *   Feet alt = Meters(152.4f);        // conversión implícita: ×(1/0.3048)
+         *   Knots v = MetersPerSecond(55.0f); // ídem, factor constante
+         *   Feet bad = Knots(100.0f);         // no compila: otra dimensión
+         *
+         * El factor se calcula en double al compilar y queda como una sola
+         * multiplicación por constante: mismo código que el `x * 3.28084f` a mano.
+         * Las pruebas (static_assert) están en Units.cpp.
+         */
+
+        // ------------------------------ Dimensiones ------------------------------
+        struct Length {};
+        struct Speed {};
+        struct Angle {};
+
+        // ------------------------------ Escalas ------------------------------
+        // factor = cuántas unidades base vale una unidad (definiciones exactas)
+        struct MeterScale { static constexpr double factor = 1.0; };
+        struct FootScale { static constexpr double factor = 0.3048; };
+        struct MeterPerSecondScale { static constexpr double factor = 1.0; };
+        struct KnotScale { static constexpr double factor = 1852.0 / 3600.0; };
+        struct FootPerMinuteScale { static constexpr double factor = 0.3048 / 60.0; };
+        struct RadianScale { static constexpr double factor = 1.0; };
+        struct DegreeScale { static constexpr double factor = 3.14159265358979323846 / 180.0; };
+
+        template <typename Dim, typename Scale>
+        class Quantity;
+
+        // Multiplicar un valor en From por esto lo expresa en To (misma dimensión)
+        template <typename From, typename To>
+        constexpr float factor()
+        {
+            static_assert(std::is_same<typename From::dimension, typename To::dimension>::value,
+                          "conversión entre dimensiones distintas");
+            return static_cast<float>(From::scale::factor / To::scale::factor);
+        }
+
+        template <typename Dim, typename Scale>
+        class Quantity
+        {
+        public:
+            using dimension = Dim;
+            using scale = Scale;
+
+            constexpr Quantity() = default;
+            constexpr explicit Quantity(float value) : value_(value) {}
+
+            // Misma dimensión, otra unidad: implícita (como std::chrono)
+            template <typename OtherScale>
+            constexpr Quantity(Quantity<Dim, OtherScale> other)
+                : value_(other.value() * factor<Quantity<Dim, OtherScale>, Quantity>())
+            {
+            }
+
+            constexpr float value() const { return value_; }
+
+            constexpr Quantity operator-() const { return Quantity(-value_); }
+            constexpr Quantity &operator+=(Quantity o) { value_ += o.value_; return *this; }
+            constexpr Quantity &operator-=(Quantity o) { value_ -= o.value_; return *this; }
+            constexpr Quantity &operator*=(float k) { value_ *= k; return *this; }
+            constexpr Quantity &operator/=(float k) { value_ /= k; return *this; }
+
+            friend constexpr Quantity operator+(Quantity a, Quantity b) { return Quantity(a.value_ + b.value_); }
+            friend constexpr Quantity operator-(Quantity a, Quantity b) { return Quantity(a.value_ - b.value_); }
+            friend constexpr Quantity operator*(Quantity a, float k) { return Quantity(a.value_ * k); }
+            friend constexpr Quantity operator*(float k, Quantity a) { return Quantity(k * a.value_); }
+            friend constexpr Quantity operator/(Quantity a, float k) { return Quantity(a.value_ / k); }
+            friend constexpr float operator/(Quantity a, Quantity b) { return a.value_ / b.value_; } // adimensional
+
+            friend constexpr bool operator==(Quantity a, Quantity b) { return a.value_ == b.value_; }
+            friend constexpr bool operator!=(Quantity a, Quantity b) { return a.value_ != b.value_; }
+            friend constexpr bool operator<(Quantity a, Quantity b) { return a.value_ < b.value_; }
+            friend constexpr bool operator<=(Quantity a, Quantity b) { return a.value_ <= b.value_; }
+            friend constexpr bool operator>(Quantity a, Quantity b) { return a.value_ > b.value_; }
+            friend constexpr bool operator>=(Quantity a, Quantity b) { return a.value_ >= b.value_; }
+
+        private:
+            float value_ = 0.0f;
+        };
+
+        // ------------------------------ Unidades ------------------------------
+        using Meters = Quantity<Length, MeterScale>;
+        using Feet = Quantity<Length, FootScale>;
+        using MetersPerSecond = Quantity<Speed, MeterPerSecondScale>;
+        using Knots = Quantity<Speed, KnotScale>;
+        using FeetPerMinute = Quantity<Speed, FootPerMinuteScale>;
+        using Radians = Quantity<Angle, RadianScale>;
+        using Degrees = Quantity<Angle, DegreeScale>;
+
+        // ------------------------------ Literales ------------------------------
+        namespace literals
+        {
+            constexpr Meters operator""_m(long double v) { return Meters(static_cast<float>(v)); }
+            constexpr Meters operator""_m(unsigned long long v) { return Meters(static_cast<float>(v)); }
+            constexpr Feet operator""_ft(long double v) { return Feet(static_cast<float>(v)); }
+            constexpr Feet operator""_ft(unsigned long long v) { return Feet(static_cast<float>(v)); }
+            constexpr MetersPerSecond operator""_mps(long double v) { return MetersPerSecond(static_cast<float>(v)); }
+            constexpr MetersPerSecond operator""_mps(unsigned long long v) { return MetersPerSecond(static_cast<float>(v)); }
+            constexpr Knots operator""_kt(long double v) { return Knots(static_cast<float>(v)); }
+            constexpr Knots operator""_kt(unsigned long long v) { return Knots(static_cast<float>(v)); }
+            constexpr FeetPerMinute operator""_fpm(long double v) { return FeetPerMinute(static_cast<float>(v)); }
+            constexpr FeetPerMinute operator""_fpm(unsigned long long v) { return FeetPerMinute(static_cast<float>(v)); }
+            constexpr Radians operator""_rad(long double v) { return Radians(static_cast<float>(v)); }
+            constexpr Radians operator""_rad(unsigned long long v) { return Radians(static_cast<float>(v)); }
+            constexpr Degrees operator""_deg(long double v) { return Degrees(static_cast<float>(v)); }
+            constexpr Degrees operator""_deg(unsigned long long v) { return Degrees(static_cast<float>(v)); }
+        } // namespace literals
+
+    } // namespace units
+} // namespace flight
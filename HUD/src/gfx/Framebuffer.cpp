@@ -0,0 +1,83 @@
+#include "Framebuffer.h"
+#include "GLCheck.h"
+#include "GLState.h"
+#include <cstring>
+
+namespace gfx {
+
+void Framebuffer::create(int width, int height) {
+    release();
+    width_ = width;
+    height_ = height;
+
+    // Color: textura (se puede samplear después)
+    glGenTextures(1, &color_);
+    GLState::current().bindTexture(GL_TEXTURE_2D, color_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // Depth + stencil: renderbuffer (no se samplea)
+    glGenRenderbuffers(1, &depthStencil_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthStencil_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &fbo_);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthStencil_);
+
+    glCheck(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
+            "offscreen framebuffer incomplete");
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    checkGLError("Creating offscreen framebuffer");
+}
+
+void Framebuffer::resize(int width, int height) {
+    if (width == width_ && height == height_) return;
+    create(width, height);
+}
+
+void Framebuffer::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glViewport(0, 0, width_, height_);
+}
+
+void Framebuffer::bindDefault() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void Framebuffer::readPixels(std::vector<unsigned char>& rgb) const {
+    const size_t rowBytes = static_cast<size_t>(width_) * 3;
+    rgb.resize(rowBytes * height_);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width_, height_, GL_RGB, GL_UNSIGNED_BYTE, rgb.data());
+
+    // GL entrega la fila inferior primero: invertir a orden de imagen
+    std::vector<unsigned char> row(rowBytes);
+    for (int y = 0; y < height_ / 2; ++y) {
+        unsigned char* a = rgb.data() + y * rowBytes;
+        unsigned char* b = rgb.data() + (height_ - 1 - y) * rowBytes;
+        std::memcpy(row.data(), a, rowBytes);
+        std::memcpy(a, b, rowBytes);
+        std::memcpy(b, row.data(), rowBytes);
+    }
+}
+
+void Framebuffer::release() {
+    if (fbo_) glDeleteFramebuffers(1, &fbo_);
+    if (depthStencil_) glDeleteRenderbuffers(1, &depthStencil_);
+    if (color_) {
+        GLState::current().forgetTexture(color_);
+        glDeleteTextures(1, &color_);
+    }
+    fbo_ = depthStencil_ = color_ = 0;
+    width_ = height_ = 0;
+}
+
+} // namespace gfx
@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+
+extern "C" {
+#include <glad/glad.h>
+}
+
+namespace gfx {
+
+/**
+ * Framebuffer offscreen: color RGBA8 en textura + depth/stencil en renderbuffer.
+ *
+ * Se usa para renderizar sin ventana visible (modo headless) y leer el
+ * resultado con readPixels().
+ */
+class Framebuffer {
+public:
+    Framebuffer() = default;
+    ~Framebuffer() { release(); }
+
+    // No permitir copia
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+
+    void create(int width, int height); // lanza si el FBO queda incompleto
+    void resize(int width, int height);
+
+    void bind() const;          // bindea y ajusta el viewport
+    static void bindDefault();  // vuelve al framebuffer de la ventana
+
+    // Lee el color como RGB8, filas de arriba hacia abajo (orden de imagen)
+    void readPixels(std::vector<unsigned char>& rgb) const;
+
+    GLuint id() const { return fbo_; }
+    GLuint colorTexture() const { return color_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+private:
+    GLuint fbo_ = 0;
+    GLuint color_ = 0;
+    GLuint depthStencil_ = 0;
+    int width_ = 0, height_ = 0;
+
+    void release();
+};
+
+} // namespace gfx
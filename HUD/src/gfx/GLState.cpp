@@ -0,0 +1,147 @@
+#include "GLState.h"
+
+namespace gfx {
+
+static GLState sDefaultState;
+static GLState* sCurrentState = &sDefaultState;
+
+GLState& GLState::current() { return *sCurrentState; }
+
+void GLState::makeCurrent(GLState* state) { sCurrentState = state ? state : &sDefaultState; }
+
+int GLState::capIndex(GLenum cap) {
+    switch (cap) {
+    case GL_BLEND: return 0;
+    case GL_DEPTH_TEST: return 1;
+    case GL_CULL_FACE: return 2;
+    case GL_SCISSOR_TEST: return 3;
+    case GL_STENCIL_TEST: return 4;
+    default: return -1;
+    }
+}
+
+int GLState::targetIndex(GLenum target) {
+    switch (target) {
+    case GL_TEXTURE_2D: return 0;
+    case GL_TEXTURE_CUBE_MAP: return 1;
+    default: return -1;
+    }
+}
+
+void GLState::invalidate() {
+    for (auto& c : caps_) c = -1;
+    depthFunc_ = kUnknown;
+    depthMask_ = kUnknown;
+    colorMask_ = kUnknown;
+    blendSrc_ = blendDst_ = kUnknown;
+    blendSrcAlpha_ = blendDstAlpha_ = kUnknown;
+    program_ = kUnknown;
+    vao_ = kUnknown;
+    activeUnit_ = kUnknown;
+    for (auto& unit : textures_)
+        for (auto& t : unit) t = kUnknown;
+}
+
+void GLState::setEnabled(GLenum cap, bool enabled) {
+    const int i = capIndex(cap);
+    const std::int8_t v = enabled ? 1 : 0;
+    if (i >= 0 && !changed(caps_[i] != v)) return;
+    if (i < 0) ++stats_.issued; // capacidad no cacheada: pasa directo
+    else caps_[i] = v;
+
+    if (enabled) glEnable(cap);
+    else glDisable(cap);
+}
+
+void GLState::depthFunc(GLenum func) {
+    if (!changed(depthFunc_ != func)) return;
+    depthFunc_ = func;
+    glDepthFunc(func);
+}
+
+void GLState::depthMask(GLboolean write) {
+    if (!changed(depthMask_ != write)) return;
+    depthMask_ = write;
+    glDepthMask(write);
+}
+
+void GLState::colorMask(GLboolean write) {
+    if (!changed(colorMask_ != write)) return;
+    colorMask_ = write;
+    glColorMask(write, write, write, write);
+}
+
+void GLState::blendFunc(GLenum src, GLenum dst) {
+    if (!changed(blendSrc_ != src || blendDst_ != dst || blendSrcAlpha_ != src || blendDstAlpha_ != dst)) return;
+    blendSrc_ = blendSrcAlpha_ = src;
+    blendDst_ = blendDstAlpha_ = dst;
+    glBlendFunc(src, dst);
+}
+
+void GLState::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    if (!changed(blendSrc_ != srcRGB || blendDst_ != dstRGB ||
+                 blendSrcAlpha_ != srcAlpha || blendDstAlpha_ != dstAlpha)) return;
+    blendSrc_ = srcRGB;
+    blendDst_ = dstRGB;
+    blendSrcAlpha_ = srcAlpha;
+    blendDstAlpha_ = dstAlpha;
+    glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
+void GLState::useProgram(GLuint program) {
+    if (!changed(program_ != program)) return;
+    program_ = program;
+    glUseProgram(program);
+}
+
+void GLState::bindVertexArray(GLuint vao) {
+    if (!changed(vao_ != vao)) return;
+    vao_ = vao;
+    glBindVertexArray(vao);
+}
+
+void GLState::activeTexture(GLuint unit) {
+    if (!changed(activeUnit_ != unit)) return;
+    activeUnit_ = unit;
+    glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLState::bindTexture(GLenum target, GLuint texture) {
+    const int t = targetIndex(target);
+    if (t < 0 || activeUnit_ >= kMaxUnits) {
+        // Unidad/target sin cache: emitir siempre
+        ++stats_.issued;
+        glBindTexture(target, texture);
+        return;
+    }
+    if (!changed(textures_[activeUnit_][t] != texture)) return;
+    textures_[activeUnit_][t] = texture;
+    glBindTexture(target, texture);
+}
+
+void GLState::bindTextureUnit(GLuint unit, GLenum target, GLuint texture) {
+    const int t = targetIndex(target);
+    // Si la textura ya está en esa unidad, no hace falta ni cambiar la unidad activa
+    if (filtering_ && t >= 0 && unit < kMaxUnits && textures_[unit][t] == texture) {
+        stats_.filtered += 2;
+        return;
+    }
+    activeTexture(unit);
+    bindTexture(target, texture);
+}
+
+void GLState::forgetProgram(GLuint program) {
+    if (program_ == program) program_ = kUnknown;
+}
+
+void GLState::forgetVertexArray(GLuint vao) {
+    if (vao_ == vao) vao_ = kUnknown;
+}
+
+void GLState::forgetTexture(GLuint texture) {
+    for (auto& unit : textures_)
+        for (auto& t : unit)
+            if (t == texture) t = kUnknown;
+}
+
+} // namespace gfx
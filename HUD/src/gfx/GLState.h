@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+
+extern "C" {
+#include <glad/glad.h>
+}
+
+namespace gfx {
+
+/**
+ * Sombra (shadow state) del estado GL del contexto actual.
+ *
+ * Recuerda el último valor enviado al driver y filtra las llamadas redundantes
+ * (glEnable/glDisable, glUseProgram, glBindVertexArray, glBindTexture, ...).
+ * Todo el código del proyecto debe pasar por aquí para que el cache sea válido;
+ * si se llama a GL directamente, usar invalidate().
+ *
+ * Cada contexto GL tiene su propio estado: con varios contextos se crea un
+ * GLState por contexto y se activa con makeCurrent().
+ */
+class GLState {
+public:
+    struct Stats {
+        std::uint64_t issued = 0;   // llamadas que llegaron al driver
+        std::uint64_t filtered = 0; // llamadas evitadas por redundantes
+    };
+
+    static GLState& current();
+    static void makeCurrent(GLState* state); // nullptr → estado por defecto
+
+    GLState() { invalidate(); }
+
+    // Capacidades (GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST)
+    void enable(GLenum cap) { setEnabled(cap, true); }
+    void disable(GLenum cap) { setEnabled(cap, false); }
+    void setEnabled(GLenum cap, bool enabled);
+
+    void depthFunc(GLenum func);
+    void depthMask(GLboolean write);
+    void colorMask(GLboolean write);
+    void blendFunc(GLenum src, GLenum dst);
+    void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+
+    void activeTexture(GLuint unit); // índice de unidad (0, 1, ...), no GL_TEXTUREi
+    void bindTexture(GLenum target, GLuint texture); // en la unidad activa
+    void bindTextureUnit(GLuint unit, GLenum target, GLuint texture);
+
+    // Al borrar objetos GL, el driver desbindea y el nombre puede reutilizarse
+    void forgetProgram(GLuint program);
+    void forgetVertexArray(GLuint vao);
+    void forgetTexture(GLuint texture);
+
+    // Olvidar todo el cache (p. ej. después de código GL externo)
+    void invalidate();
+
+    const Stats& stats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+    // false: toda llamada llega al driver (como sin cache); la sombra se sigue
+    // actualizando, así que se puede volver a encender en cualquier momento
+    void setFiltering(bool enabled) { filtering_ = enabled; }
+    bool filtering() const { return filtering_; }
+
+private:
+    static constexpr int kMaxCaps = 5;
+    static constexpr int kMaxUnits = 16;
+    static constexpr int kNumTargets = 2; // GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP
+    static constexpr GLuint kUnknown = 0xFFFFFFFFu;
+
+    // -1 desconocido, 0 apagado, 1 encendido
+    std::int8_t caps_[kMaxCaps];
+    GLenum depthFunc_;
+    GLuint depthMask_;
+    GLuint colorMask_;
+    GLenum blendSrc_, blendDst_;
+    GLenum blendSrcAlpha_, blendDstAlpha_;
+    GLuint program_;
+    GLuint vao_;
+    GLuint activeUnit_;
+    GLuint textures_[kMaxUnits][kNumTargets];
+
+    Stats stats_;
+    bool filtering_ = true;
+
+    // true si hay que emitir la llamada (y actualiza contadores)
+    bool changed(bool differs) {
+        differs = differs || !filtering_;
+        if (differs) ++stats_.issued;
+        else ++stats_.filtered;
+        return differs;
+    }
+
+    static int capIndex(GLenum cap);
+    static int targetIndex(GLenum target);
+};
+
+} // namespace gfx
@@ -0,0 +1,98 @@
+#include "HeadlessContext.h"
+#include <iostream>
+
+extern "C" {
+#include <glad/glad.h>
+}
+
+#ifdef HUD_HEADLESS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace gfx {
+
+#ifdef HUD_HEADLESS_EGL
+
+bool HeadlessContext::available() { return true; }
+
+bool HeadlessContext::create() {
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!getPlatformDisplay) {
+        std::cerr << "EGL: eglGetPlatformDisplayEXT not available" << std::endl;
+        return false;
+    }
+
+    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    EGLint major = 0, minor = 0;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        std::cerr << "EGL: cannot initialize surfaceless display" << std::endl;
+        return false;
+    }
+    display_ = display;
+
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_NONE};
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        std::cerr << "EGL: no OpenGL config" << std::endl;
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL: cannot bind OpenGL API" << std::endl;
+        return false;
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE};
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        std::cerr << "EGL: cannot create OpenGL 3.3 core context" << std::endl;
+        return false;
+    }
+    context_ = context;
+
+    // Sin superficie: requiere EGL_KHR_surfaceless_context
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        std::cerr << "EGL: eglMakeCurrent without surface failed" << std::endl;
+        return false;
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+        std::cerr << "Failed to initialize GLAD (EGL)" << std::endl;
+        return false;
+    }
+
+    std::cout << "EGL surfaceless context " << major << "." << minor << std::endl;
+    return true;
+}
+
+HeadlessContext::~HeadlessContext() {
+    if (!display_) return;
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context_) eglDestroyContext(display_, context_);
+    eglTerminate(display_);
+}
+
+#else
+
+bool HeadlessContext::available() { return false; }
+
+bool HeadlessContext::create() {
+    std::cerr << "Headless EGL support not compiled (build with HEADLESS_EGL=1)" << std::endl;
+    return false;
+}
+
+HeadlessContext::~HeadlessContext() {}
+
+#endif
+
+} // namespace gfx
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace gfx {
+
+/**
+ * Contexto OpenGL 3.3 core sin ventana ni servidor gráfico.
+ *
+ * Usa EGL con la plataforma "surfaceless" de Mesa (funciona con llvmpipe en
+ * servidores de build sin X11). Solo se compila con `make HEADLESS_EGL=1`;
+ * si no, available() devuelve false y el modo headless usa una ventana GLFW
+ * invisible.
+ *
+ * No tiene framebuffer por defecto: todo se dibuja en un gfx::Framebuffer.
+ */
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    static bool available();
+
+    // Crea el contexto, lo hace current y carga las funciones GL (glad)
+    bool create();
+
+private:
+    void* display_ = nullptr;
+    void* context_ = nullptr;
+};
+
+} // namespace gfx
@@ -0,0 +1,118 @@
+#include "RenderQueue.h"
+#include "GLState.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gfx {
+
+RenderQueue::RenderQueue() {
+    items_.reserve(64);
+    entries_.reserve(128);
+}
+
+void RenderQueue::begin() {
+    items_.clear();
+    entries_.clear();
+}
+
+void RenderQueue::submit(DrawItem item) {
+    const std::uint32_t index = static_cast<std::uint32_t>(items_.size());
+
+    entries_.push_back({makeKey(item.pass, item.shader, item.texture, item.depth), index, false});
+
+    // Pre-pass: solo profundidad, sin textura (todas comparten el orden front-to-back)
+    if (depthPrepass_ && item.drawDepth) {
+        entries_.push_back({makeKey(RenderPass::DepthPrepass, item.depthShader, 0, item.depth), index, true});
+    }
+
+    items_.push_back(std::move(item));
+}
+
+/**
+ * Clave de 64 bits:  [pasada:4][shader:12][textura:12][libre:4][profundidad:32]
+ *
+ * Para floats no negativos, los bits IEEE-754 ordenan igual que el valor,
+ * así que la profundidad entra sin cuantizar.
+ */
+std::uint64_t RenderQueue::makeKey(RenderPass pass, GLuint shader, GLuint texture, float depth) {
+    if (!(depth > 0.0f)) depth = 0.0f; // también descarta NaN
+    std::uint32_t depthBits;
+    std::memcpy(&depthBits, &depth, sizeof(depthBits));
+
+    return (std::uint64_t(pass) & 0xF) << 60 |
+           (std::uint64_t(shader) & 0xFFF) << 48 |
+           (std::uint64_t(texture) & 0xFFF) << 36 |
+           std::uint64_t(depthBits);
+}
+
+void RenderQueue::beginPass(RenderPass pass, bool prepassRan) {
+    GLState& gl = GLState::current();
+    switch (pass) {
+    case RenderPass::DepthPrepass:
+        gl.colorMask(GL_FALSE);
+        gl.depthMask(GL_TRUE);
+        gl.depthFunc(GL_LESS);
+        break;
+    case RenderPass::Opaque:
+        gl.colorMask(GL_TRUE);
+        // Con pre-pass, la profundidad ya está escrita: aceptar iguales
+        gl.depthFunc(prepassRan ? GL_LEQUAL : GL_LESS);
+        break;
+    case RenderPass::Sky:
+        // El skybox configura su propio estado de profundidad
+        gl.colorMask(GL_TRUE);
+        break;
+    }
+}
+
+void RenderQueue::flush() {
+    stats_ = RenderQueueStats{};
+
+    // Orden estable: a igual clave se respeta el orden de submit
+    std::stable_sort(entries_.begin(), entries_.end(),
+                     [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+    bool prepassRan = false;
+    bool first = true;
+    RenderPass currentPass = RenderPass::Opaque;
+    GLuint currentShader = 0;
+    GLuint currentTexture = 0;
+
+    for (const Entry& e : entries_) {
+        const DrawItem& item = items_[e.item];
+        const RenderPass pass = e.depthOnly ? RenderPass::DepthPrepass : item.pass;
+        const GLuint shader = e.depthOnly ? item.depthShader : item.shader;
+        const GLuint texture = e.depthOnly ? 0 : item.texture;
+
+        if (first || pass != currentPass) {
+            beginPass(pass, prepassRan);
+            if (!first) ++stats_.passChanges;
+            currentPass = pass;
+        }
+        if (first || shader != currentShader) {
+            ++stats_.shaderChanges;
+            currentShader = shader;
+        }
+        if (texture != 0 && (first || texture != currentTexture)) {
+            ++stats_.textureChanges;
+            currentTexture = texture;
+        }
+        first = false;
+
+        if (e.depthOnly) {
+            item.drawDepth();
+            prepassRan = true;
+        } else {
+            item.draw();
+        }
+        ++stats_.drawCalls;
+    }
+
+    // Dejar el estado por defecto para lo que venga después (HUD)
+    GLState& gl = GLState::current();
+    gl.colorMask(GL_TRUE);
+    gl.depthMask(GL_TRUE);
+    gl.depthFunc(GL_LESS);
+}
+
+} // namespace gfx
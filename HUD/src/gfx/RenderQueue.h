@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+extern "C" {
+#include <glad/glad.h>
+}
+
+namespace gfx {
+
+// Pasadas en orden de ejecución
+enum class RenderPass : std::uint8_t {
+    DepthPrepass = 0, // solo profundidad (colorMask apagado)
+    Opaque = 1,       // geometría opaca, front-to-back
+    Sky = 2           // skybox: al final, aprovecha el early-Z
+};
+
+/**
+ * Un draw call diferido. Los campos shader/texture/depth solo se usan para
+ * ordenar; el trabajo real lo hace `draw`.
+ *
+ * Si `drawDepth` está definido y el pre-pass está activo, la cola agrega una
+ * entrada extra en DepthPrepass que lo llama (con el shader `depthShader`).
+ */
+struct DrawItem {
+    RenderPass pass = RenderPass::Opaque;
+    GLuint shader = 0;
+    GLuint texture = 0;
+    float depth = 0.0f; // distancia a la cámara (>= 0)
+    std::function<void()> draw;
+
+    GLuint depthShader = 0;
+    std::function<void()> drawDepth;
+};
+
+struct RenderQueueStats {
+    int drawCalls = 0;
+    int shaderChanges = 0;
+    int textureChanges = 0;
+    int passChanges = 0;
+
+    int stateChanges() const { return shaderChanges + textureChanges + passChanges; }
+};
+
+/**
+ * Cola de render por frame: ordena por (pasada, shader, textura, profundidad)
+ * para minimizar cambios de estado y dibujar los opacos de adelante hacia atrás.
+ *
+ * Uso por frame:
+ *   queue.begin();
+ *   queue.submit(item); ...
+ *   queue.flush();      // ordena y ejecuta
+ */
+class RenderQueue {
+public:
+    RenderQueue();
+
+    void begin();
+    void submit(DrawItem item);
+    void flush();
+
+    void setDepthPrepass(bool enabled) { depthPrepass_ = enabled; }
+    bool depthPrepass() const { return depthPrepass_; }
+
+    // Estadísticas del último flush()
+    const RenderQueueStats& stats() const { return stats_; }
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        std::uint32_t item;
+        bool depthOnly;
+    };
+
+    std::vector<DrawItem> items_;
+    std::vector<Entry> entries_;
+    bool depthPrepass_ = false;
+    RenderQueueStats stats_;
+
+    static std::uint64_t makeKey(RenderPass pass, GLuint shader, GLuint texture, float depth);
+    void beginPass(RenderPass pass, bool prepassRan);
+};
+
+} // namespace gfx
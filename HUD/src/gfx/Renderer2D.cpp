@@ -1,16 +1,23 @@
 #include "gfx/Renderer2D.h"
 #include "gfx/GLCheck.h"
+#include "gfx/GLState.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <cmath>
+#include <functional>
 
 namespace gfx
 {
 
+    // Cajas (x0, y0, x1, y1) que se pisan; una caja vacía no pisa nada
+    static inline bool overlaps(const glm::vec4 &a, const glm::vec4 &b)
+    {
+        return a.x < b.z && b.x < a.z && a.y < b.w && b.y < a.w;
+    }
+
     Renderer2D::Renderer2D() : vao_(0), vbo_(0), ebo_(0), screenWidth_(800), screenHeight_(600)
     {
-        vertices_.reserve(MAX_VERTICES);
-        indices_.reserve(MAX_INDICES);
     }
 
     Renderer2D::~Renderer2D()
@@ -19,8 +26,19 @@ namespace gfx
             glDeleteBuffers(1, &ebo_);
         if (vbo_)
             glDeleteBuffers(1, &vbo_);
+        if (uploadFence_)
+            glDeleteSync(uploadFence_);
         if (vao_)
+        {
+            // Los VAO de otros contextos mueren con su contexto (o releaseContext())
+            GLState::current().forgetVertexArray(vao_);
             glDeleteVertexArrays(1, &vao_);
+        }
+        if (whiteTexture_)
+        {
+            GLState::current().forgetTexture(whiteTexture_);
+            glDeleteTextures(1, &whiteTexture_);
+        }
     }
 
     void Renderer2D::init(int screenWidth, int screenHeight)
@@ -31,6 +49,11 @@ namespace gfx
         // Crear proyección ortográfica
         projection_ = glm::ortho(0.0f, (float)screenWidth_, (float)screenHeight_, 0.0f, -1.0f, 1.0f);
 
+        // Las arenas (sin init) crecen según lo que graben
+        vertices_.reserve(MAX_VERTICES);
+        indices_.reserve(MAX_INDICES);
+        drawIndices_.reserve(MAX_INDICES);
+
         setupBuffers();
 
         // Cargar shader 2D
@@ -50,7 +73,8 @@ namespace gfx
         glGenBuffers(1, &vbo_);
         glGenBuffers(1, &ebo_);
 
-        glBindVertexArray(vao_);
+        GLState::current().bindVertexArray(vao_);
+        contexts_.push_back(ContextVao{&GLState::current(), vao_, 0});
 
         glBindBuffer(GL_ARRAY_BUFFER, vbo_);
         glBufferData(GL_ARRAY_BUFFER, MAX_VERTICES * sizeof(Vertex2D), nullptr, GL_DYNAMIC_DRAW);
@@ -58,6 +82,26 @@ namespace gfx
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, MAX_INDICES * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
 
+        attachBuffers();
+        GLState::current().bindVertexArray(0);
+
+        // Textura blanca 1×1: sin textura = modular por blanco, mismo estado
+        const unsigned char white[4] = {255, 255, 255, 255};
+        glGenTextures(1, &whiteTexture_);
+        GLState::current().bindTexture(GL_TEXTURE_2D, whiteTexture_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        texture_ = whiteTexture_;
+
+        checkGLError("Setting up 2D renderer buffers");
+    }
+
+    void Renderer2D::attachBuffers()
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+
         // Position
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2D), (void *)offsetof(Vertex2D, position));
         glEnableVertexAttribArray(0);
@@ -70,15 +114,74 @@ namespace gfx
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2D), (void *)offsetof(Vertex2D, texCoord));
         glEnableVertexAttribArray(2);
 
-        glBindVertexArray(0);
+        // Rectángulo de recorte
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex2D), (void *)offsetof(Vertex2D, clipRect));
+        glEnableVertexAttribArray(3);
 
-        checkGLError("Setting up 2D renderer buffers");
+        // Grupos de vistas (entero: se compara por bits en el shader)
+        glVertexAttribIPointer(4, 1, GL_UNSIGNED_INT, sizeof(Vertex2D), (void *)offsetof(Vertex2D, viewBits));
+        glEnableVertexAttribArray(4);
+    }
+
+    /**
+     * @brief VAO del contexto actual, creado la primera vez que se dibuja en él
+     */
+    Renderer2D::ContextVao &Renderer2D::contextVao()
+    {
+        const GLState *context = &GLState::current();
+        for (ContextVao &entry : contexts_)
+        {
+            if (entry.context == context)
+                return entry;
+        }
+
+        ContextVao entry{context, 0, 0};
+        glGenVertexArrays(1, &entry.vao);
+        GLState::current().bindVertexArray(entry.vao);
+        attachBuffers();
+        contexts_.push_back(entry);
+        return contexts_.back();
+    }
+
+    void Renderer2D::attachContext()
+    {
+        contextVao();
+    }
+
+    void Renderer2D::releaseContext()
+    {
+        const GLState *context = &GLState::current();
+        for (size_t i = 0; i < contexts_.size(); ++i)
+        {
+            if (contexts_[i].context != context || contexts_[i].vao == vao_)
+                continue;
+            GLState::current().forgetVertexArray(contexts_[i].vao);
+            glDeleteVertexArrays(1, &contexts_[i].vao);
+            contexts_.erase(contexts_.begin() + i);
+            return;
+        }
     }
 
     void Renderer2D::begin()
     {
         vertices_.clear();
         indices_.clear();
+        commands_.clear();
+        scopes_.clear();
+        batchBroken_ = true;
+
+        layer_ = 0;
+        blend_ = BlendMode::Alpha;
+        texture_ = whiteTexture_;
+        customShader_ = nullptr;
+        shaderParams_ = glm::vec4(0.0f);
+        clipRect_ = Vertex2D{}.clipRect;
+        viewBits_ = ~0u;
+        clipStack_.clear();
+        maskStack_.clear();
+        definingMask_ = false;
+        stencilLevel_ = 0;
+        openScope_ = -1;
     }
 
     void Renderer2D::end()
@@ -88,36 +191,534 @@ namespace gfx
 
     void Renderer2D::flush()
     {
-        if (vertices_.empty())
+        upload();
+        draw(View{});
+    }
+
+    void Renderer2D::upload()
+    {
+        buildDrawList();
+        uploadedMasks_ = !scopes_.empty();
+        if (!drawCalls_.empty())
+        {
+            GLState &gl = GLState::current();
+
+            // El EBO es estado del VAO: bindear el VAO antes de tocarlo
+            ContextVao &context = contextVao();
+            gl.bindVertexArray(context.vao);
+
+            // Subir datos a GPU (una vez para todos los draw calls; si no entran, crecer)
+            glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+            if (vertices_.size() > vertexCapacity_)
+            {
+                vertexCapacity_ = vertices_.size() * 2;
+                glBufferData(GL_ARRAY_BUFFER, vertexCapacity_ * sizeof(Vertex2D), nullptr, GL_DYNAMIC_DRAW);
+            }
+            glBufferSubData(GL_ARRAY_BUFFER, 0, vertices_.size() * sizeof(Vertex2D), vertices_.data());
+
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+            if (drawIndices_.size() > indexCapacity_)
+            {
+                indexCapacity_ = drawIndices_.size() * 2;
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCapacity_ * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+            }
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, drawIndices_.size() * sizeof(GLuint), drawIndices_.data());
+
+            // Otros contextos esperan este fence antes de leer los buffers
+            ++uploads_;
+            context.upload = uploads_;
+            uploadContext_ = context.context;
+            if (uploadFence_)
+            {
+                glDeleteSync(uploadFence_);
+                uploadFence_ = nullptr;
+            }
+            if (contexts_.size() > 1)
+            {
+                uploadFence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                glFlush(); // que el fence llegue a la GPU antes de cambiar de contexto
+            }
+
+            checkGLError("Uploading 2D renderer");
+        }
+
+        vertices_.clear();
+        indices_.clear();
+        commands_.clear();
+        scopes_.clear();
+    }
+
+    void Renderer2D::draw(const View &view)
+    {
+        if (drawCalls_.empty())
             return;
 
-        // Subir datos a GPU
-        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices_.size() * sizeof(Vertex2D), vertices_.data());
+        GLState &gl = GLState::current();
+        ContextVao &context = contextVao();
+        gl.bindVertexArray(context.vao);
+        if (context.upload != uploads_)
+        {
+            // Subido desde otro contexto: esperar en la GPU y volver a
+            // engancharlos para que los cambios sean visibles acá
+            if (uploadFence_)
+                glWaitSync(uploadFence_, 0, GL_TIMEOUT_IGNORED);
+            attachBuffers();
+            context.upload = uploads_;
+        }
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
-        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices_.size() * sizeof(GLuint), indices_.data());
+        viewProjection_ = projection_;
+        if (view.region.z > 0.0f && view.region.w > 0.0f)
+            viewProjection_ = glm::ortho(view.region.x, view.region.x + view.region.z,
+                                         view.region.y + view.region.w, view.region.y, -1.0f, 1.0f);
+        viewMask_ = view.mask;
 
-        // Renderizar
         shader_.use();
-        shader_.setMat4("uProjection", projection_);
+        shader_.setMat4("uProjection", viewProjection_);
+        shader_.setUint("uViewMask", viewMask_);
+        shader_.setInt("uTexture", 0);
 
-        glBindVertexArray(vao_);
-        glDrawElements(GL_TRIANGLES, indices_.size(), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        // Con máscaras el stencil tiene que arrancar en 0 (glClear respeta el scissor)
+        if (uploadedMasks_)
+        {
+            gl.disable(GL_SCISSOR_TEST);
+            glStencilMask(0xFF);
+            glClearStencil(0);
+            glClear(GL_STENCIL_BUFFER_BIT);
+        }
+
+        for (const DrawCall &call : drawCalls_)
+        {
+            applyState(call.state);
+            glDrawElements(GL_TRIANGLES, call.indexCount, GL_UNSIGNED_INT,
+                           (void *)(call.firstIndex * sizeof(GLuint)));
+        }
 
-        checkGLError("Flushing 2D renderer");
+        // Dejar el estado como lo espera el resto (blend normal, sin stencil)
+        gl.disable(GL_STENCIL_TEST);
+        gl.colorMask(GL_TRUE);
+        gl.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        checkGLError("Drawing 2D renderer");
     }
 
+    void Renderer2D::applyState(const DrawState &state)
+    {
+        GLState &gl = GLState::current();
+
+        if (state.shader)
+        {
+            // Uniforms por draw call: un shader propio suele ser un solo quad
+            state.shader->use();
+            state.shader->setMat4("uProjection", viewProjection_);
+            state.shader->setUint("uViewMask", viewMask_);
+            state.shader->setInt("uTexture", 0);
+            state.shader->setVec4("uParams", state.params);
+        }
+        else
+            shader_.use();
+
+        gl.bindTextureUnit(0, GL_TEXTURE_2D, state.texture);
+        switch (state.blend)
+        {
+        case BlendMode::Alpha:
+            gl.blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::Additive:
+            gl.blendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE);
+            break;
+        case BlendMode::Premultiplied:
+            gl.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        }
+
+        switch (state.type)
+        {
+        case CommandType::Draw:
+            gl.colorMask(GL_TRUE);
+            gl.setEnabled(GL_STENCIL_TEST, state.stencilLevel > 0);
+            if (state.stencilLevel > 0)
+            {
+                glStencilFunc(GL_EQUAL, state.stencilLevel, 0xFF);
+                glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            }
+            break;
+        case CommandType::MaskWrite:
+            // Sólo dentro de la máscara de afuera; un píxel cubierto dos veces
+            // ya no pasa el EQUAL, así que sube un solo nivel
+            gl.colorMask(GL_FALSE);
+            gl.enable(GL_STENCIL_TEST);
+            glStencilFunc(GL_EQUAL, state.stencilLevel, 0xFF);
+            glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+            break;
+        case CommandType::MaskErase:
+            gl.colorMask(GL_FALSE);
+            gl.enable(GL_STENCIL_TEST);
+            glStencilFunc(GL_EQUAL, state.stencilLevel + 1, 0xFF);
+            glStencilOp(GL_KEEP, GL_KEEP, GL_DECR);
+            break;
+        }
+    }
+
+    // ============================================================================
+    // ORDEN Y FUSIÓN DE COMANDOS
+    // ============================================================================
+
+    void Renderer2D::buildDrawList()
+    {
+        closeRecording();
+
+        drawIndices_.clear();
+        drawCalls_.clear();
+
+        // Ítems en orden de grabación: comandos sueltos (índice de comando) y
+        // bloques de máscara (commands_.size() + índice de scope)
+        const size_t scopeBase = commands_.size();
+        order_.clear();
+        for (size_t c = 0; c < commands_.size();)
+        {
+            const int s = commands_[c].scope;
+            if (s < 0)
+            {
+                order_.push_back(c);
+                ++c;
+            }
+            else
+            {
+                order_.push_back(scopeBase + s);
+                c = scopes_[s].endCommand;
+            }
+        }
+
+        // Orden estable por clave: capa, sin máscara antes que con máscara,
+        // blend, shader, textura. Los bloques de máscara conservan su orden relativo
+        auto less = [&](size_t a, size_t b)
+        {
+            const bool sa = a >= scopeBase, sb = b >= scopeBase;
+            const int la = sa ? scopes_[a - scopeBase].layer : commands_[a].layer;
+            const int lb = sb ? scopes_[b - scopeBase].layer : commands_[b].layer;
+            if (la != lb)
+                return la < lb;
+            if (sa || sb)
+                return !sa && sb;
+            return lessState(commands_[a].state, commands_[b].state);
+        };
+        std::stable_sort(order_.begin(), order_.end(), less);
+
+        // Después del último bloque de máscara nadie lee el stencil: no hace falta borrarlo
+        size_t lastScopeItem = 0;
+        for (size_t i = 0; i < order_.size(); ++i)
+            if (order_[i] >= scopeBase)
+                lastScopeItem = i + 1;
+
+        std::vector<size_t> group;
+        for (size_t i = 0; i < order_.size();)
+        {
+            if (order_[i] < scopeBase)
+            {
+                emit(commands_[order_[i++]]);
+                continue;
+            }
+
+            // Juntar bloques vecinos de la misma capa si ningún contenido pisa la
+            // máscara de otro: entonces da igual escribir todas las máscaras primero
+            group.assign(1, order_[i++] - scopeBase);
+            const Scope &head = scopes_[group[0]];
+            while (!head.nested && i < order_.size() && order_[i] >= scopeBase)
+            {
+                const Scope &next = scopes_[order_[i] - scopeBase];
+                bool disjoint = !next.nested && next.layer == head.layer;
+                for (size_t k = 0; disjoint && k < group.size(); ++k)
+                {
+                    const Scope &g = scopes_[group[k]];
+                    disjoint = !overlaps(next.contentBounds, g.maskBounds) && !overlaps(g.contentBounds, next.maskBounds);
+                }
+                if (!disjoint)
+                    break;
+                group.push_back(order_[i++] - scopeBase);
+            }
+            emitScopes(group, i < lastScopeItem);
+        }
+
+        stats_.commands = commands_.size();
+        stats_.drawCalls = drawCalls_.size();
+        stats_.vertices = vertices_.size();
+        stats_.indices = drawIndices_.size();
+    }
+
+    bool Renderer2D::lessState(const DrawState &x, const DrawState &y)
+    {
+        if (x.blend != y.blend)
+            return x.blend < y.blend;
+        if (x.shader != y.shader)
+            return std::less<const Shader *>()(x.shader, y.shader);
+        return x.texture < y.texture;
+    }
+
+    void Renderer2D::emitScopes(const std::vector<size_t> &group, bool keepStencil)
+    {
+        auto each = [&](CommandType type, auto &&fn)
+        {
+            for (size_t s : group)
+                for (size_t c = scopes_[s].firstCommand; c < scopes_[s].endCommand; ++c)
+                    if (commands_[c].state.type == type)
+                        fn(c);
+        };
+
+        // Con máscaras anidadas: tal cual se grabó (el borrado final sólo si hace falta)
+        if (scopes_[group[0]].nested)
+        {
+            const Scope &s = scopes_[group[0]];
+            for (size_t c = s.firstCommand; c < s.endCommand; ++c)
+            {
+                const Command &command = commands_[c];
+                if (keepStencil || command.state.type != CommandType::MaskErase || command.state.stencilLevel > 0)
+                    emit(command);
+            }
+            return;
+        }
+
+        // 1) Todas las máscaras, 2) el contenido ordenado por estado, 3) borrar
+        each(CommandType::MaskWrite, [&](size_t c)
+             { emit(commands_[c]); });
+
+        std::vector<size_t> content;
+        each(CommandType::Draw, [&](size_t c)
+             { content.push_back(c); });
+        std::stable_sort(content.begin(), content.end(), [&](size_t a, size_t b)
+                         { return lessState(commands_[a].state, commands_[b].state); });
+        for (size_t c : content)
+            emit(commands_[c]);
+
+        if (keepStencil)
+            each(CommandType::MaskErase, [&](size_t c)
+                 { emit(commands_[c]); });
+    }
+
+    void Renderer2D::emit(const Command &command)
+    {
+        if (command.indexCount == 0)
+            return;
+
+        // Reescribir los índices en orden de dibujo: estados iguales quedan contiguos
+        const GLuint first = static_cast<GLuint>(drawIndices_.size());
+        drawIndices_.insert(drawIndices_.end(), indices_.begin() + command.firstIndex,
+                            indices_.begin() + command.firstIndex + command.indexCount);
+
+        if (!drawCalls_.empty() && drawCalls_.back().state == command.state)
+            drawCalls_.back().indexCount += command.indexCount;
+        else
+            drawCalls_.push_back({command.state, first, command.indexCount});
+    }
+
+    // ============================================================================
+    // ESTADO Y RECORTE
+    // ============================================================================
+
+    void Renderer2D::closeCommand()
+    {
+        // Con el batch abierto, el último comando es de geometría y sigue creciendo
+        if (!batchBroken_ && !commands_.empty())
+            commands_.back().indexCount = static_cast<GLuint>(indices_.size()) - commands_.back().firstIndex;
+    }
+
+    void Renderer2D::closeRecording()
+    {
+        breakBatch();
+        if (openScope_ >= 0) // máscara sin pop: se dibuja lo que haya
+            scopes_[openScope_].endCommand = commands_.size();
+    }
+
+    void Renderer2D::append(Renderer2D &arena)
+    {
+        arena.closeRecording();
+        breakBatch(); // lo que se grabe después abre comando propio
+
+        const GLuint vertexBase = static_cast<GLuint>(vertices_.size());
+        const GLuint indexBase = static_cast<GLuint>(indices_.size());
+        const size_t commandBase = commands_.size();
+        const int scopeBase = static_cast<int>(scopes_.size());
+
+        vertices_.insert(vertices_.end(), arena.vertices_.begin(), arena.vertices_.end());
+
+        indices_.reserve(indices_.size() + arena.indices_.size());
+        for (GLuint index : arena.indices_)
+            indices_.push_back(index + vertexBase);
+
+        commands_.reserve(commands_.size() + arena.commands_.size());
+        for (Command command : arena.commands_)
+        {
+            command.firstIndex += indexBase;
+            if (command.scope >= 0)
+                command.scope += scopeBase;
+            if (command.state.texture == arena.whiteTexture_)
+                command.state.texture = whiteTexture_;
+            commands_.push_back(command);
+        }
+
+        for (Scope scope : arena.scopes_)
+        {
+            scope.firstCommand += commandBase;
+            scope.endCommand += commandBase;
+            scopes_.push_back(scope);
+        }
+    }
+
+    void Renderer2D::breakBatch()
+    {
+        closeCommand();
+        batchBroken_ = true;
+    }
+
+    void Renderer2D::setLayer(int layer)
+    {
+        if (layer == layer_)
+            return;
+        breakBatch();
+        layer_ = layer;
+    }
+
+    void Renderer2D::setViewBits(GLuint bits)
+    {
+        viewBits_ = bits;
+    }
+
+    void Renderer2D::setBlendMode(BlendMode mode)
+    {
+        if (mode == blend_)
+            return;
+        breakBatch();
+        blend_ = mode;
+    }
+
+    void Renderer2D::setTexture(GLuint texture)
+    {
+        if (texture == texture_)
+            return;
+        breakBatch();
+        texture_ = texture;
+    }
+
+    void Renderer2D::setShader(const Shader *shader, const glm::vec4 &params)
+    {
+        if (shader == customShader_ && (!shader || params == shaderParams_))
+            return;
+        breakBatch();
+        customShader_ = shader;
+        shaderParams_ = shader ? params : glm::vec4(0.0f);
+    }
+
+    void Renderer2D::pushClipRect(const glm::vec2 &position, const glm::vec2 &size)
+    {
+        // Va en los vértices: no corta el batch
+        clipStack_.push_back(clipRect_);
+        clipRect_ = glm::vec4(std::max(clipRect_.x, position.x), std::max(clipRect_.y, position.y),
+                              std::min(clipRect_.z, position.x + size.x), std::min(clipRect_.w, position.y + size.y));
+    }
+
+    void Renderer2D::popClipRect()
+    {
+        if (clipStack_.empty())
+            return;
+        clipRect_ = clipStack_.back();
+        clipStack_.pop_back();
+    }
+
+    void Renderer2D::beginClipMask()
+    {
+        if (definingMask_)
+            return;
+        breakBatch();
+        if (maskStack_.empty())
+        {
+            Scope scope;
+            scope.firstCommand = commands_.size();
+            scope.layer = layer_;
+            openScope_ = static_cast<int>(scopes_.size());
+            scopes_.push_back(scope);
+        }
+        else
+        {
+            scopes_[openScope_].nested = true;
+        }
+        definingMask_ = true;
+        maskStack_.push_back({static_cast<GLuint>(indices_.size()), 0, stencilLevel_});
+    }
+
+    void Renderer2D::endClipMask()
+    {
+        if (!definingMask_)
+            return;
+        breakBatch();
+        definingMask_ = false;
+        MaskRange &mask = maskStack_.back();
+        mask.indexCount = static_cast<GLuint>(indices_.size()) - mask.firstIndex;
+        ++stencilLevel_;
+    }
+
+    void Renderer2D::popClipMask()
+    {
+        if (maskStack_.empty() || definingMask_)
+            return;
+        breakBatch();
+        const MaskRange mask = maskStack_.back();
+        maskStack_.pop_back();
+        stencilLevel_ = mask.stencilLevel;
+
+        // Borrar la máscara redibujando su geometría (sin duplicar vértices)
+        Command erase;
+        erase.state.type = CommandType::MaskErase;
+        erase.state.stencilLevel = mask.stencilLevel;
+        erase.state.texture = whiteTexture_;
+        erase.layer = layer_;
+        erase.scope = openScope_;
+        erase.firstIndex = mask.firstIndex;
+        erase.indexCount = mask.indexCount;
+        commands_.push_back(erase);
+
+        if (maskStack_.empty())
+        {
+            scopes_[openScope_].endCommand = commands_.size();
+            openScope_ = -1;
+        }
+    }
+
+    // ============================================================================
+    // PRIMITIVAS
+    // ============================================================================
+
     void Renderer2D::addVertex(const Vertex2D &vertex)
     {
-        if (vertices_.size() >= MAX_VERTICES)
+        // Primera primitiva después de un cambio de estado: comando nuevo. Los
+        // índices de la primitiva se agregan después del vértice, así que
+        // el comando arranca en el índice actual
+        if (batchBroken_)
         {
-            flush();
-            vertices_.clear();
-            indices_.clear();
+            Command command;
+            command.state.type = definingMask_ ? CommandType::MaskWrite : CommandType::Draw;
+            command.state.stencilLevel = stencilLevel_;
+            command.state.blend = definingMask_ ? BlendMode::Alpha : blend_; // sin color: da igual
+            command.state.texture = definingMask_ ? whiteTexture_ : texture_;
+            command.state.shader = definingMask_ ? nullptr : customShader_;
+            command.state.params = definingMask_ ? glm::vec4(0.0f) : shaderParams_;
+            command.layer = layer_;
+            command.scope = openScope_;
+            command.firstIndex = static_cast<GLuint>(indices_.size());
+            commands_.push_back(command);
+            batchBroken_ = false;
         }
         vertices_.push_back(vertex);
+        vertices_.back().clipRect = clipRect_;
+        vertices_.back().viewBits = viewBits_;
+
+        // Caja envolvente (ya recortada) para decidir si las máscaras se fusionan
+        if (openScope_ >= 0)
+        {
+            Scope &scope = scopes_[openScope_];
+            glm::vec4 &bounds = definingMask_ ? scope.maskBounds : scope.contentBounds;
+            const float x = std::min(std::max(vertex.position.x, clipRect_.x), clipRect_.z);
+            const float y = std::min(std::max(vertex.position.y, clipRect_.y), clipRect_.w);
+            bounds = glm::vec4(std::min(bounds.x, x), std::min(bounds.y, y), std::max(bounds.z, x), std::max(bounds.w, y));
+        }
     }
 
     void Renderer2D::addQuad(const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color)
@@ -180,6 +781,54 @@ namespace gfx
         }
     }
 
+    void Renderer2D::drawImage(const glm::vec2 &position, const glm::vec2 &size, GLuint texture,
+                               const glm::vec2 &uvMin, const glm::vec2 &uvMax, const glm::vec4 &tint)
+    {
+        setTexture(texture);
+
+        GLuint baseIndex = vertices_.size();
+        addVertex({{position.x, position.y}, tint, {uvMin.x, uvMin.y}});
+        addVertex({{position.x + size.x, position.y}, tint, {uvMax.x, uvMin.y}});
+        addVertex({{position.x + size.x, position.y + size.y}, tint, {uvMax.x, uvMax.y}});
+        addVertex({{position.x, position.y + size.y}, tint, {uvMin.x, uvMax.y}});
+
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 1);
+        indices_.push_back(baseIndex + 2);
+
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 2);
+        indices_.push_back(baseIndex + 3);
+
+        // Lo siguiente vuelve a la textura blanca (se fusiona con el resto al ordenar)
+        setTexture(whiteTexture_);
+    }
+
+    void Renderer2D::drawShaderQuad(const glm::vec2 &position, const glm::vec2 &size, const Shader &shader,
+                                    const glm::vec4 &params, const glm::vec2 &uvMin, const glm::vec2 &uvMax,
+                                    const glm::vec4 &color)
+    {
+        setShader(&shader, params);
+        setTexture(whiteTexture_);
+
+        GLuint baseIndex = vertices_.size();
+        addVertex({{position.x, position.y}, color, {uvMin.x, uvMin.y}});
+        addVertex({{position.x + size.x, position.y}, color, {uvMax.x, uvMin.y}});
+        addVertex({{position.x + size.x, position.y + size.y}, color, {uvMax.x, uvMax.y}});
+        addVertex({{position.x, position.y + size.y}, color, {uvMin.x, uvMax.y}});
+
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 1);
+        indices_.push_back(baseIndex + 2);
+
+        indices_.push_back(baseIndex);
+        indices_.push_back(baseIndex + 2);
+        indices_.push_back(baseIndex + 3);
+
+        // Lo siguiente vuelve al shader del renderer
+        setShader(nullptr, glm::vec4(0.0f));
+    }
+
     void Renderer2D::drawCircle(const glm::vec2 &center, float radius, const glm::vec4 &color, int segments, bool filled)
     {
         if (filled)
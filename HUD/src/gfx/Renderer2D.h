@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -17,11 +18,83 @@ namespace gfx
         glm::vec2 position;
         glm::vec4 color;
         glm::vec2 texCoord;
+        glm::vec4 clipRect = glm::vec4(-1e9f, -1e9f, 1e9f, 1e9f); // x0, y0, x1, y1: fuera se descarta
+        GLuint viewBits = ~0u; // grupos: una vista lo dibuja si comparte un bit con su máscara
     };
 
+    // El alfa del destino se acumula como "over" (Alpha) o no se toca
+    // (Additive): dibujando sobre un target transparente queda una imagen
+    // premultiplicada, que se compone con Premultiplied (ver FlightHUD)
+    enum class BlendMode
+    {
+        Alpha,         // src·a + dst·(1−a)
+        Additive,      // src·a + dst (brillo de fósforo, halos)
+        Premultiplied  // src + dst·(1−a) (texturas con el color ya multiplicado por alfa)
+    };
+
+    /**
+     * Renderer 2D por lista de comandos.
+     *
+     * Las primitivas se acumulan en un único VBO/EBO; cada cambio de estado
+     * (textura, shader, blend, capa, máscara) corta el batch y abre un comando con su
+     * clave. flush() ordena los comandos de forma estable por clave dentro de
+     * cada capa, reescribe los índices en ese orden y fusiona los vecinos con
+     * el mismo estado: un draw call por estado distinto, no por cambio. Con
+     * todos los instrumentos el HUD queda en 1-3 draw calls (ver stats()).
+     *
+     * Orden: las capas (setLayer) se dibujan en orden creciente; dentro de una
+     * capa el orden entre comandos de distinto estado no está garantizado. Lo
+     * que deba quedar encima va en una capa mayor.
+     *
+     * Recorte:
+     * - pushClipRect/popClipRect: pila de rectángulos; cada uno se intersecta
+     *   con el anterior. Va en los vértices (el fragment shader descarta lo de
+     *   afuera), así que no corta el batch. Coordenadas de pantalla del HUD.
+     * - beginClipMask/endClipMask/popClipMask: máscara arbitraria (stencil).
+     *   Lo que se dibuja entre begin y end no se ve: marca el área. Hasta el
+     *   pop, sólo se dibuja dentro de ella (y de las máscaras de afuera).
+     *   Requiere stencil en el framebuffer; se limpia en flush() si hace falta.
+     *   El pop vuelve a dibujar la misma geometría decrementando: no hay que
+     *   repetirla. No cambiar de capa dentro de una máscara.
+     *
+     * Máscaras de instrumentos distintos (sin anidar) se fusionan: todas las
+     * escrituras juntas, después todo el contenido enmascarado, si ningún
+     * contenido cae sobre la máscara de otro (por cajas envolventes).
+     *
+     * Arenas: un Renderer2D sin init() sólo graba (no toca GL), así que se
+     * puede llenar desde otro hilo. append() lo copia al final de este con los
+     * índices, comandos y máscaras rebasados; las primitivas sin textura de la
+     * arena pasan a usar la textura blanca de este. Llamar append() fuera de
+     * máscaras: la arena arranca en nivel de stencil 0 y sin recorte.
+     *
+     * Vistas: flush() es upload() + draw() de todo el lienzo. Para varias
+     * pantallas se sube una vez y se llama a draw() por vista, cada una con su
+     * región del lienzo (proyección) y su máscara de grupos (setViewBits): lo
+     * que no comparte bits se descarta en el vertex shader, así que los draw
+     * calls son los mismos en todas las vistas. draw() funciona en cualquier
+     * contexto que comparta objetos con el de upload(): el VBO/EBO, la textura
+     * y los shaders son compartidos; el VAO no, así que se crea uno por
+     * contexto (GLState identifica el contexto, ver GLState::makeCurrent) y
+     * un fence ordena la subida antes del primer draw de otro contexto.
+     */
     class Renderer2D
     {
     public:
+        // Destino de draw(): región del lienzo y grupos que se ven
+        struct View
+        {
+            glm::vec4 region = glm::vec4(0.0f); // x, y, ancho, alto en coordenadas del HUD (ancho 0 = todo)
+            GLuint mask = ~0u;
+        };
+
+        struct Stats
+        {
+            size_t commands = 0;  // comandos grabados (cortes de batch)
+            size_t drawCalls = 0; // después de ordenar y fusionar
+            size_t vertices = 0;
+            size_t indices = 0;
+        };
+
         Renderer2D();
         ~Renderer2D();
 
@@ -37,32 +110,187 @@ namespace gfx
         void end();
         void flush();
 
+        // flush() en dos partes (ver Vistas): upload() ordena y sube lo
+        // grabado; draw() lo dibuja en el contexto y viewport actuales, tantas
+        // veces como vistas haya, hasta el próximo upload()
+        void upload();
+        void draw(const View &view);
+        // VAO del contexto actual: attachContext() al crear un contexto que va a
+        // dibujar (así la primera subida ya lleva fence; si no, se crea en el
+        // primer draw), releaseContext() antes de destruirlo
+        void attachContext();
+        void releaseContext();
+
+        // Ordena y fusiona los comandos grabados sin tocar GL (flush() lo
+        // llama; público para medirlo sin contexto, ver --bench hud2d)
+        void buildDrawList();
+        const Stats &stats() const { return stats_; } // del último buildDrawList/flush
+
+        // Concatena lo grabado en arena (ver arriba); arena queda lista para begin()
+        void append(Renderer2D &arena);
+
+        // Estado de los comandos siguientes
+        void setLayer(int layer);
+        void setBlendMode(BlendMode mode);
+        void setViewBits(GLuint bits); // grupos de lo que sigue (en el vértice: no corta el batch)
+
         // Primitivas básicas
         void drawLine(const glm::vec2 &start, const glm::vec2 &end, const glm::vec4 &color, float thickness = 1.0f);
         void drawRect(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color, bool filled = true);
         void drawCircle(const glm::vec2 &center, float radius, const glm::vec4 &color, int segments = 32, bool filled = true);
         void drawArc(const glm::vec2 &center, float radius, float startAngle, float endAngle, const glm::vec4 &color, int segments = 32);
 
+        // Imagen (ícono, glifo de un atlas): textura GL_TEXTURE_2D modulada por tint
+        void drawImage(const glm::vec2 &position, const glm::vec2 &size, GLuint texture,
+                       const glm::vec2 &uvMin = glm::vec2(0.0f), const glm::vec2 &uvMax = glm::vec2(1.0f),
+                       const glm::vec4 &tint = glm::vec4(1.0f));
+
+        // Quad pintado por un shader propio (p. ej. el horizonte artificial).
+        // El shader usa hud.vert: recibe uv en vTexCoord, color en vColor y
+        // params en el uniform vec4 uParams (más uProjection/uTexture/vClip
+        // como hud.frag). Quads con el mismo shader y params se fusionan
+        void drawShaderQuad(const glm::vec2 &position, const glm::vec2 &size, const Shader &shader,
+                            const glm::vec4 &params, const glm::vec2 &uvMin, const glm::vec2 &uvMax,
+                            const glm::vec4 &color);
+
         // Formas específicas para instrumentos
         void drawTick(const glm::vec2 &center, float angle, float innerRadius, float outerRadius, const glm::vec4 &color, float thickness = 1.0f);
         void drawScale(const glm::vec2 &center, float radius, float startAngle, float endAngle, int numTicks, const glm::vec4 &color);
 
+        // Recorte (ver arriba); las pilas deben quedar balanceadas antes de end()
+        void pushClipRect(const glm::vec2 &position, const glm::vec2 &size);
+        void popClipRect();
+        void beginClipMask();
+        void endClipMask();
+        void popClipMask();
+
     private:
+        enum class CommandType
+        {
+            Draw,      // color, con test de stencil == nivel
+            MaskWrite, // sin color: incrementa el stencil dentro del nivel
+            MaskErase  // sin color: deshace un MaskWrite (misma geometría)
+        };
+
+        // Clave de estado GL: dos comandos con el mismo estado se fusionan
+        struct DrawState
+        {
+            CommandType type = CommandType::Draw;
+            int stencilLevel = 0; // máscaras activas: se dibuja donde stencil == nivel
+            BlendMode blend = BlendMode::Alpha;
+            GLuint texture = 0;
+            const Shader *shader = nullptr; // nullptr = shader_ (hud.frag)
+            glm::vec4 params = glm::vec4(0.0f); // uParams del shader propio
+
+            bool operator==(const DrawState &o) const
+            {
+                return type == o.type && stencilLevel == o.stencilLevel && blend == o.blend && texture == o.texture &&
+                       shader == o.shader && params == o.params;
+            }
+            bool operator!=(const DrawState &o) const { return !(*this == o); }
+        };
+
+        struct Command
+        {
+            DrawState state;
+            int layer = 0;
+            int scope = -1; // máscara de primer nivel que lo contiene (-1 = ninguna)
+            GLuint firstIndex = 0;
+            GLuint indexCount = 0; // se cierra al cortar el batch
+        };
+
+        // Máscara de primer nivel con todo lo que contiene: se ordena como un bloque
+        struct Scope
+        {
+            size_t firstCommand = 0, endCommand = 0;
+            int layer = 0;
+            bool nested = false; // con máscaras anidadas no se fusiona con otras
+            glm::vec4 maskBounds = glm::vec4(1e9f, 1e9f, -1e9f, -1e9f);    // caja de la máscara
+            glm::vec4 contentBounds = glm::vec4(1e9f, 1e9f, -1e9f, -1e9f); // caja de lo enmascarado
+        };
+
+        // Geometría de una máscara abierta (rango de índices para el pop)
+        struct MaskRange
+        {
+            GLuint firstIndex, indexCount;
+            int stencilLevel; // nivel de afuera
+        };
+
+        struct DrawCall
+        {
+            DrawState state;
+            GLuint firstIndex, indexCount;
+        };
+
+        // VAO por contexto sobre el mismo VBO/EBO (vao_ es el del contexto de init())
+        struct ContextVao
+        {
+            const GLState *context;
+            GLuint vao;
+            std::uint64_t upload; // última subida que vio (reenganchar buffers y esperar el fence)
+        };
+
         GLuint vao_, vbo_, ebo_;
+        std::vector<ContextVao> contexts_;
+        const GLState *uploadContext_ = nullptr;
+        GLsync uploadFence_ = nullptr; // sólo con más de un contexto
+        std::uint64_t uploads_ = 0;
+        bool uploadedMasks_ = false; // lo subido usa stencil: draw() lo limpia
+        GLuint whiteTexture_ = 0; // 1×1 blanca: las primitivas sin textura comparten estado
         Shader shader_;
 
+        // Grabación
         std::vector<Vertex2D> vertices_;
         std::vector<GLuint> indices_;
+        std::vector<Command> commands_;
+        std::vector<Scope> scopes_;
+        bool batchBroken_ = true; // la próxima primitiva abre un comando
+
+        // Estado actual
+        int layer_ = 0;
+        BlendMode blend_ = BlendMode::Alpha;
+        GLuint texture_ = 0;
+        const Shader *customShader_ = nullptr;
+        glm::vec4 shaderParams_ = glm::vec4(0.0f);
+        glm::vec4 clipRect_ = Vertex2D{}.clipRect;
+        GLuint viewBits_ = ~0u;
+        std::vector<glm::vec4> clipStack_;
+        std::vector<MaskRange> maskStack_;
+        bool definingMask_ = false;
+        int stencilLevel_ = 0;
+        int openScope_ = -1;
+
+        // Lista ordenada (buildDrawList)
+        std::vector<GLuint> drawIndices_;
+        std::vector<DrawCall> drawCalls_;
+        std::vector<size_t> order_; // scratch del ordenamiento
+        Stats stats_;
 
         glm::mat4 projection_;
+        glm::mat4 viewProjection_; // de la vista del draw() en curso
+        GLuint viewMask_ = ~0u;
         int screenWidth_, screenHeight_;
 
+        // Capacidad inicial de los buffers de GPU (crecen si un frame no entra)
         static const size_t MAX_VERTICES = 10000;
         static const size_t MAX_INDICES = 15000;
+        size_t vertexCapacity_ = MAX_VERTICES;
+        size_t indexCapacity_ = MAX_INDICES;
 
         void addVertex(const Vertex2D &vertex);
         void addQuad(const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color);
+        void setTexture(GLuint texture);
+        void setShader(const Shader *shader, const glm::vec4 &params);
+        static bool lessState(const DrawState &x, const DrawState &y);
+        void breakBatch();
+        void closeCommand();
+        void closeRecording();
+        void emit(const Command &command);
+        void emitScopes(const std::vector<size_t> &group, bool keepStencil);
+        void applyState(const DrawState &state);
         void setupBuffers();
+        void attachBuffers(); // VBO/EBO y atributos en el VAO bindeado
+        ContextVao &contextVao();
     };
 
 } // namespace gfx
@@ -52,6 +52,20 @@ void Shader::setVec3(const char* name, const glm::vec3& v) const {
     }
 }
 
+void Shader::setUint(const char* name, GLuint v) const {
+    GLint location = glGetUniformLocation(prog_, name);
+    if (location != -1) {
+        glUniform1ui(location, v);
+    }
+}
+
+void Shader::setVec4(const char* name, const glm::vec4& v) const {
+    GLint location = glGetUniformLocation(prog_, name);
+    if (location != -1) {
+        glUniform4fv(location, 1, glm::value_ptr(v));
+    }
+}
+
 std::string Shader::readFile(const char* path) {
     std::ifstream file;
     file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
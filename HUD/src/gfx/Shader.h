@@ -11,15 +11,15 @@ extern "C" {
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "GLState.h"
+
 namespace gfx {
 
 class Shader {
 public:
     Shader() = default;
     Shader(const char* vsPath, const char* fsPath) { load(vsPath, fsPath); }
-    ~Shader() { 
-        if (prog_) glDeleteProgram(prog_); 
-    }
+    ~Shader() { release(); }
 
     // No permitir copia, solo movimiento
     Shader(const Shader&) = delete;
@@ -27,7 +27,7 @@ public:
     Shader(Shader&& other) noexcept : prog_(other.prog_) { other.prog_ = 0; }
     Shader& operator=(Shader&& other) noexcept {
         if (this != &other) {
-            if (prog_) glDeleteProgram(prog_);
+            release();
             prog_ = other.prog_;
             other.prog_ = 0;
         }
@@ -35,17 +35,27 @@ public:
     }
 
     void load(const char* vsPath, const char* fsPath);
-    void use() const { glUseProgram(prog_); }
+    void use() const { GLState::current().useProgram(prog_); }
     GLuint id() const { return prog_; }
 
     // Setters para uniformes
     void setMat4(const char* name, const glm::mat4& m) const;
     void setInt(const char* name, int v) const;
+    void setUint(const char* name, GLuint v) const;
     void setFloat(const char* name, float v) const;
     void setVec3(const char* name, const glm::vec3& v) const;
+    void setVec4(const char* name, const glm::vec4& v) const;
 
 private:
     GLuint prog_ = 0;
+
+    void release() {
+        if (prog_) {
+            GLState::current().forgetProgram(prog_);
+            glDeleteProgram(prog_);
+            prog_ = 0;
+        }
+    }
     
     std::string readFile(const char* path);
     GLuint compileShader(const std::string& source, GLenum type);
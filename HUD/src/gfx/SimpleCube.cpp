@@ -1,5 +1,6 @@
 #include "SimpleCube.h"
 #include "GLCheck.h"
+#include "GLState.h"
 #include <glm/gtc/type_ptr.hpp>
 
 namespace gfx {
@@ -58,7 +59,10 @@ static const float CUBE_VERTICES[] = {
 
 SimpleCube::~SimpleCube() {
     if (vbo_) glDeleteBuffers(1, &vbo_);
-    if (vao_) glDeleteVertexArrays(1, &vao_);
+    if (vao_) {
+        GLState::current().forgetVertexArray(vao_);
+        glDeleteVertexArrays(1, &vao_);
+    }
 }
 
 void SimpleCube::init() {
@@ -77,7 +81,7 @@ void SimpleCube::createGeometry() {
     glGenVertexArrays(1, &vao_);
     glGenBuffers(1, &vbo_);
     
-    glBindVertexArray(vao_);
+    GLState::current().bindVertexArray(vao_);
     
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferData(GL_ARRAY_BUFFER, sizeof(CUBE_VERTICES), CUBE_VERTICES, GL_STATIC_DRAW);
@@ -90,7 +94,7 @@ void SimpleCube::createGeometry() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    GLState::current().bindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     
     checkGLError("Creating cube geometry");
@@ -108,9 +112,8 @@ void SimpleCube::draw(const glm::mat4& view, const glm::mat4& proj, const glm::v
     shader_.setMat4("uView", view);
     shader_.setMat4("uProj", proj);
     
-    glBindVertexArray(vao_);
+    GLState::current().bindVertexArray(vao_);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
 }
 
 } // namespace gfx
@@ -17,6 +17,8 @@ public:
     void init();
     void draw(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& position = glm::vec3(0.0f));
 
+    GLuint programId() const { return shader_.id(); }
+
 private:
     GLuint vao_ = 0, vbo_ = 0;
     Shader shader_;
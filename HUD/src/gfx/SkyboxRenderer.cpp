@@ -1,70 +1,40 @@
 #include "SkyboxRenderer.h"
 #include "GLCheck.h"
-#include <array>
+#include "GLState.h"
 #include <glm/gtc/type_ptr.hpp>
 
 namespace gfx {
 
-// Geometría del cubo para skybox (36 vértices, solo posiciones)
+// Cubo del skybox anterior (36 vértices, solo posiciones): para measureCubePath
 static const float CUBE_VERTICES[108] = {
-    // Cara trasera (Z-)
-    -1.0f, -1.0f, -1.0f,
-     1.0f, -1.0f, -1.0f,
-     1.0f,  1.0f, -1.0f,
-    -1.0f, -1.0f, -1.0f,
-     1.0f,  1.0f, -1.0f,
-    -1.0f,  1.0f, -1.0f,
-
-    // Cara frontal (Z+)
-    -1.0f, -1.0f,  1.0f,
-     1.0f, -1.0f,  1.0f,
-     1.0f,  1.0f,  1.0f,
-    -1.0f, -1.0f,  1.0f,
-     1.0f,  1.0f,  1.0f,
-    -1.0f,  1.0f,  1.0f,
-
-    // Cara izquierda (X-)
-    -1.0f, -1.0f, -1.0f,
-    -1.0f,  1.0f, -1.0f,
-    -1.0f,  1.0f,  1.0f,
-    -1.0f, -1.0f, -1.0f,
-    -1.0f,  1.0f,  1.0f,
-    -1.0f, -1.0f,  1.0f,
-
-    // Cara derecha (X+)
-     1.0f, -1.0f, -1.0f,
-     1.0f,  1.0f, -1.0f,
-     1.0f,  1.0f,  1.0f,
-     1.0f, -1.0f, -1.0f,
-     1.0f,  1.0f,  1.0f,
-     1.0f, -1.0f,  1.0f,
-
-    // Cara inferior (Y-)
-    -1.0f, -1.0f, -1.0f,
-    -1.0f, -1.0f,  1.0f,
-     1.0f, -1.0f,  1.0f,
-    -1.0f, -1.0f, -1.0f,
-     1.0f, -1.0f,  1.0f,
-     1.0f, -1.0f, -1.0f,
-
-    // Cara superior (Y+)
-    -1.0f,  1.0f, -1.0f,
-    -1.0f,  1.0f,  1.0f,
-     1.0f,  1.0f,  1.0f,
-    -1.0f,  1.0f, -1.0f,
-     1.0f,  1.0f,  1.0f,
-     1.0f,  1.0f, -1.0f
+    -1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,   1.0f,  1.0f, -1.0f, // Z-
+    -1.0f, -1.0f, -1.0f,   1.0f,  1.0f, -1.0f,  -1.0f,  1.0f, -1.0f,
+    -1.0f, -1.0f,  1.0f,   1.0f, -1.0f,  1.0f,   1.0f,  1.0f,  1.0f, // Z+
+    -1.0f, -1.0f,  1.0f,   1.0f,  1.0f,  1.0f,  -1.0f,  1.0f,  1.0f,
+    -1.0f, -1.0f, -1.0f,  -1.0f,  1.0f, -1.0f,  -1.0f,  1.0f,  1.0f, // X-
+    -1.0f, -1.0f, -1.0f,  -1.0f,  1.0f,  1.0f,  -1.0f, -1.0f,  1.0f,
+     1.0f, -1.0f, -1.0f,   1.0f,  1.0f, -1.0f,   1.0f,  1.0f,  1.0f, // X+
+     1.0f, -1.0f, -1.0f,   1.0f,  1.0f,  1.0f,   1.0f, -1.0f,  1.0f,
+    -1.0f, -1.0f, -1.0f,  -1.0f, -1.0f,  1.0f,   1.0f, -1.0f,  1.0f, // Y-
+    -1.0f, -1.0f, -1.0f,   1.0f, -1.0f,  1.0f,   1.0f, -1.0f, -1.0f,
+    -1.0f,  1.0f, -1.0f,  -1.0f,  1.0f,  1.0f,   1.0f,  1.0f,  1.0f, // Y+
+    -1.0f,  1.0f, -1.0f,   1.0f,  1.0f,  1.0f,   1.0f,  1.0f, -1.0f
 };
 
 SkyboxRenderer::~SkyboxRenderer() {
-    if (vbo_) glDeleteBuffers(1, &vbo_);
-    if (vao_) glDeleteVertexArrays(1, &vao_);
+    if (queries_[0]) glDeleteQueries(2, queries_);
+    if (vao_) {
+        GLState::current().forgetVertexArray(vao_);
+        glDeleteVertexArrays(1, &vao_);
+    }
 }
 
 void SkyboxRenderer::init() {
-    // Crear geometría del cubo
-    createCubeGeometry();
-    
+    // El triángulo se genera con gl_VertexID: solo hace falta un VAO vacío
+    glGenVertexArrays(1, &vao_);
+    glGenQueries(2, queries_);
+    checkGLError("Creating skybox VAO/queries");
+
     // Cargar shaders
     try {
         shader_.load("shaders/skybox.vert", "shaders/skybox.frag");
@@ -76,25 +46,12 @@ void SkyboxRenderer::init() {
     }
 }
 
-void SkyboxRenderer::createCubeGeometry() {
-    // Generar VAO y VBO
-    glGenVertexArrays(1, &vao_);
-    glGenBuffers(1, &vbo_);
-    
-    glBindVertexArray(vao_);
-    
-    // Subir datos del cubo
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(CUBE_VERTICES), CUBE_VERTICES, GL_STATIC_DRAW);
-    
-    // Configurar atributos de vértice (solo posición)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    
-    checkGLError("Creating skybox geometry");
+void SkyboxRenderer::readQueryResult(GLuint query) {
+    GLuint available = 0;
+    glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available) {
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT, &samplesPassed_);
+    }
 }
 
 void SkyboxRenderer::draw(const glm::mat4& view, const glm::mat4& proj) {
@@ -102,30 +59,94 @@ void SkyboxRenderer::draw(const glm::mat4& view, const glm::mat4& proj) {
         std::cerr << "No cubemap texture set for skybox" << std::endl;
         return;
     }
-    
-    // Cambiar función de profundidad para skybox
-    glDepthFunc(GL_LEQUAL);
-    
+
+    // Profundidad 1.0 pasa solo donde el depth buffer sigue limpio.
+    // El cielo no necesita escribir profundidad.
+    GLState& gl = GLState::current();
+    gl.depthFunc(GL_LEQUAL);
+    gl.depthMask(GL_FALSE);
+
     shader_.use();
-    
+
     // Eliminar traslación de la matriz de vista (mantener solo rotación)
     glm::mat4 viewNoTranslation = glm::mat4(glm::mat3(view));
-    
+    glm::mat4 invViewProj = glm::inverse(proj * viewNoTranslation);
+
     // Establecer uniformes
-    shader_.setMat4("uView", viewNoTranslation);
-    shader_.setMat4("uProj", proj);
+    shader_.setMat4("uInvViewProj", invViewProj);
     shader_.setInt("uCube", 0);
-    
+
     // Bindear textura del cubemap
     cube_->bindUnit(0);
-    
-    // Dibujar cubo
-    glBindVertexArray(vao_);
+
+    // Query del frame actual; se lee la del anterior (ya terminada o casi)
+    GLuint query = queries_[queryFrame_ & 1];
+    if (queryEnabled_) {
+        if (queryFrame_ > 0) readQueryResult(queries_[(queryFrame_ + 1) & 1]);
+        glBeginQuery(GL_SAMPLES_PASSED, query);
+    }
+
+    // Dibujar triángulo de pantalla completa
+    gl.bindVertexArray(vao_);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    if (queryEnabled_) {
+        glEndQuery(GL_SAMPLES_PASSED);
+        ++queryFrame_;
+    }
+
+    // Restaurar estado de profundidad
+    gl.depthMask(GL_TRUE);
+    gl.depthFunc(GL_LESS);
+}
+
+GLuint SkyboxRenderer::measureCubePath(const glm::mat4& view, const glm::mat4& proj) {
+    if (!cube_) return 0;
+
+    Shader cubeShader;
+    try {
+        cubeShader.load("shaders/skybox_cube.vert", "shaders/skybox.frag");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to load cube skybox shaders: " << e.what() << std::endl;
+        return 0;
+    }
+
+    GLuint vao = 0, vbo = 0, query = 0;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenQueries(1, &query);
+
+    GLState& gl = GLState::current();
+    gl.bindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(CUBE_VERTICES), CUBE_VERTICES, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Como se dibujaba antes: primero, con el depth buffer limpio en 1.0
+    gl.depthFunc(GL_LEQUAL);
+    cubeShader.use();
+    cubeShader.setMat4("uView", glm::mat4(glm::mat3(view)));
+    cubeShader.setMat4("uProj", proj);
+    cubeShader.setInt("uCube", 0);
+    cube_->bindUnit(0);
+
+    glBeginQuery(GL_SAMPLES_PASSED, query);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
-    
-    // Restaurar función de profundidad
-    glDepthFunc(GL_LESS);
+    glEndQuery(GL_SAMPLES_PASSED);
+    gl.depthFunc(GL_LESS);
+
+    GLuint samples = 0;
+    glGetQueryObjectuiv(query, GL_QUERY_RESULT, &samples); // bloquea: una sola vez
+    checkGLError("Measuring cube skybox");
+
+    glDeleteQueries(1, &query);
+    glDeleteBuffers(1, &vbo);
+    gl.forgetVertexArray(vao);
+    glDeleteVertexArrays(1, &vao);
+    return samples;
 }
 
 } // namespace gfx
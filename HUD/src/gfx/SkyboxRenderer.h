@@ -6,6 +6,17 @@
 
 namespace gfx {
 
+/**
+ * Skybox como triángulo de pantalla completa.
+ *
+ * Se dibuja DESPUÉS de la geometría opaca: el vertex shader reconstruye el rayo
+ * de vista con la inversa de viewProj y fija la profundidad en 1.0, así el test
+ * de profundidad (GL_LEQUAL) descarta antes del fragment shader todos los píxeles
+ * ya cubiertos por terreno/objetos. Solo se sombrea el cielo visible.
+ *
+ * Opcionalmente mide con occlusion queries (GL_SAMPLES_PASSED) cuántos
+ * fragmentos sombrea realmente; measureCubePath mide igual el cubo anterior.
+ */
 class SkyboxRenderer {
 public:
     SkyboxRenderer() = default;
@@ -14,22 +25,44 @@ public:
     // No permitir copia, solo movimiento
     SkyboxRenderer(const SkyboxRenderer&) = delete;
     SkyboxRenderer& operator=(const SkyboxRenderer&) = delete;
-    SkyboxRenderer(SkyboxRenderer&& other) noexcept 
-        : vao_(other.vao_), vbo_(other.vbo_), shader_(std::move(other.shader_)), cube_(other.cube_) {
-        other.vao_ = other.vbo_ = 0;
+    SkyboxRenderer(SkyboxRenderer&& other) noexcept
+        : vao_(other.vao_), shader_(std::move(other.shader_)), cube_(other.cube_),
+          queries_{other.queries_[0], other.queries_[1]}, queryFrame_(other.queryFrame_),
+          queryEnabled_(other.queryEnabled_), samplesPassed_(other.samplesPassed_) {
+        other.vao_ = 0;
+        other.queries_[0] = other.queries_[1] = 0;
         other.cube_ = nullptr;
     }
 
-    void init();                              // crea VAO/VBO, shader
+    void init();                              // crea VAO vacío, shader
     void setCubemap(TextureCube* tex) { cube_ = tex; }
+    GLuint programId() const { return shader_.id(); }
+
+    // Llamar después de dibujar toda la geometría opaca (depth buffer ya lleno)
     void draw(const glm::mat4& view, const glm::mat4& proj);
 
+    // Conteo de fragmentos sombreados por el skybox (occlusion query)
+    void setOcclusionQueryEnabled(bool enabled) { queryEnabled_ = enabled; }
+    // Resultado de la última query disponible (1 frame de retraso, sin bloquear)
+    GLuint lastSamplesPassed() const { return samplesPassed_; }
+
+    // Camino anterior, una vez: cubo de 36 vértices dibujado ANTES de la geometría
+    // (GL_LEQUAL) bajo la misma query. Llamar con el depth buffer recién limpiado;
+    // espera el resultado y libera todo (para reportes, no para cada frame).
+    GLuint measureCubePath(const glm::mat4& view, const glm::mat4& proj);
+
 private:
-    GLuint vao_ = 0, vbo_ = 0;
+    GLuint vao_ = 0; // VAO vacío: el core profile exige uno bindeado para dibujar
     Shader shader_;
     TextureCube* cube_ = nullptr;
-    
-    void createCubeGeometry();
+
+    // Doble buffer de queries: se lee la del frame anterior para no frenar la GPU
+    GLuint queries_[2] = {0, 0};
+    unsigned queryFrame_ = 0;
+    bool queryEnabled_ = false;
+    GLuint samplesPassed_ = 0;
+
+    void readQueryResult(GLuint query);
 };
 
 } // namespace gfx
@@ -1,4 +1,5 @@
 #include "TerrainMesh.h"
+#include "GLState.h"
 #include <iostream>
 
 namespace gfx {
@@ -66,7 +67,7 @@ void TerrainMesh::generateGrid(int N) {
     glGenBuffers(1, &vbo_);
     glGenBuffers(1, &ebo_);
     
-    glBindVertexArray(vao_);
+    GLState::current().bindVertexArray(vao_);
     
     // VBO
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
@@ -87,20 +88,23 @@ void TerrainMesh::generateGrid(int N) {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), 
                          (void*)(3 * sizeof(float)));
     
-    glBindVertexArray(0);
+    GLState::current().bindVertexArray(0);
     
     std::cout << "TerrainMesh created: " << vertexCount_ << " vertices, " 
               << indexCount_ << " indices" << std::endl;
 }
 
 void TerrainMesh::draw() {
-    glBindVertexArray(vao_);
+    // Sin desbindear: el próximo draw bindea su propio VAO si hace falta
+    GLState::current().bindVertexArray(vao_);
     glDrawElements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
 }
 
 void TerrainMesh::cleanup() {
-    if (vao_) glDeleteVertexArrays(1, &vao_);
+    if (vao_) {
+        GLState::current().forgetVertexArray(vao_);
+        glDeleteVertexArrays(1, &vao_);
+    }
     if (vbo_) glDeleteBuffers(1, &vbo_);
     if (ebo_) glDeleteBuffers(1, &ebo_);
     vao_ = vbo_ = ebo_ = 0;
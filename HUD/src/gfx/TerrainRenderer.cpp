@@ -1,4 +1,5 @@
 #include "TerrainRenderer.h"
+#include "GLState.h"
 #include <stb/stb_image.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -16,6 +17,7 @@ TerrainRenderer::~TerrainRenderer() {
 void TerrainRenderer::init() {
     // Compilar shaders
     shader_.load("shaders/terrain.vert", "shaders/terrain.frag");
+    depthShader_.load("shaders/terrain.vert", "shaders/depth.frag");
     
     // Generar mesh (grid 128x128)
     mesh_.init(128);
@@ -50,7 +52,7 @@ GLuint TerrainRenderer::loadTexture(const std::string& path, bool sRGB) {
         internalFormat = GL_RED;
     }
     
-    glBindTexture(GL_TEXTURE_2D, texID);
+    GLState::current().bindTexture(GL_TEXTURE_2D, texID);
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
     
@@ -91,21 +93,66 @@ void TerrainRenderer::loadTextures(const std::string& basePath) {
     std::cout << "Terrain textures loaded from: " << basePath << std::endl;
 }
 
-void TerrainRenderer::draw(const glm::mat4& view, const glm::mat4& projection, 
-                           const glm::vec3& cameraPos, const TerrainParams& params) {
-    shader_.use();
-    
+void TerrainRenderer::setHeightmap(const std::vector<float>& samples, int samplesPerSide, float spacing) {
+    if (samplesPerSide < 2 || samples.size() != static_cast<size_t>(samplesPerSide) * samplesPerSide) {
+        std::cerr << "Invalid terrain heightmap (" << samples.size() << " samples, " << samplesPerSide << " per side)" << std::endl;
+        return;
+    }
+    if (!heightTex_) glGenTextures(1, &heightTex_);
+
+    GLState::current().bindTexture(GL_TEXTURE_2D, heightTex_);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, samplesPerSide, samplesPerSide, 0, GL_RED, GL_FLOAT, samples.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Muestra i en x = i·spacing − half, centro del texel i en (i + 0.5)/N:
+    // el filtrado bilineal reproduce Heightfield::height() (con la precisión del hardware)
+    const float n = static_cast<float>(samplesPerSide);
+    const float half = 0.5f * (n - 1.0f) * spacing;
+    heightScaleBias_ = glm::vec2(1.0f / (spacing * n), (half / spacing + 0.5f) / n);
+    heightSpacing_ = spacing;
+
+    std::cout << "Terrain heightmap: " << samplesPerSide << "x" << samplesPerSide
+              << " samples, " << spacing << " m spacing" << std::endl;
+}
+
+void TerrainRenderer::bindHeightmap(Shader& shader) {
+    GLState::current().bindTextureUnit(5, GL_TEXTURE_2D, heightTex_);
+    shader.setInt("uHeightmap", 5);
+    shader.setFloat("uHeightScale", heightScaleBias_.x);
+    shader.setFloat("uHeightBias", heightScaleBias_.y);
+    shader.setFloat("uHeightSpacing", heightTex_ ? heightSpacing_ : 0.0f);
+}
+
+glm::vec3 TerrainRenderer::gridOffset(const glm::vec3& cameraPos, const TerrainParams& params) {
     // Floating origin: snap camera position to grid
     const float snapStep = 32.0f;
     glm::vec2 snap = glm::floor(glm::vec2(cameraPos.x, cameraPos.z) / snapStep) * snapStep;
-    glm::vec3 gridOffset = glm::vec3(snap.x, params.groundY, snap.y);
+    return glm::vec3(snap.x, params.groundY, snap.y);
+}
+
+void TerrainRenderer::drawDepthOnly(const glm::mat4& view, const glm::mat4& projection,
+                                    const glm::vec3& cameraPos, const TerrainParams& params) {
+    depthShader_.use();
+    depthShader_.setMat4("uViewProj", projection * view);
+    depthShader_.setVec3("uGridOffset", gridOffset(cameraPos, params));
+    bindHeightmap(depthShader_);
+    mesh_.draw();
+}
+
+void TerrainRenderer::draw(const glm::mat4& view, const glm::mat4& projection, 
+                           const glm::vec3& cameraPos, const TerrainParams& params) {
+    shader_.use();
     
     // ViewProj matrix
     glm::mat4 viewProj = projection * view;
     
     // Set uniforms usando los helpers de Shader
     shader_.setMat4("uViewProj", viewProj);
-    shader_.setVec3("uGridOffset", gridOffset);
+    shader_.setVec3("uGridOffset", gridOffset(cameraPos, params));
     shader_.setVec3("uCamPos", cameraPos);
     shader_.setVec3("uColorTint", params.colorTint);
     shader_.setFloat("uTileMacro", params.tileScaleMacro);
@@ -113,41 +160,40 @@ void TerrainRenderer::draw(const glm::mat4& view, const glm::mat4& projection,
     shader_.setFloat("uDetailStr", params.detailStrength);
     shader_.setFloat("uFogDensity", params.fogDensity);
     
-    // Bind textures
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, albedoTex_);
+    // Bind textures (GLState omite las que ya están en su unidad)
+    GLState& gl = GLState::current();
+    gl.bindTextureUnit(0, GL_TEXTURE_2D, albedoTex_);
     shader_.setInt("uAlbedo", 0);
     
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, normalTex_);
+    gl.bindTextureUnit(1, GL_TEXTURE_2D, normalTex_);
     shader_.setInt("uNormal", 1);
     
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, roughTex_);
+    gl.bindTextureUnit(2, GL_TEXTURE_2D, roughTex_);
     shader_.setInt("uRough", 2);
     
-    glActiveTexture(GL_TEXTURE3);
-    glBindTexture(GL_TEXTURE_2D, detailAlbedoTex_);
+    gl.bindTextureUnit(3, GL_TEXTURE_2D, detailAlbedoTex_);
     shader_.setInt("uDetailAlbedo", 3);
     
-    glActiveTexture(GL_TEXTURE4);
-    glBindTexture(GL_TEXTURE_2D, detailNormalTex_);
+    gl.bindTextureUnit(4, GL_TEXTURE_2D, detailNormalTex_);
     shader_.setInt("uDetailNormal", 4);
+
+    bindHeightmap(shader_);
     
     // Draw mesh
     mesh_.draw();
-    
-    // Unbind
-    glActiveTexture(GL_TEXTURE0);
 }
 
 void TerrainRenderer::cleanup() {
+    GLState& gl = GLState::current();
+    for (GLuint tex : {albedoTex_, normalTex_, roughTex_, heightTex_}) gl.forgetTexture(tex);
+
     if (albedoTex_) glDeleteTextures(1, &albedoTex_);
+    if (heightTex_) glDeleteTextures(1, &heightTex_);
     if (normalTex_) glDeleteTextures(1, &normalTex_);
     if (roughTex_) glDeleteTextures(1, &roughTex_);
     // detailAlbedo y detailNormal son aliases, no borrar dos veces
     
-    albedoTex_ = normalTex_ = roughTex_ = 0;
+    albedoTex_ = normalTex_ = roughTex_ = heightTex_ = 0;
     detailAlbedoTex_ = detailNormalTex_ = 0;
     
     mesh_.cleanup();
@@ -1,6 +1,7 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
 #include "Shader.h"
 #include "TerrainMesh.h"
 
@@ -26,12 +27,23 @@ public:
     
     void init();
     void loadTextures(const std::string& basePath);
+    // Relieve: muestras [z][x] de una grilla centrada en el origen (vacío = plano)
+    void setHeightmap(const std::vector<float>& samples, int samplesPerSide, float spacing);
     void draw(const glm::mat4& view, const glm::mat4& projection, 
               const glm::vec3& cameraPos, const TerrainParams& params);
+    // Pre-pass: misma geometría, fragment shader vacío (solo depth)
+    void drawDepthOnly(const glm::mat4& view, const glm::mat4& projection,
+                       const glm::vec3& cameraPos, const TerrainParams& params);
     void cleanup();
+
+    // Claves de ordenamiento para la RenderQueue
+    GLuint programId() const { return shader_.id(); }
+    GLuint depthProgramId() const { return depthShader_.id(); }
+    GLuint albedoTexture() const { return albedoTex_; }
     
 private:
     Shader shader_;
+    Shader depthShader_;
     TerrainMesh mesh_;
     
     GLuint albedoTex_ = 0;
@@ -39,8 +51,13 @@ private:
     GLuint roughTex_ = 0;
     GLuint detailAlbedoTex_ = 0;
     GLuint detailNormalTex_ = 0;
+    GLuint heightTex_ = 0;          // GL_R32F, una muestra por texel
+    glm::vec2 heightScaleBias_ = glm::vec2(0.0f); // uv = xz * x + y
+    float heightSpacing_ = 0.0f;    // m entre muestras (0 = sin relieve)
     
     GLuint loadTexture(const std::string& path, bool sRGB = false);
+    void bindHeightmap(Shader& shader);
+    static glm::vec3 gridOffset(const glm::vec3& cameraPos, const TerrainParams& params);
 };
 
 } // namespace gfx
@@ -62,7 +62,7 @@ bool TextureCube::loadCubeFaces(const util::CubeFaces& faces) {
         glGenTextures(1, &id_);
     }
     
-    glBindTexture(GL_TEXTURE_CUBE_MAP, id_);
+    GLState::current().bindTexture(GL_TEXTURE_CUBE_MAP, id_);
     
     // Configurar parámetros
     setupParameters();
@@ -97,7 +97,6 @@ bool TextureCube::loadCubeFaces(const util::CubeFaces& faces) {
         checkGLError(("Loading cube face " + std::to_string(i)).c_str());
     }
     
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
     return true;
 }
 
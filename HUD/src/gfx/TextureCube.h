@@ -7,15 +7,14 @@ extern "C" {
 }
 
 #include "../util/ImageAtlas.h"
+#include "GLState.h"
 
 namespace gfx {
 
 class TextureCube {
 public:
     TextureCube() = default;
-    ~TextureCube() { 
-        if (id_) glDeleteTextures(1, &id_); 
-    }
+    ~TextureCube() { release(); }
 
     // No permitir copia, solo movimiento
     TextureCube(const TextureCube&) = delete;
@@ -23,7 +22,7 @@ public:
     TextureCube(TextureCube&& other) noexcept : id_(other.id_) { other.id_ = 0; }
     TextureCube& operator=(TextureCube&& other) noexcept {
         if (this != &other) {
-            if (id_) glDeleteTextures(1, &id_);
+            release();
             id_ = other.id_;
             other.id_ = 0;
         }
@@ -36,18 +35,27 @@ public:
     // Carga desde 6 archivos individuales
     bool loadFromFiles(const std::array<std::string, 6>& paths, bool flipY = false);
 
-    void bind() const { glBindTexture(GL_TEXTURE_CUBE_MAP, id_); }
+    // Carga desde caras ya separadas (lo que usan las dos anteriores)
+    bool loadCubeFaces(const util::CubeFaces& faces);
+
+    void bind() const { GLState::current().bindTexture(GL_TEXTURE_CUBE_MAP, id_); }
     void bindUnit(GLuint unit) const { 
-        glActiveTexture(GL_TEXTURE0 + unit);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, id_); 
+        GLState::current().bindTextureUnit(unit, GL_TEXTURE_CUBE_MAP, id_);
     }
     GLuint id() const { return id_; }
 
 private:
     GLuint id_ = 0;
+
+    void release() {
+        if (id_) {
+            GLState::current().forgetTexture(id_);
+            glDeleteTextures(1, &id_);
+            id_ = 0;
+        }
+    }
     
     void setupParameters();
-    bool loadCubeFaces(const util::CubeFaces& faces);
 };
 
 } // namespace gfx
@@ -1,4 +1,7 @@
 #include "Altimeter.h"
+#include "InstrumentRegistry.h"
+#include "../flight/InstrumentHistory.h"
+#include <algorithm>
 #include <cmath>
 
 namespace hud
@@ -8,7 +11,7 @@ namespace hud
     // ============================================================================
 
     // Espaciado entre marcas de altitud
-    static const float ALTITUDE_STEP = 100.0f;  // Marcas cada 100 pies
+    static constexpr flight::units::Feet ALTITUDE_STEP{100.0f}; // Marcas cada 100 pies
     static const float PIXELS_PER_STEP = 30.0f; // Separación vertical entre marcas
     static const int VISIBLE_MARKS = 12;        // Cuántas marcas mostrar arriba/abajo del centro
 
@@ -24,10 +27,37 @@ namespace hud
     static const float READOUT_BOX_WIDTH = 120.0f;
     static const float READOUT_BOX_HEIGHT = 44.0f;
 
+    // Caja del radioaltímetro (debajo del tape)
+    static const float RADAR_BOX_WIDTH = 70.0f;
+    static const float RADAR_BOX_HEIGHT = 24.0f;
+    static const float RADAR_BOX_GAP = 12.0f;
+
     // Flecha indicadora (chevron)
     static const float CHEVRON_WIDTH = 10.0f;
     static const float CHEVRON_HEIGHT = 12.0f;
 
+    // Flecha de tendencia
+    static const float TREND_SECONDS = 6.0f;    // horizonte de la predicción
+    static const float TREND_MIN_PIXELS = 6.0f; // más corta no se dibuja (20 ft)
+    static const float TREND_X = 8.0f;          // desde el borde derecho, junto a las marcas
+    static const float TREND_HEAD = 4.0f;
+
+    // Lectura de la caja: pies enteros, no negativa
+    static int readoutAltitude(flight::units::Feet altitude)
+    {
+        const int display = (int)round(altitude.value());
+        return display < 0 ? 0 : display;
+    }
+
+    // Como en los radioaltímetros reales: pasos de 10 ft arriba de 50 ft
+    static int readoutRadarAltitude(flight::units::Feet radarAltitude)
+    {
+        int display = (int)round(radarAltitude.value());
+        if (display > 50)
+            display = display / 10 * 10;
+        return display;
+    }
+
     Altimeter::Altimeter() : Instrument()
     {
         // Configuración específica del altímetro
@@ -41,11 +71,49 @@ namespace hud
 
     void Altimeter::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
     {
-        float altitude = flightData.altitude;
+        const flight::units::Feet altitude = flightData.altitude;
 
+        drawnTrend_ = trendPixels(flightData);
         drawBackground(renderer);
         drawAltitudeTape(renderer, altitude);
         drawCurrentAltitudeBox(renderer, altitude);
+
+        if (flightData.radarAltitudeValid)
+            drawRadarAltitude(renderer, flightData.radarAltitude);
+    }
+
+    bool Altimeter::sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const
+    {
+        // El tape se corre PIXELS_PER_STEP por ALTITUDE_STEP; la caja, por pie entero
+        const float tapeShift = std::abs(current.altitude.value() - drawn.altitude.value()) *
+                                PIXELS_PER_STEP / ALTITUDE_STEP.value();
+        if (tapeShift >= kSubpixelTolerance || readoutAltitude(current.altitude) != readoutAltitude(drawn.altitude))
+            return false;
+        if (current.radarAltitudeValid != drawn.radarAltitudeValid)
+            return false;
+        if (std::abs(trendPixels(current) - drawnTrend_) >= kSubpixelTolerance)
+            return false;
+        return !current.radarAltitudeValid ||
+               readoutRadarAltitude(current.radarAltitude) == readoutRadarAltitude(drawn.radarAltitude);
+    }
+
+    /**
+     * @brief Largo de la flecha de tendencia en px (hacia arriba positivo)
+     *
+     * Usa la derivada media de la altitud en la ventana de la historia (O(1):
+     * ya viene calculada en la muestra), no la velocidad vertical instantánea.
+     */
+    float Altimeter::trendPixels(const flight::FlightData &flightData) const
+    {
+        flight::TrendSample trend;
+        if (!flightData.history || !flightData.history->latest(trend))
+            return 0.0f;
+        const float feet = trend.rateOf(flight::TrendChannel::Altitude) * TREND_SECONDS;
+        const float pixels = feet * PIXELS_PER_STEP / ALTITUDE_STEP.value();
+        if (std::abs(pixels) < TREND_MIN_PIXELS)
+            return 0.0f;
+        const float limit = size_.y * 0.5f - TREND_HEAD;
+        return std::clamp(pixels, -limit, limit);
     }
 
     void Altimeter::drawBackground(gfx::Renderer2D &renderer)
@@ -149,7 +217,7 @@ namespace hud
     // RENDERIZADO DEL TAPE DE ALTITUD (ESCALA MÓVIL)
     // ============================================================================
 
-    void Altimeter::drawAltitudeTape(gfx::Renderer2D &renderer, float altitude)
+    void Altimeter::drawAltitudeTape(gfx::Renderer2D &renderer, flight::units::Feet altitude)
     {
         // Calcular posiciones de referencia
         float centerY = position_.y + size_.y * 0.5f; // Centro vertical del instrumento
@@ -157,32 +225,30 @@ namespace hud
 
         // Calcular el desplazamiento del tape basado en la altitud actual
         // Dividimos la altitud en parte entera (base) y fraccionaria
-        float baseAltitude = floor(altitude / ALTITUDE_STEP) * ALTITUDE_STEP; // Ej: 234 ft → 200 ft
+        flight::units::Feet baseAltitude = floor(altitude / ALTITUDE_STEP) * ALTITUDE_STEP; // Ej: 234 ft → 200 ft
         float fraction = (altitude - baseAltitude) / ALTITUDE_STEP;           // Ej: 34/100 = 0.34
         float scrollOffset = fraction * PIXELS_PER_STEP;                      // Desplazamiento en píxeles
 
-        // Dibujar marcas de altitud visibles
+        // Recorte en GPU: el tape queda dentro del instrumento (scissor) y fuera
+        // de la caja de lectura (máscara = franjas arriba y abajo de la caja)
+        const float boxTop = centerY - READOUT_BOX_HEIGHT * 0.5f;
+        const float boxBottom = centerY + READOUT_BOX_HEIGHT * 0.5f;
+        renderer.pushClipRect(position_, size_);
+        renderer.beginClipMask();
+        renderer.drawRect(position_, glm::vec2(size_.x, boxTop - position_.y), color_, true);
+        renderer.drawRect(glm::vec2(position_.x, boxBottom), glm::vec2(size_.x, position_.y + size_.y - boxBottom), color_, true);
+        renderer.endClipMask();
+
+        // Dibujar el tape completo: lo que cae fuera del área lo recorta la GPU
         for (int i = -VISIBLE_MARKS; i <= VISIBLE_MARKS; ++i)
         {
             // Calcular el valor de altitud para esta marca
-            int markAltitude = (int)baseAltitude + i * (int)ALTITUDE_STEP; // Ej: 0, 100, 200, 300...
+            int markAltitude = (int)baseAltitude.value() + i * (int)ALTITUDE_STEP.value(); // Ej: 0, 100, 200, 300...
 
             // Calcular posición Y de esta marca en pantalla
             // Cuando subes: scrollOffset aumenta → tape sube (valores mayores aparecen desde arriba)
             float markY = centerY + scrollOffset - i * PIXELS_PER_STEP;
 
-            // Saltar marcas fuera del área visible
-            const float CULLING_MARGIN = 30.0f;
-            if (markY < position_.y - CULLING_MARGIN || markY > position_.y + size_.y + CULLING_MARGIN)
-                continue;
-
-            // Verificar si está dentro del área de la caja de lectura
-            bool insideReadoutBox = (markY > centerY - READOUT_BOX_HEIGHT * 0.5f &&
-                                     markY < centerY + READOUT_BOX_HEIGHT * 0.5f);
-
-            if (insideReadoutBox)
-                continue; // Saltar marcas dentro de la caja
-
             // Dibujar el tick (línea horizontal)
             // NO usar floor() para evitar que múltiples marcas se redondeen al mismo píxel
             renderer.drawRect(
@@ -199,13 +265,28 @@ namespace hud
                 drawAltitudeNumber(renderer, markAltitude, numberPos);
             }
         }
+
+        // Tendencia: desde la referencia hasta la altitud en TREND_SECONDS
+        // (dentro de la máscara: la caja de lectura tapa el tramo inicial)
+        if (drawnTrend_ != 0.0f)
+        {
+            const float x = position_.x + size_.x - TREND_X;
+            const float tipY = centerY - drawnTrend_;
+            const float back = drawnTrend_ > 0.0f ? TREND_HEAD : -TREND_HEAD;
+            renderer.drawLine(glm::vec2(x, centerY), glm::vec2(x, tipY), color_, 2.0f);
+            renderer.drawLine(glm::vec2(x - TREND_HEAD, tipY + back), glm::vec2(x, tipY), color_, 2.0f);
+            renderer.drawLine(glm::vec2(x + TREND_HEAD, tipY + back), glm::vec2(x, tipY), color_, 2.0f);
+        }
+
+        renderer.popClipMask();
+        renderer.popClipRect();
     }
 
     // ============================================================================
     // CAJA DE LECTURA DIGITAL (CENTRO)
     // ============================================================================
 
-    void Altimeter::drawCurrentAltitudeBox(gfx::Renderer2D &renderer, float altitude)
+    void Altimeter::drawCurrentAltitudeBox(gfx::Renderer2D &renderer, flight::units::Feet altitude)
     {
         float centerY = position_.y + size_.y * 0.5f;
 
@@ -240,13 +321,29 @@ namespace hud
             color_, 2.0f);
 
         // Mostrar altitud actual redondeada (no negativa)
-        int displayAltitude = (int)round(altitude);
-        if (displayAltitude < 0)
-            displayAltitude = 0;
+        int displayAltitude = readoutAltitude(altitude);
 
         // Dibujar el número centrado dentro de la caja
         glm::vec2 numberPos = glm::vec2(boxX + READOUT_BOX_WIDTH * 0.5f, centerY);
         drawAltitudeNumber(renderer, displayAltitude, numberPos);
     }
 
+    // ============================================================================
+    // RADIOALTÍMETRO
+    // ============================================================================
+
+    void Altimeter::drawRadarAltitude(gfx::Renderer2D &renderer, flight::units::Feet radarAltitude)
+    {
+        // Caja con doble borde superior para distinguirla de la altitud barométrica
+        float boxX = position_.x + (size_.x - RADAR_BOX_WIDTH) * 0.5f;
+        float boxY = position_.y + size_.y + RADAR_BOX_GAP;
+
+        renderer.drawRect(glm::vec2(boxX, boxY), glm::vec2(RADAR_BOX_WIDTH, RADAR_BOX_HEIGHT), color_, false);
+        renderer.drawRect(glm::vec2(boxX, boxY - 4.0f), glm::vec2(RADAR_BOX_WIDTH, 1.0f), color_, true);
+
+        drawAltitudeNumber(renderer, readoutRadarAltitude(radarAltitude), glm::vec2(boxX + RADAR_BOX_WIDTH * 0.5f, boxY + RADAR_BOX_HEIGHT * 0.5f));
+    }
+
+    HUD_REGISTER_INSTRUMENT(Altimeter, "altimeter");
+
 } // namespace hud
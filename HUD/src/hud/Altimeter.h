@@ -11,6 +11,9 @@ namespace hud
      * - Tape vertical con escala de altitud móvil
      * - Caja de lectura digital con display de 7 segmentos
      * - Indicador chevron para referencia visual
+     * - Lectura del radioaltímetro debajo del tape (sólo cerca del terreno)
+     * - Flecha de tendencia: la altitud dentro de 6 s con la velocidad
+     *   vertical media de la ventana de FlightData::history
      */
     class Altimeter : public Instrument
     {
@@ -23,14 +26,19 @@ namespace hud
          * @param flightData Datos del vuelo (especialmente altitude)
          */
         void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const override;
 
     private:
         // Métodos específicos del altímetro
         void drawBackground(gfx::Renderer2D &renderer);
-        void drawAltitudeTape(gfx::Renderer2D &renderer, float altitude);
-        void drawCurrentAltitudeBox(gfx::Renderer2D &renderer, float altitude);
+        void drawAltitudeTape(gfx::Renderer2D &renderer, flight::units::Feet altitude);
+        void drawCurrentAltitudeBox(gfx::Renderer2D &renderer, flight::units::Feet altitude);
+        void drawRadarAltitude(gfx::Renderer2D &renderer, flight::units::Feet radarAltitude);
         void drawAltitudeNumber(gfx::Renderer2D &renderer, int altitude, const glm::vec2 &position);
         void drawDigit7Segment(gfx::Renderer2D &renderer, char digit, const glm::vec2 &pos, float w, float h, float thickness);
+        float trendPixels(const flight::FlightData &flightData) const;
+
+        float drawnTrend_ = 0.0f; // px de la última flecha dibujada (0 = sin flecha)
     };
 
 } // namespace hud
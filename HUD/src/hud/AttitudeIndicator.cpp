@@ -0,0 +1,55 @@
+#include "AttitudeIndicator.h"
+#include "InstrumentRegistry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace hud
+{
+    // ============================================================================
+    // CONFIGURACIÓN DE LA ESCALERA
+    // ============================================================================
+
+    static const float PIXELS_PER_DEGREE = 8.0f; // Separación de la escalera de pitch
+
+    AttitudeIndicator::AttitudeIndicator() : Instrument()
+    {
+        // Configuración específica del horizonte artificial
+        size_ = glm::vec2(360.0f, 360.0f);
+        color_ = glm::vec4(0.0f, 1.0f, 0.4f, 0.95f); // Verde HUD
+    }
+
+    void AttitudeIndicator::init()
+    {
+        // Mismo vertex shader que el resto del HUD: recorte y proyección iguales
+        shader_.load("shaders/hud.vert", "shaders/attitude.frag");
+    }
+
+    // ============================================================================
+    // FUNCIÓN PRINCIPAL DE RENDERIZADO
+    // ============================================================================
+
+    void AttitudeIndicator::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    {
+        if (!enabled_ || shader_.id() == 0)
+            return; // sin init(): no hay shader con qué dibujar
+
+        const float radius = 0.5f * std::min(size_.x, size_.y);
+        const glm::vec4 params(flightData.pitch.value(), flightData.roll.value(), PIXELS_PER_DEGREE, radius);
+
+        // uv = píxeles relativos al centro: el shader trabaja en unidades del HUD
+        const glm::vec2 half = size_ * 0.5f;
+        renderer.drawShaderQuad(position_, size_, shader_, params, -half, half, color_);
+    }
+
+    bool AttitudeIndicator::sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const
+    {
+        // Pitch corre la escalera; roll mueve el borde del círculo radio·Δθ
+        const float radius = 0.5f * std::min(size_.x, size_.y);
+        const float pitchShift = std::abs(current.pitch.value() - drawn.pitch.value()) * PIXELS_PER_DEGREE;
+        const float rollShift = std::abs(current.roll.value() - drawn.roll.value()) * radius * 3.14159265f / 180.0f;
+        return pitchShift < kSubpixelTolerance && rollShift < kSubpixelTolerance;
+    }
+
+    HUD_REGISTER_INSTRUMENT(AttitudeIndicator, "attitude");
+
+} // namespace hud
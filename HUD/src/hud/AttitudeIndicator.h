@@ -0,0 +1,37 @@
+#pragma once
+#include "Instrument.h"
+#include "../gfx/Shader.h"
+
+namespace hud
+{
+    /**
+     * @class AttitudeIndicator
+     * @brief Horizonte artificial: cielo/tierra, escalera de pitch y escala de roll
+     *
+     * Todo se calcula en el fragment shader (shaders/attitude.frag) a partir
+     * de pitch y roll: el CPU emite un solo quad por frame, sin importar
+     * cuántos peldaños se vean, y las líneas salen suavizadas a 1 px real a
+     * cualquier resolución (el shader mide el píxel con fwidth).
+     *
+     * El círculo del instrumento es el inscripto en size_, centrado.
+     */
+    class AttitudeIndicator : public Instrument
+    {
+    public:
+        AttitudeIndicator();
+
+        void init() override;
+
+        /**
+         * @brief Renderiza el horizonte artificial
+         * @param renderer Renderer 2D compartido
+         * @param flightData Datos del vuelo (pitch y roll)
+         */
+        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const override;
+
+    private:
+        gfx::Shader shader_;
+    };
+
+} // namespace hud
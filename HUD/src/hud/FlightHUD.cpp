@@ -11,63 +11,59 @@
  * 3. Coordina el renderizado en el orden correcto
  * 4. Maneja el layout y posicionamiento de cada instrumento
  *
- * INSTRUMENTOS:
+ * INSTRUMENTOS (los que se registran con HUD_REGISTER_INSTRUMENT):
  * - Altimeter
  * - AttitudeIndicator
- * - AirspeedIndicator
+ * - SpeedIndicator
  * - HeadingIndicator
  * - VerticalSpeedIndicator
- * - TurnCoordinator
  *
  * =============================================================================
  * GUÍA PARA AGREGAR UN NUEVO INSTRUMENTO:
  * =============================================================================
  * 1. Crear la clase del instrumento (ej: AttitudeIndicator.h/cpp)
- * 2. Agregar #include en FlightHUD.h
- * 3. Agregar variable miembro en FlightHUD.h privado:
- *    AttitudeIndicator attitudeIndicator_;
- * 4. En init(): Inicializar el instrumento (ver ejemplo del altímetro)
- * 5. En update(): Pasar datos si el instrumento los necesita
- * 6. En render(): Llamar a render() del instrumento
- * 7. En setupInstrumentLayout(): Configurar posición y tamaño
+ * 2. Registrarla al final de su .cpp: HUD_REGISTER_INSTRUMENT(AttitudeIndicator, "attitude");
+ * 3. Darle una línea en cada layout de layouts/hud.layout (y en BUILTIN_LAYOUT)
+ * FlightHUD no se toca: crea, inicializa y dibuja uno de cada tipo registrado.
  */
 
 #include "FlightHUD.h"
+#include "../gfx/GLState.h"
+#include <chrono>
 #include <iostream>
 
 namespace hud
 {
+    // Layout por defecto, para cuando no se carga un archivo (mismo formato que layouts/hud.layout)
+    static const char *BUILTIN_LAYOUT = R"(
+layout classic
+altimeter   right    -30    0   120  450
+vsi         right   -160    0    50  300
+speed       left      30    0   120  450
+attitude    center     0    0   300  300
+heading     top        0   30   400   64
+)";
 
     // ============================================================================
     // CONSTRUCTOR
     // ============================================================================
 
-    FlightHUD::FlightHUD() : altimeter_(nullptr), speedIndicator_(nullptr), screenWidth_(1280), screenHeight_(720)
+    FlightHUD::FlightHUD()
+        : screenWidth_(1280), screenHeight_(720)
     {
         // Crear el renderer 2D compartido
         renderer2D_ = std::make_unique<gfx::Renderer2D>();
+        compositor_ = std::make_unique<gfx::Renderer2D>();
+        workers_ = std::make_unique<util::WorkerPool>(util::WorkerPool::defaultWorkers(4));
 
         // CONFIGURAR ESQUEMA DE COLORES DEL HUD
         hudColor_ = glm::vec4(0.0f, 1.0f, 0.4f, 0.95f); // Verde HUD
 
-        // CREAR E INICIALIZAR INSTRUMENTOS
-        // Los instrumentos se crean como unique_ptr y se almacenan en el vector
-        // También guardamos referencias raw para acceso directo
-        
-        // Altimeter (Derecha)
-        auto altimeter = std::make_unique<Altimeter>();
-        altimeter_ = altimeter.get();
-        instruments_.push_back(std::move(altimeter));
-
-        // SpeedIndicator (Izquierda)
-        auto speedIndicator = std::make_unique<SpeedIndicator>();
-        speedIndicator_ = speedIndicator.get();
-        instruments_.push_back(std::move(speedIndicator));
-
-        // TODO: Agregar nuevos instrumentos aquí siguiendo el mismo patrón:
-        // auto attitudeIndicator = std::make_unique<AttitudeIndicator>();
-        // attitudeIndicator_ = attitudeIndicator.get();
-        // instruments_.push_back(std::move(attitudeIndicator));
+        // CREAR INSTRUMENTOS: uno de cada tipo registrado (sin GL todavía, ver init())
+        for (size_t type = 0; type < InstrumentRegistry::types().size(); ++type)
+            instruments_.add(type);
+
+        layouts_.loadFromString(BUILTIN_LAYOUT, "built-in layout");
     }
 
     // ============================================================================
@@ -91,17 +87,18 @@ namespace hud
 
         // Inicializar el renderer 2D
         renderer2D_->init(screenWidth, screenHeight);
+        compositor_->init(screenWidth, screenHeight);
+
+        // Recursos GL propios de cada instrumento (shaders del horizonte, etc.)
+        instruments_.forEach([](Instrument &instrument) { instrument.init(); });
 
         // Configurar layout de todos los instrumentos
-        setupInstrumentLayout();
+        applyLayout();
 
         // Log de inicialización
         std::cout << "Flight HUD initialized: " << screenWidth << "x" << screenHeight << std::endl;
-        std::cout << "  - Altimeter: OK" << std::endl;
-        std::cout << "  - SpeedIndicator: OK" << std::endl;
-        // TODO: Agregar logs para cada instrumento cuando se implementen
-        // std::cout << "  - AttitudeIndicator: OK" << std::endl;
-        // etc...
+        for (const InstrumentRegistry::TypeInfo &type : InstrumentRegistry::types())
+            std::cout << "  - " << type.name << ": OK" << std::endl;
     }
 
     /**
@@ -112,9 +109,10 @@ namespace hud
         screenWidth_ = width;
         screenHeight_ = height;
         renderer2D_->setScreenSize(width, height);
+        compositor_->setScreenSize(width, height);
 
-        // Recalcular layout de todos los instrumentos
-        setupInstrumentLayout();
+        // Recalcular layout de todos los instrumentos (las anclas dependen del tamaño)
+        applyLayout();
     }
 
     // ============================================================================
@@ -125,145 +123,358 @@ namespace hud
      * @brief Actualiza los datos de vuelo para todos los instrumentos
      * @param flightData Datos actuales del vuelo (altitud, velocidad, actitud, etc.)
      *
-     * Este método copia los datos de vuelo que luego serán pasados a cada
-     * instrumento durante el render.
+     * No copia: guarda un puntero al snapshot, que el llamador mantiene vivo
+     * hasta render() (el global en modo serie o el buffer de lectura del
+     * triple buffer del hilo de simulación).
      */
     void FlightHUD::update(const flight::FlightData &flightData)
     {
-        currentFlightData_ = flightData;
+        currentFlightData_ = &flightData;
 
         // TODO: Si algún instrumento necesita pre-procesamiento, hacerlo aquí
     }
 
     /**
      * @brief Renderiza todos los instrumentos del HUD como overlay 2D
+     * @param dt Segundos desde el frame anterior (sólo cuenta en render a textura)
      *
-     * Utiliza el patrón polimórfico para renderizar todos los instrumentos
-     * de forma uniforme mediante el vector de Instrument*.
+     * Los instrumentos se recorren por tipo (InstrumentRegistry): una llamada
+     * virtual por tipo, no por instrumento.
      *
      * Proceso:
      * 1. Configurar estado OpenGL (blending, depth test)
-     * 2. Renderizar cada instrumento habilitado en orden
+     * 2. Renderizar cada instrumento habilitado en orden (directo, o en la
+     *    textura si toca redibujarla y después componerla con un quad)
      * 3. Restaurar estado OpenGL
      */
-    void FlightHUD::render()
+    void FlightHUD::render(float dt)
     {
+        if (!currentFlightData_)
+            return; // todavía no hubo update()
+        if (offscreen_ && (screenWidth_ <= 0 || screenHeight_ <= 0))
+            return; // ventana minimizada: no hay textura que crear
+
+        using Clock = std::chrono::steady_clock;
+
         // Configurar estado OpenGL para overlay 2D
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDisable(GL_DEPTH_TEST); // HUD siempre visible encima del 3D
+        // (GLState filtra las llamadas si el estado ya es el pedido)
+        gfx::GLState &gl = gfx::GLState::current();
+        gl.enable(GL_BLEND);
+        gl.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gl.disable(GL_DEPTH_TEST); // HUD siempre visible encima del 3D
+
+        ++frameStats_.frames;
+        if (!offscreen_)
+        {
+            const Clock::time_point t0 = Clock::now();
+            renderer2D_->begin();
+            drawInstruments();
+            renderer2D_->end();
+            hudStats_ = renderer2D_->stats();
+            frameStats_.redrawSec += std::chrono::duration<double>(Clock::now() - t0).count();
+            ++frameStats_.redraws;
+        }
+        else
+        {
+            if (needsRedraw(dt))
+                redrawOffscreen();
+
+            // Composición: la textura tiene el origen abajo, el HUD arriba
+            const Clock::time_point t0 = Clock::now();
+            compositor_->begin();
+            compositor_->setBlendMode(gfx::BlendMode::Premultiplied);
+            compositor_->drawImage(glm::vec2(0.0f), glm::vec2((float)screenWidth_, (float)screenHeight_),
+                                   target_.colorTexture(), glm::vec2(0.0f, 1.0f), glm::vec2(1.0f, 0.0f));
+            compositor_->end();
+            frameStats_.compositeSec += std::chrono::duration<double>(Clock::now() - t0).count();
+        }
 
-        // Comenzar batch de renderizado 2D
-        renderer2D_->begin();
+        // Restaurar estado OpenGL para renderizado 3D
+        gl.enable(GL_DEPTH_TEST);
+        gl.disable(GL_BLEND);
+    }
+
+    /**
+     * @brief Dibuja el HUD ya subido en otra vista (otra ventana o viewport)
+     *
+     * Cuesta lo que cuestan los draw calls: la geometría se grabó y se subió
+     * una sola vez en render(). Con render a textura se ve el último
+     * redibujo, lo mismo que compone la ventana principal.
+     */
+    void FlightHUD::renderView(const gfx::Renderer2D::View &view)
+    {
+        if (!currentFlightData_)
+            return; // todavía no hubo render()
+
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point t0 = Clock::now();
+
+        gfx::GLState &gl = gfx::GLState::current();
+        gl.enable(GL_BLEND);
+        gl.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gl.disable(GL_DEPTH_TEST);
 
+        renderer2D_->draw(view);
+
+        gl.enable(GL_DEPTH_TEST);
+        gl.disable(GL_BLEND);
+
+        frameStats_.viewSec += std::chrono::duration<double>(Clock::now() - t0).count();
+        ++frameStats_.views;
+    }
+
+    glm::vec4 FlightHUD::instrumentBounds(std::uint32_t mask)
+    {
+        glm::vec2 lo(1e9f), hi(-1e9f);
+        for (size_t type = 0; type < InstrumentRegistry::types().size(); ++type)
+        {
+            const Instrument *instrument = instruments_.first(type);
+            if (!instrument || !instrument->isEnabled() || !(mask & InstrumentRegistry::viewBit(type)))
+                continue;
+            lo = glm::min(lo, instrument->getPosition());
+            hi = glm::max(hi, instrument->getPosition() + instrument->getSize());
+        }
+        if (hi.x < lo.x)
+            return glm::vec4(0.0f); // nada visible: todo el lienzo
+        return glm::vec4(lo, hi - lo);
+    }
+
+    /**
+     * @brief Graba todos los instrumentos habilitados en renderer2D_
+     */
+    void FlightHUD::drawInstruments()
+    {
         // ========================================================================
-        // RENDERIZAR TODOS LOS INSTRUMENTOS POLIMÓRFICAMENTE
+        // RENDERIZAR TODOS LOS INSTRUMENTOS, TIPO POR TIPO
         // ========================================================================
-        
-        for (const auto& instrument : instruments_)
+
+        if (instruments_.size() >= kParallelMinInstruments && workers_->workers() > 0)
         {
-            if (instrument && instrument->isEnabled())
-            {
-                instrument->render(*renderer2D_, currentFlightData_);
-            }
+            renderParallel();
+            return;
         }
 
-        // Finalizar batch
-        renderer2D_->end();
+        instruments_.render(*renderer2D_, *currentFlightData_);
+    }
 
-        // Restaurar estado OpenGL para renderizado 3D
-        glEnable(GL_DEPTH_TEST);
-        glDisable(GL_BLEND);
+    /**
+     * @brief Genera la geometría de los instrumentos en arenas, en paralelo
+     *
+     * Cada tramo de hasta kParallelBlock instrumentos de un mismo tipo graba
+     * en su propio Renderer2D (sin GL) desde el hilo que lo tome del pool;
+     * después se concatenan en el orden de los tramos, que es el de
+     * InstrumentRegistry::render(): mismos comandos, mismos draw calls. Los
+     * instrumentos sólo leen el FlightData del frame y su propio estado.
+     */
+    void FlightHUD::renderParallel()
+    {
+        instruments_.split(kParallelBlock, blocks_);
+        while (arenas_.size() < blocks_.size())
+            arenas_.push_back(std::make_unique<gfx::Renderer2D>());
+
+        const flight::FlightData &data = *currentFlightData_;
+        workers_->parallelFor(blocks_.size(), [&](size_t i)
+        {
+            gfx::Renderer2D &arena = *arenas_[i];
+            const InstrumentRegistry::Block &block = blocks_[i];
+            arena.begin();
+            arena.setViewBits(InstrumentRegistry::viewBit(block.type)); // como InstrumentRegistry::render()
+            block.pool->render(arena, data, block.first, block.count);
+        });
+
+        for (size_t i = 0; i < blocks_.size(); ++i)
+            renderer2D_->append(*arenas_[i]);
     }
 
     // ============================================================================
-    // CONFIGURACIÓN DE LAYOUTS
+    // RENDER A TEXTURA
     // ============================================================================
 
+    void FlightHUD::setOffscreen(bool enabled, float redrawHz, bool onChange)
+    {
+        offscreen_ = enabled;
+        redrawInterval_ = redrawHz > 0.0f ? 1.0f / redrawHz : 0.0f;
+        redrawOnChange_ = onChange;
+        sinceRedraw_ = 0.0f;
+        dirty_ = true;
+        resetFrameStats();
+    }
+
     /**
-     * @brief Cambia el layout del HUD
-     * @param layoutName Nombre del layout ("classic", "modern", "minimal")
+     * @brief Decide si la textura del HUD está vieja
      *
-     * Layouts disponibles:
-     * - "classic": Layout tradicional de aviación (instrumentos grandes)
-     * - "modern": Layout compacto y eficiente
-     * - "minimal": Solo información esencial
+     * Primero el tope de frecuencia; después, con redrawOnChange_, se pregunta
+     * a cada instrumento si con los datos nuevos se vería distinto de lo que
+     * ya está en la textura. Un instrumento sin sameDisplay fuerza el redibujo.
      */
-    void FlightHUD::setLayout(const std::string &layoutName)
+    bool FlightHUD::needsRedraw(float dt)
     {
-        // Reconfigurar todos los instrumentos según el layout seleccionado
-        setupInstrumentLayout();
+        sinceRedraw_ += dt;
+        if (dirty_)
+            return true;
+        if (sinceRedraw_ < redrawInterval_)
+            return false;
+        if (!redrawOnChange_)
+            return true;
+
+        return !instruments_.sameDisplay(drawnData_, *currentFlightData_);
+    }
+
+    /**
+     * @brief Redibuja los instrumentos en la textura offscreen
+     *
+     * Sobre transparente con el blend de Renderer2D queda color premultiplicado
+     * (alfa "over"; lo aditivo no toca el alfa), que se compone con
+     * BlendMode::Premultiplied igual que si se dibujara directo.
+     */
+    void FlightHUD::redrawOffscreen()
+    {
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point t0 = Clock::now();
+
+        // El destino actual puede ser la ventana o el FBO del modo headless
+        GLint previousFbo = 0;
+        GLint viewport[4];
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFbo);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        target_.resize(screenWidth_, screenHeight_);
+        target_.bind();
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        renderer2D_->begin();
+        drawInstruments();
+        renderer2D_->end();
+        hudStats_ = renderer2D_->stats();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
 
-        // TODO: En el futuro, diferentes layouts pueden tener diferentes posiciones
+        drawnData_ = *currentFlightData_;
+        sinceRedraw_ = 0.0f;
+        dirty_ = false;
+
+        frameStats_.redrawSec += std::chrono::duration<double>(Clock::now() - t0).count();
+        ++frameStats_.redraws;
     }
 
+    // ============================================================================
+    // CONFIGURACIÓN DE LAYOUTS
+    // ============================================================================
+
     /**
-     * @brief Configura la posición y tamaño de TODOS los instrumentos
+     * @brief Lee la tabla de layouts y aplica el layout actual con ella
+     * @param path Archivo de layouts (formato en HudLayout.h)
+     * @param watch Vigilar el archivo para pollLayoutFile()
      */
-    void FlightHUD::setupInstrumentLayout()
+    bool FlightHUD::loadLayouts(const std::string &path, bool watch)
     {
-        // float centerX = screenWidth_ * 0.5f;   // Para futuros instrumentos centrados
-        float centerY = screenHeight_ * 0.5f;
+        layoutPath_ = path;
+        if (watch)
+            layoutWatcher_.watch(path);
+        else
+            layoutWatcher_.stop();
+
+        if (!layouts_.loadFromFile(path))
+            return false;
 
-        // ------------------------------------------------------------------------
-        // SPEED INDICATOR (Velocidad) - IZQUIERDA
-        // ------------------------------------------------------------------------
+        std::cout << "HUD layouts: " << path << " (";
+        for (size_t i = 0; i < layouts_.layoutCount(); ++i)
+            std::cout << (i ? ", " : "") << layouts_.layoutName(i);
+        std::cout << ")" << std::endl;
+
+        if (!applyLayout())
         {
-            const float WIDTH = 120.0f;
-            const float HEIGHT = 450.0f;
-            const float MARGIN_LEFT = 30.0f;
+            // El layout actual ya no existe: el primero del archivo
+            layoutName_ = layouts_.layoutName(0);
+            applyLayout();
+        }
+        return true;
+    }
 
-            float posX = MARGIN_LEFT;
-            float posY = centerY - HEIGHT * 0.5f;
+    /**
+     * @brief Recarga el archivo de layouts si cambió (llamar una vez por frame)
+     *
+     * Sin cambios es una lectura no bloqueante de inotify. Un archivo con
+     * errores a mitad de edición no rompe el HUD: se informa y sigue la tabla
+     * que había.
+     */
+    void FlightHUD::pollLayoutFile()
+    {
+        if (!layoutWatcher_.changed())
+            return;
 
-            speedIndicator_->setPosition(glm::vec2(posX, posY));
-            speedIndicator_->setSize(glm::vec2(WIDTH, HEIGHT));
-            speedIndicator_->setColor(hudColor_);
-            speedIndicator_->setEnabled(false); // TODO: Habilitar cuando se implemente
+        if (layouts_.loadFromFile(layoutPath_))
+        {
+            std::cout << "HUD layouts reloaded: " << layoutPath_ << std::endl;
+            if (!applyLayout())
+            {
+                layoutName_ = layouts_.layoutName(0);
+                applyLayout();
+            }
+        }
+        else
+        {
+            std::cerr << "Keeping previous HUD layouts" << std::endl;
         }
+    }
 
-        // ------------------------------------------------------------------------
-        // ALTIMETER (Altímetro) - DERECHA
-        // ------------------------------------------------------------------------
+    /**
+     * @brief Cambia el layout del HUD
+     * @param layoutName Nombre de un layout del archivo (p. ej. "classic", "modern", "minimal")
+     *
+     * El cambio es recorrer las entradas del layout en la tabla plana y fijar
+     * posición, tamaño, color y visibilidad de instrumentos que ya existen:
+     * unos pocos µs (se informa el tiempo medido).
+     */
+    bool FlightHUD::setLayout(const std::string &layoutName)
+    {
+        size_t count = 0;
+        if (!layouts_.find(layoutName, count))
         {
-            const float WIDTH = 120.0f;
-            const float HEIGHT = 450.0f;
-            const float MARGIN_RIGHT = 30.0f;
+            std::cerr << "Unknown HUD layout: " << layoutName << std::endl;
+            return false;
+        }
 
-            float posX = screenWidth_ - WIDTH - MARGIN_RIGHT;
-            float posY = centerY - HEIGHT * 0.5f;
+        const auto t0 = std::chrono::steady_clock::now();
+        layoutName_ = layoutName;
+        applyLayout();
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "HUD layout: " << layoutName_ << " (" << us << " us)" << std::endl;
+        return true;
+    }
 
-            altimeter_->setPosition(glm::vec2(posX, posY));
-            altimeter_->setSize(glm::vec2(WIDTH, HEIGHT));
-            altimeter_->setColor(hudColor_);
-        }
+    /**
+     * @brief Aplica layoutName_ desde la tabla
+     *
+     * Los instrumentos que el layout no nombra quedan ocultos. No reserva
+     * memoria: es seguro llamarlo en cada resize.
+     */
+    bool FlightHUD::applyLayout()
+    {
+        size_t count = 0;
+        const LayoutEntry *entries = layouts_.find(layoutName_, count);
+        if (!entries)
+            return false;
+
+        dirty_ = true; // la textura del HUD (si hay) quedó vieja
+
+        instruments_.forEach([](Instrument &instrument) { instrument.setEnabled(false); });
 
-        // ------------------------------------------------------------------------
-        // TODO: ATTITUDE INDICATOR (Horizonte Artificial) - CENTRO
-        // ------------------------------------------------------------------------
-        // {
-        //     const float SIZE = 300.0f;  // Cuadrado
-        //     float posX = centerX - SIZE * 0.5f;
-        //     float posY = centerY - SIZE * 0.5f;
-        //
-        //     attitudeIndicator_->setPosition(glm::vec2(posX, posY));
-        //     attitudeIndicator_->setSize(glm::vec2(SIZE, SIZE));
-        // }
-
-        // ------------------------------------------------------------------------
-        // TODO: HEADING INDICATOR (Rumbo) - ARRIBA/CENTRO
-        // ------------------------------------------------------------------------
-        // {
-        //     const float WIDTH = 400.0f;
-        //     const float HEIGHT = 60.0f;
-        //     const float MARGIN_TOP = 30.0f;
-        //
-        //     float posX = centerX - WIDTH * 0.5f;
-        //     float posY = MARGIN_TOP;
-        //
-        //     headingIndicator_.setPosition(glm::vec2(posX, posY));
-        //     headingIndicator_.setSize(glm::vec2(WIDTH, HEIGHT));
-        // }
+        const glm::vec2 screen((float)screenWidth_, (float)screenHeight_);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const LayoutEntry &entry = entries[i];
+            Instrument *instrument = instruments_.first(entry.type);
+            if (!instrument)
+                continue;
+            instrument->setPosition(entry.resolve(screen));
+            instrument->setSize(entry.size);
+            instrument->setColor(entry.customColor ? entry.color : hudColor_);
+            instrument->setEnabled(entry.enabled);
+        }
+        return true;
     }
 
 } // namespace hud
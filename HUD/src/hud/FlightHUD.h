@@ -1,21 +1,16 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 #include <glm/glm.hpp>
+#include "../gfx/Framebuffer.h"
 #include "../gfx/Renderer2D.h"
 #include "../flight/FlightData.h"
-#include "Instrument.h"
-
-// Includes de instrumentos implementados
-#include "Altimeter.h"
-#include "SpeedIndicator.h"
-
-// TODO: Agregar includes de futuros instrumentos
-// #include "AttitudeIndicator.h"
-// #include "AirspeedIndicator.h"
-// #include "HeadingIndicator.h"
-// #include "VerticalSpeedIndicator.h"
+#include "../util/FileWatcher.h"
+#include "../util/WorkerPool.h"
+#include "HudLayout.h"
+#include "InstrumentRegistry.h"
 
 namespace hud
 {
@@ -24,7 +19,7 @@ namespace hud
      * @brief Coordinador central de todos los instrumentos del HUD
      *
      * Esta clase es el punto de entrada para el sistema de HUD. Gestiona:
-     * - Creación y configuración de todos los instrumentos
+     * - Creación de una instancia de cada tipo registrado (InstrumentRegistry)
      * - Actualización de datos de vuelo
      * - Renderizado coordinado de todos los instrumentos
      * - Layout y posicionamiento
@@ -42,14 +37,75 @@ namespace hud
 
         void init(int screenWidth, int screenHeight);
         void setScreenSize(int width, int height);
-        void setLayout(const std::string &layoutName);
+
+        // Layouts de archivo (ver HudLayout.h). Con watch, pollLayoutFile()
+        // lo recarga cuando cambia; si la recarga falla queda la tabla anterior.
+        // Sin archivo rige el "classic" incorporado (BUILTIN_LAYOUT)
+        bool loadLayouts(const std::string &path, bool watch = true);
+        void pollLayoutFile();
+
+        // Sólo reubica, recolorea y muestra/oculta: no crea instrumentos ni
+        // toca recursos GL. false si el nombre no está en la tabla
+        bool setLayout(const std::string &layoutName);
+        const std::string &layoutName() const { return layoutName_; }
 
         // ========================================================================
         // ACTUALIZACIÓN Y RENDERIZADO
         // ========================================================================
 
         void update(const flight::FlightData &flightData);
-        void render();
+        void render(float dt = 0.0f); // dt: s desde el frame anterior (ritmo del render a textura)
+
+        // Comandos y draw calls 2D del último redibujo del HUD
+        const gfx::Renderer2D::Stats &renderStats() const { return hudStats_; }
+
+        // ========================================================================
+        // VISTAS: VARIAS PANTALLAS DESDE UNA SOLA GEOMETRÍA
+        // ========================================================================
+
+        // Después de render(), dibuja en el contexto y viewport actuales la
+        // geometría ya subida (la del frame, o la del último redibujo con render
+        // a textura): view.region es la parte del lienzo que se ve y view.mask
+        // los tipos (InstrumentRegistry::viewMask). No graba ni sube nada.
+        // Otro contexto debe compartir objetos con el de init(), tener su
+        // GLState activo (GLState::makeCurrent) y pasar por addViewContext()
+        void renderView(const gfx::Renderer2D::View &view);
+        void addViewContext() { renderer2D_->attachContext(); }
+        void releaseViewContext() { renderer2D_->releaseContext(); } // antes de destruir el contexto
+
+        // Caja (x, y, ancho, alto) de los instrumentos visibles de mask en el layout actual
+        glm::vec4 instrumentBounds(std::uint32_t mask);
+
+        // ========================================================================
+        // RENDER A TEXTURA
+        // ========================================================================
+
+        // El HUD se dibuja en una textura offscreen y cada frame sólo se compone
+        // con un quad. Se redibuja a lo sumo redrawHz veces por segundo (0 = sin
+        // tope) y, con onChange, sólo si algún instrumento se vería distinto
+        // (Instrument::sameDisplay). Desactivado: se dibuja directo cada frame
+        void setOffscreen(bool enabled, float redrawHz = 30.0f, bool onChange = true);
+        bool offscreen() const { return offscreen_; }
+        void invalidate() { dirty_ = true; } // forzar redibujo (cambios fuera de FlightData)
+
+        // CPU del HUD acumulada desde el último resetFrameStats()
+        struct FrameStats
+        {
+            std::uint64_t frames = 0;
+            std::uint64_t redraws = 0;
+            double redrawSec = 0.0;    // grabar + ordenar + subir + draw calls
+            double compositeSec = 0.0; // el quad de cada frame
+            std::uint64_t views = 0;
+            double viewSec = 0.0;      // renderView(): sólo draw calls sobre lo ya subido
+
+            double redrawUs() const { return redraws ? redrawSec / redraws * 1e6 : 0.0; }
+            double frameUs() const { return frames ? (redrawSec + compositeSec) / frames * 1e6 : 0.0; }
+            double viewUs() const { return views ? viewSec / views * 1e6 : 0.0; }
+            // Contra redibujar cada frame (el costo medio de un redibujo)
+            double savedUs() const { return redrawUs() - frameUs(); }
+        };
+        const FrameStats &frameStats() const { return frameStats_; }
+        void resetFrameStats() { frameStats_ = FrameStats{}; }
 
     private:
         // ========================================================================
@@ -57,33 +113,50 @@ namespace hud
         // ========================================================================
 
         std::unique_ptr<gfx::Renderer2D> renderer2D_;
+        std::unique_ptr<gfx::Renderer2D> compositor_; // quad de la textura: renderer2D_ conserva la geometría para renderView()
+
+        // Geometría en paralelo: una arena por tramo de instrumentos del mismo
+        // tipo (no por hilo), así el resultado no depende de qué hilo tomó
+        // cada uno. Se concatenan en el orden de render() sobre renderer2D_
+        std::vector<std::unique_ptr<gfx::Renderer2D>> arenas_;
+        std::vector<InstrumentRegistry::Block> blocks_;
+        std::unique_ptr<util::WorkerPool> workers_;
+        static constexpr size_t kParallelMinInstruments = 8; // por debajo no paga el reparto
+        static constexpr size_t kParallelBlock = 8;          // instrumentos por arena
+
+        // Render a textura: color premultiplicado sobre transparente
+        gfx::Framebuffer target_;
+        bool offscreen_ = false;
+        bool redrawOnChange_ = true;
+        float redrawInterval_ = 0.0f; // s entre redibujos (0 = sin tope)
+        float sinceRedraw_ = 0.0f;
+        bool dirty_ = true; // layout, tamaño o modo cambiados: redibujar sí o sí
+        flight::FlightData drawnData_; // con lo que se dibujó la textura
+
+        gfx::Renderer2D::Stats hudStats_;
+        FrameStats frameStats_;
 
         // ========================================================================
         // INSTRUMENTOS DEL HUD
         // ========================================================================
 
-        // Contenedor polimórfico de instrumentos
-        // Permite gestionar todos los instrumentos de forma uniforme
-        std::vector<std::unique_ptr<Instrument>> instruments_;
-
-        // Referencias rápidas a instrumentos específicos (opcional)
-        // Útil para configuración directa sin recorrer el vector
-        Altimeter* altimeter_;
-        SpeedIndicator* speedIndicator_;
-
-        // TODO: Agregar referencias a futuros instrumentos aquí
-        // AttitudeIndicator* attitudeIndicator_;
-        // HeadingIndicator* headingIndicator_;
-        // VerticalSpeedIndicator* verticalSpeedIndicator_;
+        // Instrumentos agrupados por tipo: render() hace un loop no virtual
+        // por tipo. El layout los ubica por tipo (la primera instancia)
+        InstrumentRegistry instruments_;
 
         // ========================================================================
         // DATOS Y CONFIGURACIÓN
         // ========================================================================
 
-        flight::FlightData currentFlightData_;
+        const flight::FlightData *currentFlightData_ = nullptr; // snapshot del frame (no se copia)
         int screenWidth_;
         int screenHeight_;
 
+        LayoutTable layouts_;
+        std::string layoutPath_;
+        std::string layoutName_ = "classic";
+        util::FileWatcher layoutWatcher_;
+
         // ========================================================================
         // ESQUEMA DE COLORES DEL HUD
         // ========================================================================
@@ -96,7 +169,11 @@ namespace hud
         // CONFIGURACIÓN INTERNA
         // ========================================================================
 
-        void setupInstrumentLayout(); // Configura layout de TODOS los instrumentos
+        bool applyLayout(); // layoutName_ desde layouts_: posición, tamaño, color y visibilidad
+        void drawInstruments();
+        void renderParallel();
+        bool needsRedraw(float dt);
+        void redrawOffscreen();
     };
 
 } // namespace hud
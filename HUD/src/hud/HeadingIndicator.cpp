@@ -0,0 +1,252 @@
+#include "HeadingIndicator.h"
+#include "InstrumentRegistry.h"
+#include "../gfx/GLState.h"
+#include <cmath>
+#include <string>
+
+namespace hud
+{
+    // ============================================================================
+    // CONFIGURACIÓN DE LA ESCALA
+    // ============================================================================
+
+    static const float PIXELS_PER_DEGREE = 4.0f;                     // 360° = 1440 px de textura
+    static const int STRIP_WIDTH = (int)(360.0f * PIXELS_PER_DEGREE);
+    static const int STRIP_HEIGHT = 36;                             // Alto del tape en pantalla
+
+    // Configuración visual
+    static const float MAJOR_TICK = 12.0f; // cada 10°
+    static const float MINOR_TICK = 6.0f;  // cada 5°
+    static const float LABEL_GAP = 4.0f;   // entre la marca y el rótulo
+    static const float DIGIT_WIDTH = 8.0f;
+    static const float DIGIT_HEIGHT = 12.0f;
+    static const float DIGIT_SPACING = 10.0f;
+    static const float SEGMENT = 1.5f;
+    static const float READOUT_BOX_WIDTH = 50.0f;
+    static const float READOUT_BOX_HEIGHT = 22.0f;
+    static const float POINTER_SIZE = 6.0f;
+
+    // Segmentos a..g (bit 0 = a) de los dígitos y de las letras que los usan
+    static int segmentMask(char c)
+    {
+        switch (c)
+        {
+        case '0': return 0x3F;
+        case '1': return 0x06;
+        case '2': return 0x5B;
+        case '3': return 0x4F;
+        case '4': return 0x66;
+        case '5': case 'S': return 0x6D;
+        case '6': return 0x7D;
+        case '7': return 0x07;
+        case '8': return 0x7F;
+        case '9': return 0x6F;
+        case 'E': return 0x79;
+        default: return 0;
+        }
+    }
+
+    // Caracter de 7 segmentos (N y W no entran en 7 segmentos: se trazan)
+    static void drawGlyph(gfx::Renderer2D &renderer, char c, const glm::vec2 &pos, const glm::vec4 &color)
+    {
+        const float w = DIGIT_WIDTH, h = DIGIT_HEIGHT, t = SEGMENT, halfH = h * 0.5f;
+        if (c == 'N' || c == 'W')
+        {
+            const glm::vec2 bl = pos + glm::vec2(0.0f, h), tl = pos, tr = pos + glm::vec2(w, 0.0f), br = pos + glm::vec2(w, h);
+            if (c == 'N')
+            {
+                renderer.drawLine(bl, tl, color, t);
+                renderer.drawLine(tl, br, color, t);
+                renderer.drawLine(br, tr, color, t);
+            }
+            else
+            {
+                const glm::vec2 mid = pos + glm::vec2(w * 0.5f, halfH);
+                renderer.drawLine(tl, pos + glm::vec2(w * 0.25f, h), color, t);
+                renderer.drawLine(pos + glm::vec2(w * 0.25f, h), mid, color, t);
+                renderer.drawLine(mid, pos + glm::vec2(w * 0.75f, h), color, t);
+                renderer.drawLine(pos + glm::vec2(w * 0.75f, h), tr, color, t);
+            }
+            return;
+        }
+
+        const int mask = segmentMask(c);
+        if (mask & 0x01) // a - arriba
+            renderer.drawRect(pos + glm::vec2(t, 0.0f), glm::vec2(w - 2 * t, t), color, true);
+        if (mask & 0x02) // b - arriba derecha
+            renderer.drawRect(pos + glm::vec2(w - t, t), glm::vec2(t, halfH - t), color, true);
+        if (mask & 0x04) // c - abajo derecha
+            renderer.drawRect(pos + glm::vec2(w - t, halfH), glm::vec2(t, halfH - t), color, true);
+        if (mask & 0x08) // d - abajo
+            renderer.drawRect(pos + glm::vec2(t, h - t), glm::vec2(w - 2 * t, t), color, true);
+        if (mask & 0x10) // e - abajo izquierda
+            renderer.drawRect(pos + glm::vec2(0.0f, halfH), glm::vec2(t, halfH - t), color, true);
+        if (mask & 0x20) // f - arriba izquierda
+            renderer.drawRect(pos + glm::vec2(0.0f, t), glm::vec2(t, halfH - t), color, true);
+        if (mask & 0x40) // g - medio
+            renderer.drawRect(pos + glm::vec2(t, halfH - t * 0.5f), glm::vec2(w - 2 * t, t), color, true);
+    }
+
+    // Texto centrado en x, con el borde superior en top (dígitos tabulares)
+    static void drawText(gfx::Renderer2D &renderer, const std::string &text, float centerX, float top, const glm::vec4 &color)
+    {
+        const float totalWidth = text.length() * DIGIT_SPACING - (DIGIT_SPACING - DIGIT_WIDTH);
+        const float startX = centerX - totalWidth * 0.5f;
+        for (size_t i = 0; i < text.length(); ++i)
+            drawGlyph(renderer, text[i], glm::vec2(floor(startX + i * DIGIT_SPACING) + 0.5f, floor(top) + 0.5f), color);
+    }
+
+    // Rumbo mostrado: grados enteros en 1..360 (como en la brújula, 0 se lee 360)
+    static int readoutHeading(flight::units::Degrees heading)
+    {
+        int display = (int)round(heading.value()) % 360;
+        if (display <= 0)
+            display += 360;
+        return display;
+    }
+
+    HeadingIndicator::HeadingIndicator() : Instrument()
+    {
+        // Configuración específica del indicador de rumbo
+        size_ = glm::vec2(400.0f, STRIP_HEIGHT + READOUT_BOX_HEIGHT + POINTER_SIZE);
+        color_ = glm::vec4(0.0f, 1.0f, 0.4f, 0.95f); // Verde HUD
+    }
+
+    // ============================================================================
+    // ESCALA PRECALCULADA
+    // ============================================================================
+
+    void HeadingIndicator::init()
+    {
+        buildStrip();
+    }
+
+    /**
+     * @brief Dibuja los 360° de escala en strip_ (una vez)
+     *
+     * Blanco: el color del HUD se aplica como tint al componer, así setColor()
+     * no obliga a regenerarla. Los rótulos que caen sobre 0/360 se dibujan
+     * en los dos bordes para que el wrap no los corte.
+     */
+    void HeadingIndicator::buildStrip()
+    {
+        GLint previousFbo = 0;
+        GLint viewport[4];
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFbo);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        strip_.create(STRIP_WIDTH, STRIP_HEIGHT);
+        gfx::GLState &gl = gfx::GLState::current();
+        gl.bindTexture(GL_TEXTURE_2D, strip_.colorTexture());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+
+        strip_.bind();
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        gl.enable(GL_BLEND);
+        gl.disable(GL_DEPTH_TEST);
+
+        gfx::Renderer2D renderer;
+        renderer.init(STRIP_WIDTH, STRIP_HEIGHT);
+        renderer.begin();
+
+        const glm::vec4 white(1.0f);
+        const float width = (float)STRIP_WIDTH;
+        const float margin = 2.0f * DIGIT_SPACING; // lo que puede asomar un rótulo del otro lado
+        for (int deg = 0; deg < 360; deg += 5)
+        {
+            const bool major = deg % 10 == 0;
+            std::string label;
+            if (major)
+            {
+                switch (deg)
+                {
+                case 0: label = "N"; break;
+                case 90: label = "E"; break;
+                case 180: label = "S"; break;
+                case 270: label = "W"; break;
+                default: label = std::to_string(deg / 10); break; // decenas: 3 = 030°
+                }
+            }
+
+            const float x = deg * PIXELS_PER_DEGREE;
+            for (float copy : {x - width, x, x + width})
+            {
+                if (copy < -margin || copy > width + margin)
+                    continue;
+                const float tickX = floor(copy) + 0.5f;
+                renderer.drawLine(glm::vec2(tickX, 0.0f), glm::vec2(tickX, major ? MAJOR_TICK : MINOR_TICK), white, 1.5f);
+                if (!label.empty())
+                    drawText(renderer, label, copy, MAJOR_TICK + LABEL_GAP, white);
+            }
+        }
+
+        renderer.end();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFbo);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
+
+    // ============================================================================
+    // FUNCIÓN PRINCIPAL DE RENDERIZADO
+    // ============================================================================
+
+    void HeadingIndicator::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    {
+        if (!enabled_)
+            return;
+
+        const float heading = flightData.heading.value();
+
+        if (strip_.colorTexture())
+        {
+            // Ventana de la escala centrada en el rumbo, alineada a píxel de
+            // textura (nítida); u fuera de [0, 1] da la vuelta por el wrap
+            const float center = round(heading * PIXELS_PER_DEGREE);
+            const float u0 = (center - size_.x * 0.5f) / STRIP_WIDTH;
+            const float u1 = (center + size_.x * 0.5f) / STRIP_WIDTH;
+
+            // Textura premultiplicada: el tint también (color·alfa, alfa)
+            const glm::vec4 tint(glm::vec3(color_) * color_.w, color_.w);
+            renderer.setBlendMode(gfx::BlendMode::Premultiplied);
+            renderer.drawImage(position_, glm::vec2(size_.x, (float)STRIP_HEIGHT), strip_.colorTexture(),
+                               glm::vec2(u0, 1.0f), glm::vec2(u1, 0.0f), tint);
+            renderer.setBlendMode(gfx::BlendMode::Alpha);
+        }
+
+        drawCurrentHeadingBox(renderer, readoutHeading(flightData.heading));
+    }
+
+    bool HeadingIndicator::sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const
+    {
+        // El tape avanza de a píxel de textura; la caja, por grado entero
+        return round(current.heading.value() * PIXELS_PER_DEGREE) == round(drawn.heading.value() * PIXELS_PER_DEGREE) &&
+               readoutHeading(current.heading) == readoutHeading(drawn.heading);
+    }
+
+    // ============================================================================
+    // CAJA DE LECTURA DIGITAL (DEBAJO DEL TAPE)
+    // ============================================================================
+
+    void HeadingIndicator::drawCurrentHeadingBox(gfx::Renderer2D &renderer, int heading)
+    {
+        const float centerX = position_.x + size_.x * 0.5f;
+        const float tapeBottom = position_.y + STRIP_HEIGHT;
+
+        // Puntero: triángulo que apunta al tape
+        renderer.drawLine(glm::vec2(centerX - POINTER_SIZE, tapeBottom + POINTER_SIZE), glm::vec2(centerX, tapeBottom), color_, 2.0f);
+        renderer.drawLine(glm::vec2(centerX, tapeBottom), glm::vec2(centerX + POINTER_SIZE, tapeBottom + POINTER_SIZE), color_, 2.0f);
+
+        const float boxY = tapeBottom + POINTER_SIZE;
+        renderer.drawRect(glm::vec2(centerX - READOUT_BOX_WIDTH * 0.5f, boxY),
+                          glm::vec2(READOUT_BOX_WIDTH, READOUT_BOX_HEIGHT), color_, false);
+
+        // Tres dígitos siempre: 007, 090, 360
+        std::string text = std::to_string(heading);
+        text.insert(0, 3 - text.length(), '0');
+        drawText(renderer, text, centerX, boxY + (READOUT_BOX_HEIGHT - DIGIT_HEIGHT) * 0.5f, color_);
+    }
+
+    HUD_REGISTER_INSTRUMENT(HeadingIndicator, "heading");
+
+} // namespace hud
@@ -0,0 +1,39 @@
+#pragma once
+#include "Instrument.h"
+#include "../gfx/Framebuffer.h"
+
+namespace hud
+{
+    /**
+     * @class HeadingIndicator
+     * @brief Tape horizontal de rumbo (arriba/centro) con lectura digital
+     *
+     * La escala completa de 360° (marcas cada 5°, rótulos cada 10°: N, E, S,
+     * W y decenas de grado) se dibuja una sola vez en init() a una textura
+     * con wrap GL_REPEAT. Cada frame el tape es un quad que la recorre por
+     * coordenadas de textura: pasar por 0/360 es simplemente salir de [0, 1].
+     * No se regenera ninguna marca (a diferencia de los tapes verticales).
+     */
+    class HeadingIndicator : public Instrument
+    {
+    public:
+        HeadingIndicator();
+
+        void init() override;
+
+        /**
+         * @brief Renderiza el tape y la lectura de rumbo
+         * @param renderer Renderer 2D compartido
+         * @param flightData Datos del vuelo (heading)
+         */
+        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const override;
+
+    private:
+        void buildStrip();
+        void drawCurrentHeadingBox(gfx::Renderer2D &renderer, int heading);
+
+        gfx::Framebuffer strip_; // escala de 360°, blanca sobre transparente (premultiplicada)
+    };
+
+} // namespace hud
@@ -0,0 +1,179 @@
+#include "HudLayout.h"
+#include "InstrumentRegistry.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace hud
+{
+    static const char *ANCHOR_NAMES[] = {"top-left", "top", "top-right",
+                                         "left", "center", "right",
+                                         "bottom-left", "bottom", "bottom-right"};
+
+    template <typename Enum, size_t N>
+    static bool parseName(const std::string &word, const char *const (&names)[N], Enum &value)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (word == names[i])
+            {
+                value = static_cast<Enum>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    glm::vec2 LayoutEntry::resolve(const glm::vec2 &screen) const
+    {
+        // Fracción del ancla en cada eje: 0 = borde izquierdo/superior, 1 = opuesto
+        const int a = static_cast<int>(anchor);
+        const glm::vec2 f(0.5f * static_cast<float>(a % 3), 0.5f * static_cast<float>(a / 3));
+        return screen * f - size * f + offset;
+    }
+
+    bool LayoutTable::loadFromFile(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "Failed to open HUD layouts: " << path << std::endl;
+            return false;
+        }
+        return load(file, path);
+    }
+
+    bool LayoutTable::loadFromString(const std::string &text, const std::string &source)
+    {
+        std::istringstream in(text);
+        return load(in, source);
+    }
+
+    bool LayoutTable::load(std::istream &file, const std::string &path)
+    {
+        std::vector<Range> layouts;
+        std::vector<LayoutEntry> entries;
+        std::string line;
+        int lineNo = 0;
+        while (std::getline(file, line))
+        {
+            ++lineNo;
+            const size_t hash = line.find('#');
+            if (hash != std::string::npos)
+                line.erase(hash);
+
+            std::istringstream in(line);
+            std::string word;
+            if (!(in >> word))
+                continue; // línea vacía o comentario
+
+            if (word == "layout")
+            {
+                Range range{std::string(), entries.size(), 0};
+                if (!(in >> range.name))
+                {
+                    std::cerr << path << ":" << lineNo << ": expected 'layout NAME'" << std::endl;
+                    return false;
+                }
+                for (const Range &other : layouts)
+                {
+                    if (other.name == range.name)
+                    {
+                        std::cerr << path << ":" << lineNo << ": duplicate layout '" << range.name << "'" << std::endl;
+                        return false;
+                    }
+                }
+                layouts.push_back(range);
+                continue;
+            }
+
+            if (layouts.empty())
+            {
+                std::cerr << path << ":" << lineNo << ": instrument outside a 'layout' block" << std::endl;
+                return false;
+            }
+
+            LayoutEntry entry;
+            std::string anchor;
+            const int type = InstrumentRegistry::typeIndex(word);
+            if (type < 0)
+            {
+                std::cerr << path << ":" << lineNo << ": unknown instrument '" << word << "'" << std::endl;
+                return false;
+            }
+            entry.type = static_cast<size_t>(type);
+            if (!(in >> anchor) || !parseName(anchor, ANCHOR_NAMES, entry.anchor))
+            {
+                std::cerr << path << ":" << lineNo << ": expected an anchor (top-left ... bottom-right)" << std::endl;
+                return false;
+            }
+            if (!(in >> entry.offset.x >> entry.offset.y >> entry.size.x >> entry.size.y))
+            {
+                std::cerr << path << ":" << lineNo << ": expected 'TYPE ANCHOR dx dy width height'" << std::endl;
+                return false;
+            }
+
+            // Opcionales: color RGBA y on/off, en ese orden
+            std::string rest;
+            if (in >> rest && rest != "on" && rest != "off")
+            {
+                std::istringstream color(rest);
+                if (!(color >> entry.color.x) || !(in >> entry.color.y >> entry.color.z >> entry.color.w))
+                {
+                    std::cerr << path << ":" << lineNo << ": expected 'r g b a' or on/off" << std::endl;
+                    return false;
+                }
+                entry.customColor = true;
+                rest.clear();
+                in >> rest;
+            }
+            if (!rest.empty())
+            {
+                if (rest != "on" && rest != "off")
+                {
+                    std::cerr << path << ":" << lineNo << ": expected on/off, got '" << rest << "'" << std::endl;
+                    return false;
+                }
+                entry.enabled = rest == "on";
+            }
+
+            Range &range = layouts.back();
+            for (size_t i = range.first; i < entries.size(); ++i)
+            {
+                if (entries[i].type == entry.type)
+                {
+                    std::cerr << path << ":" << lineNo << ": '" << word << "' listed twice in layout '"
+                              << range.name << "'" << std::endl;
+                    return false;
+                }
+            }
+            entries.push_back(entry);
+            ++range.count;
+        }
+
+        if (layouts.empty())
+        {
+            std::cerr << "HUD layout file has no layouts: " << path << std::endl;
+            return false;
+        }
+
+        layouts_ = std::move(layouts);
+        entries_ = std::move(entries);
+        return true;
+    }
+
+    const LayoutEntry *LayoutTable::find(const std::string &name, size_t &count) const
+    {
+        for (const Range &range : layouts_)
+        {
+            if (range.name == name)
+            {
+                count = range.count;
+                return entries_.data() + range.first;
+            }
+        }
+        count = 0;
+        return nullptr;
+    }
+
+} // namespace hud
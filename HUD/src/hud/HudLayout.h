@@ -0,0 +1,77 @@
+#pragma once
+#include <istream>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace hud
+{
+    // Punto de la pantalla al que se ata el mismo punto del instrumento
+    enum class Anchor
+    {
+        TopLeft, Top, TopRight,
+        Left, Center, Right,
+        BottomLeft, Bottom, BottomRight
+    };
+
+    struct LayoutEntry
+    {
+        size_t type = 0; // índice en InstrumentRegistry::types()
+        Anchor anchor = Anchor::TopLeft;
+        glm::vec2 offset = glm::vec2(0.0f); // px desde el ancla (+x derecha, +y abajo)
+        glm::vec2 size = glm::vec2(100.0f);
+        glm::vec4 color = glm::vec4(0.0f);
+        bool customColor = false; // false: color del HUD
+        bool enabled = true;
+
+        // Esquina superior izquierda para una pantalla de screen píxeles
+        glm::vec2 resolve(const glm::vec2 &screen) const;
+    };
+
+    /**
+     * @class LayoutTable
+     * @brief Layouts del HUD leídos de un archivo de texto
+     *
+     * Todas las entradas de todos los layouts van en un único vector; cada
+     * layout es un rango [first, first + count). Cambiar de layout es recorrer
+     * ese rango y fijar posición/tamaño/color/visibilidad: sin reservar
+     * memoria, sin crear instrumentos ni compilar shaders.
+     *
+     * Formato (una línea por instrumento, # comenta hasta el fin de línea):
+     *   layout NOMBRE
+     *   # tipo      ancla     dx   dy   ancho alto  [r g b a]  [on|off]
+     *   altimeter   right    -30    0   120   450
+     *   speed       left      30    0   120   450   1 0.8 0 1  off
+     *
+     * Tipos: los nombres registrados con HUD_REGISTER_INSTRUMENT (altimeter,
+     * speed, attitude, heading...). Anclas: top-left, top,
+     * top-right, left, center, right, bottom-left, bottom, bottom-right. Los
+     * instrumentos que un layout no nombra quedan ocultos.
+     */
+    class LayoutTable
+    {
+    public:
+        // Reemplazan la tabla sólo si todo el texto es válido (source: para los errores)
+        bool loadFromFile(const std::string &path);
+        bool loadFromString(const std::string &text, const std::string &source);
+
+        // Entradas del layout (nullptr si no existe)
+        const LayoutEntry *find(const std::string &name, size_t &count) const;
+        bool empty() const { return layouts_.empty(); }
+        size_t layoutCount() const { return layouts_.size(); }
+        const std::string &layoutName(size_t i) const { return layouts_[i].name; }
+
+    private:
+        bool load(std::istream &in, const std::string &path);
+
+        struct Range
+        {
+            std::string name;
+            size_t first, count;
+        };
+
+        std::vector<Range> layouts_;
+        std::vector<LayoutEntry> entries_;
+    };
+
+} // namespace hud
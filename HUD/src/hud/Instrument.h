@@ -73,6 +73,14 @@ namespace hud
         // INTERFAZ DE RENDERIZADO
         // ====================================================================
 
+        /**
+         * @brief Crea los recursos GL propios del instrumento (shaders, texturas)
+         *
+         * FlightHUD::init lo llama con el contexto activo. render() puede correr
+         * en otro hilo (ver FlightHUD::renderParallel): ahí no se toca GL.
+         */
+        virtual void init() {}
+
         /**
          * @brief Renderiza el instrumento en pantalla
          * @param renderer Renderer 2D compartido
@@ -83,7 +91,24 @@ namespace hud
          */
         virtual void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) = 0;
 
+        /**
+         * @brief Indica si el instrumento se vería igual con current que con drawn
+         * @param drawn Datos con los que se dibujó por última vez
+         * @param current Datos del frame actual
+         *
+         * FlightHUD lo usa para no redibujar el HUD cuando ningún valor cambió
+         * más que su resolución en pantalla (dígito de la lectura, fracción de
+         * píxel del tape). Por defecto false: se redibuja siempre.
+         */
+        virtual bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const
+        {
+            return false;
+        }
+
     protected:
+        // Movimiento de un tape por debajo del cual se considera la misma imagen
+        static constexpr float kSubpixelTolerance = 0.25f;
+
         // ====================================================================
         // PROPIEDADES COMUNES A TODOS LOS INSTRUMENTOS
         // ====================================================================
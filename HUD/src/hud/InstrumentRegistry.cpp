@@ -0,0 +1,122 @@
+#include "InstrumentRegistry.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace hud
+{
+    // Local estático: existe aunque el registro corra antes que los estáticos de este archivo
+    std::vector<InstrumentRegistry::TypeInfo> &InstrumentRegistry::table()
+    {
+        static std::vector<TypeInfo> types;
+        return types;
+    }
+
+    bool InstrumentRegistry::registerType(const char *name, PoolFactory makePool)
+    {
+        std::vector<TypeInfo> &types = table();
+        auto it = std::lower_bound(types.begin(), types.end(), name,
+                                   [](const TypeInfo &type, const char *n) { return std::strcmp(type.name, n) < 0; });
+        if (it != types.end() && std::strcmp(it->name, name) == 0)
+        {
+            std::cerr << "HUD instrument registered twice: " << name << std::endl;
+            return false;
+        }
+        if (types.size() == kMaxTypes)
+        {
+            std::cerr << "Too many HUD instrument types (max " << kMaxTypes << "): " << name << std::endl;
+            return false;
+        }
+        types.insert(it, TypeInfo{name, makePool});
+        return true;
+    }
+
+    int InstrumentRegistry::typeIndex(const std::string &name)
+    {
+        const std::vector<TypeInfo> &types = table();
+        for (size_t i = 0; i < types.size(); ++i)
+        {
+            if (name == types[i].name)
+                return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    std::uint32_t InstrumentRegistry::viewMask(const std::string &names)
+    {
+        if (names == "all")
+            return ~0u;
+
+        std::uint32_t mask = 0;
+        size_t begin = 0;
+        while (begin <= names.size())
+        {
+            size_t end = names.find(',', begin);
+            if (end == std::string::npos)
+                end = names.size();
+            const int type = typeIndex(names.substr(begin, end - begin));
+            if (type < 0)
+            {
+                std::cerr << "Unknown HUD instrument: " << names.substr(begin, end - begin) << std::endl;
+                return 0;
+            }
+            mask |= viewBit(static_cast<size_t>(type));
+            begin = end + 1;
+        }
+        return mask;
+    }
+
+    Instrument &InstrumentRegistry::add(size_t type)
+    {
+        if (pools_.size() < table().size())
+            pools_.resize(table().size());
+        std::unique_ptr<InstrumentPoolBase> &pool = pools_[type];
+        if (!pool)
+            pool = table()[type].makePool();
+        ++size_;
+        return pool->add();
+    }
+
+    Instrument *InstrumentRegistry::first(size_t type)
+    {
+        if (type >= pools_.size() || !pools_[type] || pools_[type]->size() == 0)
+            return nullptr;
+        return &pools_[type]->at(0);
+    }
+
+    void InstrumentRegistry::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    {
+        for (size_t type = 0; type < pools_.size(); ++type)
+        {
+            if (!pools_[type])
+                continue;
+            renderer.setViewBits(viewBit(type));
+            pools_[type]->render(renderer, flightData, 0, pools_[type]->size());
+        }
+        renderer.setViewBits(~0u);
+    }
+
+    bool InstrumentRegistry::sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current)
+    {
+        for (const auto &pool : pools_)
+        {
+            if (pool && !pool->sameDisplay(drawn, current))
+                return false;
+        }
+        return true;
+    }
+
+    void InstrumentRegistry::split(size_t blockSize, std::vector<Block> &blocks) const
+    {
+        blocks.clear();
+        for (size_t type = 0; type < pools_.size(); ++type)
+        {
+            const InstrumentPoolBase *pool = pools_[type].get();
+            if (!pool)
+                continue;
+            for (size_t first = 0; first < pool->size(); first += blockSize)
+                blocks.push_back(Block{pools_[type].get(), type, first, std::min(blockSize, pool->size() - first)});
+        }
+    }
+
+} // namespace hud
@@ -0,0 +1,192 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "Instrument.h"
+
+namespace hud
+{
+    /**
+     * @class InstrumentPoolBase
+     * @brief Todas las instancias de un tipo de instrumento
+     *
+     * Una llamada virtual por tipo y por frame (render, sameDisplay); adentro,
+     * un loop sobre objetos del mismo tipo con llamadas no virtuales.
+     */
+    class InstrumentPoolBase
+    {
+    public:
+        virtual ~InstrumentPoolBase() = default;
+
+        size_t size() const { return count_; }
+        virtual Instrument &add() = 0;
+        virtual Instrument &at(size_t i) = 0;
+
+        // Instancias [first, first + count) habilitadas
+        virtual void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData, size_t first, size_t count) = 0;
+        // true si todas las habilitadas se verían igual (ver Instrument::sameDisplay)
+        virtual bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) = 0;
+
+    protected:
+        size_t count_ = 0;
+    };
+
+    /**
+     * @class InstrumentPool
+     * @brief Instancias de T contiguas, en bloques de ~16 KB
+     *
+     * Los bloques no se mueven al crecer, así que los punteros a instrumentos
+     * son estables (el layout los guarda) y T no necesita ser movible. Las
+     * llamadas calificadas (T::render) no pasan por la vtable: como el pool
+     * se instancia en el .cpp de T (HUD_REGISTER_INSTRUMENT), el compilador
+     * ve el cuerpo y puede inlinearlo.
+     */
+    template <typename T>
+    class InstrumentPool final : public InstrumentPoolBase
+    {
+    public:
+        InstrumentPool() = default;
+        InstrumentPool(const InstrumentPool &) = delete;
+        InstrumentPool &operator=(const InstrumentPool &) = delete;
+
+        ~InstrumentPool() override
+        {
+            for (size_t i = 0; i < count_; ++i)
+                item(i).~T();
+        }
+
+        Instrument &add() override
+        {
+            if (count_ == chunks_.size() * kChunk)
+                chunks_.push_back(std::make_unique<Slot[]>(kChunk));
+            T *instrument = new (chunks_[count_ / kChunk][count_ % kChunk].bytes) T();
+            ++count_;
+            return *instrument;
+        }
+
+        Instrument &at(size_t i) override { return item(i); }
+
+        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData, size_t first, size_t count) override
+        {
+            for (size_t i = first; i < first + count; ++i)
+            {
+                T &instrument = item(i);
+                if (instrument.isEnabled())
+                    instrument.T::render(renderer, flightData);
+            }
+        }
+
+        bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) override
+        {
+            for (size_t i = 0; i < count_; ++i)
+            {
+                const T &instrument = item(i);
+                if (instrument.isEnabled() && !instrument.T::sameDisplay(drawn, current))
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+        struct Slot
+        {
+            alignas(T) unsigned char bytes[sizeof(T)];
+        };
+        static constexpr size_t kChunk = sizeof(T) >= 16384 ? 1 : 16384 / sizeof(T);
+
+        T &item(size_t i) { return *std::launder(reinterpret_cast<T *>(chunks_[i / kChunk][i % kChunk].bytes)); }
+
+        std::vector<std::unique_ptr<Slot[]>> chunks_;
+    };
+
+    /**
+     * @class InstrumentRegistry
+     * @brief Instrumentos del HUD agrupados por tipo
+     *
+     * Cada tipo se registra desde su propio .cpp con HUD_REGISTER_INSTRUMENT
+     * y un nombre (el que usan los archivos de layout). Agregar un instrumento
+     * no toca FlightHUD: se registra, y FlightHUD crea uno de cada tipo.
+     *
+     * Orden: render() recorre los tipos por nombre y, dentro de cada tipo, las
+     * instancias en orden de creación. Lo que deba quedar encima de otro
+     * instrumento va en una capa mayor (Renderer2D::setLayer).
+     *
+     * Vistas: render() graba cada tipo con su bit (viewBit) como grupo del
+     * Renderer2D, así una vista elige qué tipos muestra con una máscara de
+     * hasta kMaxTypes bits.
+     */
+    class InstrumentRegistry
+    {
+    public:
+        using PoolFactory = std::unique_ptr<InstrumentPoolBase> (*)();
+
+        struct TypeInfo
+        {
+            const char *name;
+            PoolFactory makePool;
+        };
+
+        // Tipos registrados, ordenados por nombre (fijos desde que arranca main)
+        static const std::vector<TypeInfo> &types() { return table(); }
+        static int typeIndex(const std::string &name); // -1 si no está registrado
+        static bool registerType(const char *name, PoolFactory makePool);
+
+        static constexpr size_t kMaxTypes = 32; // un bit por tipo en las máscaras de vista
+        static std::uint32_t viewBit(size_t type) { return 1u << type; }
+        static std::uint32_t viewMask(const std::string &names); // "a,b,c" o "all"; 0 si un nombre no existe
+
+        InstrumentRegistry() = default;
+        InstrumentRegistry(const InstrumentRegistry &) = delete;
+        InstrumentRegistry &operator=(const InstrumentRegistry &) = delete;
+
+        // Nueva instancia del tipo (índice de types()); la referencia es estable
+        Instrument &add(size_t type);
+        Instrument *first(size_t type); // la primera instancia del tipo o nullptr
+        size_t size() const { return size_; }
+
+        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData);
+        bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current);
+
+        template <typename F>
+        void forEach(F &&f)
+        {
+            for (const auto &pool : pools_)
+            {
+                if (!pool)
+                    continue;
+                for (size_t i = 0; i < pool->size(); ++i)
+                    f(pool->at(i));
+            }
+        }
+
+        // Tramos de a lo sumo blockSize instancias de un mismo tipo, en el
+        // orden de render() (para repartir la grabación entre hilos)
+        struct Block
+        {
+            InstrumentPoolBase *pool;
+            size_t type; // índice de types()
+            size_t first, count;
+        };
+        void split(size_t blockSize, std::vector<Block> &blocks) const;
+
+    private:
+        static std::vector<TypeInfo> &table();
+
+        std::vector<std::unique_ptr<InstrumentPoolBase>> pools_; // por tipo; nulo sin instancias
+        size_t size_ = 0;
+    };
+
+    template <typename T>
+    std::unique_ptr<InstrumentPoolBase> makeInstrumentPool()
+    {
+        return std::make_unique<InstrumentPool<T>>();
+    }
+
+} // namespace hud
+
+// Registra Type con su nombre de archivo de layout (en el .cpp del instrumento, dentro de namespace hud)
+#define HUD_REGISTER_INSTRUMENT(Type, name) \
+    [[maybe_unused]] static const bool Type##Registered_ = ::hud::InstrumentRegistry::registerType(name, &::hud::makeInstrumentPool<Type>)
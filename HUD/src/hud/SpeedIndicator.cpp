@@ -1,4 +1,7 @@
 #include "SpeedIndicator.h"
+#include "InstrumentRegistry.h"
+#include "../flight/InstrumentHistory.h"
+#include <algorithm>
 #include <cmath>
 
 namespace hud
@@ -7,7 +10,7 @@ namespace hud
     // CONFIGURACIÓN DE LA ESCALA DEL TAPE
     // ============================================================================
 
-    static const float SPEED_STEP = 10.0f;      // Marcas cada 10 nudos
+    static constexpr flight::units::Knots SPEED_STEP{10.0f}; // Marcas cada 10 nudos
     static const float PIXELS_PER_STEP = 30.0f; // Separación vertical entre marcas
     static const int VISIBLE_MARKS = 12;        // Cuántas marcas mostrar arriba/abajo
 
@@ -19,6 +22,19 @@ namespace hud
     static const float CHEVRON_WIDTH = 10.0f;
     static const float CHEVRON_HEIGHT = 12.0f;
 
+    // Flecha de tendencia
+    static const float TREND_SECONDS = 10.0f;  // horizonte de la predicción
+    static const float TREND_MIN_PIXELS = 6.0f; // más corta no se dibuja (2 kt)
+    static const float TREND_X = 8.0f;          // desde el borde izquierdo, junto a las marcas
+    static const float TREND_HEAD = 4.0f;
+
+    // Lectura de la caja: nudos enteros, no negativa
+    static int readoutSpeed(flight::units::Knots airspeed)
+    {
+        const int display = (int)round(airspeed.value());
+        return display < 0 ? 0 : display;
+    }
+
     SpeedIndicator::SpeedIndicator() : Instrument()
     {
         // Configuración específica del indicador de velocidad
@@ -36,31 +52,70 @@ namespace hud
         if (!enabled_)
             return;
 
-        float airspeed = flightData.airspeed;
+        const flight::units::Knots airspeed = flightData.airspeed;
 
+        drawnTrend_ = trendPixels(flightData);
         drawSpeedTape(renderer, airspeed);
         drawCurrentSpeedBox(renderer, airspeed);
     }
 
+    bool SpeedIndicator::sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const
+    {
+        // El tape se corre PIXELS_PER_STEP por SPEED_STEP; la caja, por nudo entero
+        const float tapeShift = std::abs(current.airspeed.value() - drawn.airspeed.value()) *
+                                PIXELS_PER_STEP / SPEED_STEP.value();
+        return tapeShift < kSubpixelTolerance && readoutSpeed(current.airspeed) == readoutSpeed(drawn.airspeed) &&
+               std::abs(trendPixels(current) - drawnTrend_) < kSubpixelTolerance;
+    }
+
+    /**
+     * @brief Largo de la flecha de tendencia en px (hacia arriba positivo)
+     *
+     * La aceleración es la derivada media de la ventana de la historia (O(1):
+     * ya viene calculada en la muestra). Sin historia o por debajo de
+     * TREND_MIN_PIXELS no hay flecha.
+     */
+    float SpeedIndicator::trendPixels(const flight::FlightData &flightData) const
+    {
+        flight::TrendSample trend;
+        if (!flightData.history || !flightData.history->latest(trend))
+            return 0.0f;
+        const float knots = trend.rateOf(flight::TrendChannel::Airspeed) * TREND_SECONDS;
+        const float pixels = knots * PIXELS_PER_STEP / SPEED_STEP.value();
+        if (std::abs(pixels) < TREND_MIN_PIXELS)
+            return 0.0f;
+        const float limit = size_.y * 0.5f - TREND_HEAD;
+        return std::clamp(pixels, -limit, limit);
+    }
+
     // ============================================================================
     // RENDERIZADO DEL TAPE DE VELOCIDAD
     // ============================================================================
 
-    void SpeedIndicator::drawSpeedTape(gfx::Renderer2D &renderer, float airspeed)
+    void SpeedIndicator::drawSpeedTape(gfx::Renderer2D &renderer, flight::units::Knots airspeed)
     {
         // Calcular centro vertical del instrumento (heredado de Instrument)
         float centerY = position_.y + size_.y * 0.5f;
         float ticksX = position_.x + 15.0f; // Columna de ticks a la izquierda
 
         // Calcular desplazamiento del tape
-        float baseSpeed = floor(airspeed / SPEED_STEP) * SPEED_STEP;
+        const flight::units::Knots baseSpeed = floor(airspeed / SPEED_STEP) * SPEED_STEP;
         float fraction = (airspeed - baseSpeed) / SPEED_STEP;
         float scrollOffset = fraction * PIXELS_PER_STEP;
 
-        // Dibujar marcas de velocidad visibles
+        // Recorte en GPU: dentro del instrumento y fuera de la caja de lectura
+        const float boxTop = centerY - READOUT_BOX_HEIGHT * 0.5f;
+        const float boxBottom = centerY + READOUT_BOX_HEIGHT * 0.5f;
+        renderer.pushClipRect(position_, size_);
+        renderer.beginClipMask();
+        renderer.drawRect(position_, glm::vec2(size_.x, boxTop - position_.y), color_, true);
+        renderer.drawRect(glm::vec2(position_.x, boxBottom), glm::vec2(size_.x, position_.y + size_.y - boxBottom), color_, true);
+        renderer.endClipMask();
+
+        // Dibujar el tape completo (la GPU recorta)
         for (int i = -VISIBLE_MARKS; i <= VISIBLE_MARKS; ++i)
         {
-            int markSpeed = (int)baseSpeed + i * (int)SPEED_STEP;
+            int markSpeed = (int)baseSpeed.value() + i * (int)SPEED_STEP.value();
             
             // Saltar velocidades negativas
             if (markSpeed < 0)
@@ -68,17 +123,6 @@ namespace hud
 
             float markY = centerY + scrollOffset - i * PIXELS_PER_STEP;
 
-            // Culling de marcas fuera del área visible
-            const float CULLING_MARGIN = 30.0f;
-            if (markY < position_.y - CULLING_MARGIN || markY > position_.y + size_.y + CULLING_MARGIN)
-                continue;
-
-            // Saltar marcas dentro de la caja de lectura
-            bool insideReadoutBox = (markY > centerY - READOUT_BOX_HEIGHT * 0.5f &&
-                                     markY < centerY + READOUT_BOX_HEIGHT * 0.5f);
-            if (insideReadoutBox)
-                continue;
-
             // Dibujar tick
             renderer.drawRect(
                 glm::vec2(ticksX, markY - 0.5f),
@@ -94,13 +138,28 @@ namespace hud
                 drawSpeedNumber(renderer, markSpeed, numberPos);
             }
         }
+
+        // Tendencia: desde la referencia hasta la velocidad en TREND_SECONDS
+        // (dentro de la máscara: la caja de lectura tapa el tramo inicial)
+        if (drawnTrend_ != 0.0f)
+        {
+            const float x = position_.x + TREND_X;
+            const float tipY = centerY - drawnTrend_;
+            const float back = drawnTrend_ > 0.0f ? TREND_HEAD : -TREND_HEAD;
+            renderer.drawLine(glm::vec2(x, centerY), glm::vec2(x, tipY), color_, 2.0f);
+            renderer.drawLine(glm::vec2(x - TREND_HEAD, tipY + back), glm::vec2(x, tipY), color_, 2.0f);
+            renderer.drawLine(glm::vec2(x + TREND_HEAD, tipY + back), glm::vec2(x, tipY), color_, 2.0f);
+        }
+
+        renderer.popClipMask();
+        renderer.popClipRect();
     }
 
     // ============================================================================
     // CAJA DE LECTURA DIGITAL (CENTRO)
     // ============================================================================
 
-    void SpeedIndicator::drawCurrentSpeedBox(gfx::Renderer2D &renderer, float airspeed)
+    void SpeedIndicator::drawCurrentSpeedBox(gfx::Renderer2D &renderer, flight::units::Knots airspeed)
     {
         float centerY = position_.y + size_.y * 0.5f;
 
@@ -135,9 +194,7 @@ namespace hud
             color_, 2.0f);
 
         // Mostrar velocidad actual redondeada
-        int displaySpeed = (int)round(airspeed);
-        if (displaySpeed < 0)
-            displaySpeed = 0;
+        int displaySpeed = readoutSpeed(airspeed);
 
         // Dibujar el número centrado
         glm::vec2 numberPos = glm::vec2(boxX + READOUT_BOX_WIDTH * 0.5f, centerY);
@@ -177,4 +234,6 @@ namespace hud
         }
     }
 
+    HUD_REGISTER_INSTRUMENT(SpeedIndicator, "speed");
+
 } // namespace hud
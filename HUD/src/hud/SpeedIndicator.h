@@ -14,6 +14,8 @@ namespace hud
      * - Tape vertical con escala de velocidad móvil
      * - Caja de lectura digital central
      * - Marcas cada 10 nudos con números cada 20 nudos
+     * - Flecha de tendencia: la velocidad dentro de 10 s con la aceleración
+     *   media de la ventana de FlightData::history
      */
     class SpeedIndicator : public Instrument
     {
@@ -26,12 +28,16 @@ namespace hud
          * @param flightData Datos del vuelo (especialmente airspeed)
          */
         void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const override;
 
     private:
         // Métodos específicos del indicador de velocidad
-        void drawSpeedTape(gfx::Renderer2D &renderer, float airspeed);
-        void drawCurrentSpeedBox(gfx::Renderer2D &renderer, float airspeed);
+        void drawSpeedTape(gfx::Renderer2D &renderer, flight::units::Knots airspeed);
+        void drawCurrentSpeedBox(gfx::Renderer2D &renderer, flight::units::Knots airspeed);
         void drawSpeedNumber(gfx::Renderer2D &renderer, int speed, const glm::vec2 &position);
+        float trendPixels(const flight::FlightData &flightData) const;
+
+        float drawnTrend_ = 0.0f; // px de la última flecha dibujada (0 = sin flecha)
     };
 
 } // namespace hud
@@ -0,0 +1,194 @@
+#include "VerticalSpeedIndicator.h"
+#include "InstrumentRegistry.h"
+#include "../flight/InstrumentHistory.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace hud
+{
+    // ============================================================================
+    // CONFIGURACIÓN DE LA ESCALA
+    // ============================================================================
+
+    static const float LINEAR_LIMIT = 2000.0f;  // ft/min en la parte lineal
+    static const float LINEAR_SHARE = 0.75f;    // de la media altura
+    static const float FULL_SCALE = 6000.0f;    // ft/min en el extremo
+    static const float MARKS[] = {500.0f, 1000.0f, 1500.0f, 2000.0f, 4000.0f, 6000.0f};
+
+    // Configuración visual
+    static const float READOUT_SPACE = 20.0f;   // arriba y abajo de la escala
+    static const float LABEL_X = 2.0f;          // rótulos (miles) desde el borde izquierdo
+    static const float SCALE_X = 12.0f;         // columna de marcas
+    static const float MAJOR_TICK = 12.0f;      // 0, 1000, 2000, 6000
+    static const float MINOR_TICK = 6.0f;
+    static const float BAR_X = 20.0f;
+    static const float BAR_WIDTH = 4.0f;
+    static const float BRACKET_X = 30.0f;
+    static const float BRACKET_CAP = 4.0f;
+    static const float MIN_BRACKET = 100.0f;    // ft/min: un rango menor no se muestra
+    static const float READOUT_THRESHOLD = 400.0f;
+    static const float DIGIT_WIDTH = 7.0f;
+    static const float DIGIT_HEIGHT = 10.0f;
+    static const float DIGIT_SPACING = 9.0f;
+    static const float SEGMENT = 1.5f;
+
+    // Lectura: centenas de ft/min, sin signo (el lado indica el sentido); 0 = oculta
+    static int readoutVerticalSpeed(flight::units::FeetPerMinute verticalSpeed)
+    {
+        const float v = verticalSpeed.value();
+        if (std::abs(v) < READOUT_THRESHOLD)
+            return 0;
+        return (int)round(std::abs(v) / 100.0f) * 100;
+    }
+
+    // Segmentos a..g (bit 0 = a) de los dígitos
+    static const int DIGIT_SEGMENTS[10] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F};
+
+    static void drawDigit(gfx::Renderer2D &renderer, int digit, const glm::vec2 &pos, const glm::vec4 &color)
+    {
+        const float w = DIGIT_WIDTH, h = DIGIT_HEIGHT, t = SEGMENT, halfH = h * 0.5f;
+        const int mask = DIGIT_SEGMENTS[digit];
+        if (mask & 0x01) // a - arriba
+            renderer.drawRect(pos + glm::vec2(t, 0.0f), glm::vec2(w - 2 * t, t), color, true);
+        if (mask & 0x02) // b - arriba derecha
+            renderer.drawRect(pos + glm::vec2(w - t, t), glm::vec2(t, halfH - t), color, true);
+        if (mask & 0x04) // c - abajo derecha
+            renderer.drawRect(pos + glm::vec2(w - t, halfH), glm::vec2(t, halfH - t), color, true);
+        if (mask & 0x08) // d - abajo
+            renderer.drawRect(pos + glm::vec2(t, h - t), glm::vec2(w - 2 * t, t), color, true);
+        if (mask & 0x10) // e - abajo izquierda
+            renderer.drawRect(pos + glm::vec2(0.0f, halfH), glm::vec2(t, halfH - t), color, true);
+        if (mask & 0x20) // f - arriba izquierda
+            renderer.drawRect(pos + glm::vec2(0.0f, t), glm::vec2(t, halfH - t), color, true);
+        if (mask & 0x40) // g - medio
+            renderer.drawRect(pos + glm::vec2(t, halfH - t * 0.5f), glm::vec2(w - 2 * t, t), color, true);
+    }
+
+    VerticalSpeedIndicator::VerticalSpeedIndicator() : Instrument()
+    {
+        // Configuración específica del variómetro
+        size_ = glm::vec2(50.0f, 300.0f);
+        color_ = glm::vec4(0.0f, 1.0f, 0.4f, 0.95f); // Verde HUD
+    }
+
+    // ============================================================================
+    // FUNCIÓN PRINCIPAL DE RENDERIZADO
+    // ============================================================================
+
+    void VerticalSpeedIndicator::render(gfx::Renderer2D &renderer, const flight::FlightData &flightData)
+    {
+        const float verticalSpeed = flightData.verticalSpeed.value();
+        const float zeroY = scaleY(0.0f);
+
+        drawScale(renderer);
+
+        // Barra desde 0 hasta el valor actual
+        const float valueY = scaleY(verticalSpeed);
+        renderer.drawRect(glm::vec2(position_.x + BAR_X, std::min(zeroY, valueY)),
+                          glm::vec2(BAR_WIDTH, std::abs(valueY - zeroY)), color_, true);
+        renderer.drawRect(glm::vec2(position_.x + BAR_X - 2.0f, valueY - 1.0f), glm::vec2(BAR_WIDTH + 4.0f, 2.0f), color_, true);
+
+        // Corchete: mínimo y máximo de la ventana
+        float low, high;
+        drawnBracket_ = windowRange(flightData, low, high);
+        if (drawnBracket_)
+        {
+            drawnLowY_ = scaleY(low);
+            drawnHighY_ = scaleY(high);
+            const float x = position_.x + BRACKET_X;
+            renderer.drawLine(glm::vec2(x, drawnHighY_), glm::vec2(x, drawnLowY_), color_, 1.0f);
+            renderer.drawLine(glm::vec2(x - BRACKET_CAP, drawnHighY_), glm::vec2(x, drawnHighY_), color_, 1.0f);
+            renderer.drawLine(glm::vec2(x - BRACKET_CAP, drawnLowY_), glm::vec2(x, drawnLowY_), color_, 1.0f);
+        }
+
+        // Lectura arriba al subir, abajo al bajar
+        const int readout = readoutVerticalSpeed(flightData.verticalSpeed);
+        if (readout > 0)
+        {
+            const float top = verticalSpeed > 0.0f ? position_.y + (READOUT_SPACE - DIGIT_HEIGHT) * 0.5f
+                                                   : position_.y + size_.y - (READOUT_SPACE + DIGIT_HEIGHT) * 0.5f;
+            drawReadout(renderer, readout, top);
+        }
+    }
+
+    bool VerticalSpeedIndicator::sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const
+    {
+        // La barra se mueve por la escala (no lineal); la lectura, de a 100 ft/min
+        const float barShift = std::abs(scaleY(current.verticalSpeed.value()) - scaleY(drawn.verticalSpeed.value()));
+        if (barShift >= kSubpixelTolerance ||
+            readoutVerticalSpeed(current.verticalSpeed) != readoutVerticalSpeed(drawn.verticalSpeed))
+            return false;
+        if ((current.verticalSpeed.value() > 0.0f) != (drawn.verticalSpeed.value() > 0.0f))
+            return false;
+
+        // El corchete sale de la historia, no de drawn: se compara con lo dibujado
+        float low, high;
+        const bool hasRange = windowRange(current, low, high);
+        if (hasRange != drawnBracket_)
+            return false;
+        return !hasRange || (std::abs(scaleY(low) - drawnLowY_) < kSubpixelTolerance &&
+                             std::abs(scaleY(high) - drawnHighY_) < kSubpixelTolerance);
+    }
+
+    // ============================================================================
+    // ESCALA
+    // ============================================================================
+
+    float VerticalSpeedIndicator::scaleY(float feetPerMinute) const
+    {
+        const float halfHeight = size_.y * 0.5f - READOUT_SPACE;
+        const float v = std::min(std::abs(feetPerMinute), FULL_SCALE);
+        const float share = v <= LINEAR_LIMIT
+                                ? LINEAR_SHARE * v / LINEAR_LIMIT
+                                : LINEAR_SHARE + (1.0f - LINEAR_SHARE) * (v - LINEAR_LIMIT) / (FULL_SCALE - LINEAR_LIMIT);
+        const float centerY = position_.y + size_.y * 0.5f;
+        return centerY - (feetPerMinute < 0.0f ? -share : share) * halfHeight;
+    }
+
+    bool VerticalSpeedIndicator::windowRange(const flight::FlightData &flightData, float &low, float &high) const
+    {
+        flight::TrendSample trend;
+        if (!flightData.history || !flightData.history->latest(trend))
+            return false;
+        low = trend.minOf(flight::TrendChannel::VerticalSpeed);
+        high = trend.maxOf(flight::TrendChannel::VerticalSpeed);
+        return high - low >= MIN_BRACKET;
+    }
+
+    void VerticalSpeedIndicator::drawScale(gfx::Renderer2D &renderer)
+    {
+        const float x = position_.x + SCALE_X;
+
+        // Cero: marca larga doble
+        renderer.drawRect(glm::vec2(x, scaleY(0.0f) - 1.0f), glm::vec2(MAJOR_TICK, 2.0f), color_, true);
+
+        for (float mark : MARKS)
+        {
+            const int thousands = (int)(mark / 1000.0f);
+            const bool major = mark == 1000.0f || mark == 2000.0f || mark == 6000.0f;
+            const float length = major ? MAJOR_TICK : MINOR_TICK;
+            for (float sign : {1.0f, -1.0f})
+            {
+                const float y = scaleY(sign * mark);
+                renderer.drawRect(glm::vec2(x, y - 0.5f), glm::vec2(length, 1.0f), color_, true);
+
+                // Rótulo en miles a la izquierda de las marcas mayores
+                if (major)
+                    drawDigit(renderer, thousands, glm::vec2(position_.x + LABEL_X, floor(y - DIGIT_HEIGHT * 0.5f) + 0.5f), color_);
+            }
+        }
+    }
+
+    void VerticalSpeedIndicator::drawReadout(gfx::Renderer2D &renderer, int feetPerMinute, float top)
+    {
+        const std::string text = std::to_string(feetPerMinute);
+        const float totalWidth = text.length() * DIGIT_SPACING - (DIGIT_SPACING - DIGIT_WIDTH);
+        const float startX = position_.x + size_.x * 0.5f - totalWidth * 0.5f;
+        for (size_t i = 0; i < text.length(); ++i)
+            drawDigit(renderer, text[i] - '0', glm::vec2(floor(startX + i * DIGIT_SPACING) + 0.5f, floor(top) + 0.5f), color_);
+    }
+
+    HUD_REGISTER_INSTRUMENT(VerticalSpeedIndicator, "vsi");
+
+} // namespace hud
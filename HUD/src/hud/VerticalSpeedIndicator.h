@@ -0,0 +1,44 @@
+#pragma once
+#include "Instrument.h"
+
+namespace hud
+{
+    /**
+     * @class VerticalSpeedIndicator
+     * @brief Variómetro: escala vertical de velocidad vertical (ft/min)
+     *
+     * Escala no lineal como en los PFD: ±2000 ft/min ocupan tres cuartos de la
+     * altura y hasta ±6000 el cuarto restante. Muestra:
+     * - Barra desde 0 hasta la velocidad vertical actual
+     * - Corchete con el mínimo y máximo de la ventana de InstrumentHistory
+     *   (qué tan estable viene el ascenso/descenso)
+     * - Lectura redondeada a 100 ft/min arriba (ascenso) o abajo (descenso)
+     *   a partir de ±400 ft/min
+     *
+     * Sin FlightData::history no hay corchete; el resto sale del FlightData.
+     */
+    class VerticalSpeedIndicator : public Instrument
+    {
+    public:
+        VerticalSpeedIndicator();
+
+        /**
+         * @brief Renderiza la escala, la barra, el corchete y la lectura
+         * @param renderer Renderer 2D compartido
+         * @param flightData Datos del vuelo (verticalSpeed, history)
+         */
+        void render(gfx::Renderer2D &renderer, const flight::FlightData &flightData) override;
+        bool sameDisplay(const flight::FlightData &drawn, const flight::FlightData &current) const override;
+
+    private:
+        float scaleY(float feetPerMinute) const; // posición en pantalla de un valor
+        bool windowRange(const flight::FlightData &flightData, float &low, float &high) const;
+        void drawScale(gfx::Renderer2D &renderer);
+        void drawReadout(gfx::Renderer2D &renderer, int feetPerMinute, float top);
+
+        // Lo último dibujado del corchete (y en px)
+        bool drawnBracket_ = false;
+        float drawnLowY_ = 0.0f, drawnHighY_ = 0.0f;
+    };
+
+} // namespace hud
@@ -6,8 +6,14 @@
  * - Terreno con texturizado triplanar y niebla
  * - Skybox para cielo envolvente
  * - HUD con altímetro de 7 segmentos
- * - Sistema de cámara libre tipo FPS
- * - Física básica de vuelo
+ * - Cámara libre con actitud en quaternion (alabeo completo y loops)
+ * - Modelo de vuelo 6-DOF a paso fijo (tecla P o --physics)
+ * - Simulación en hilo propio con handoff lock-free al render
+ * - Modo headless (--headless) para benchmarks y pruebas en servidores
+ * - Grabación/reproducción determinista de la cámara (--record/--replay)
+ * - Log de telemetría mapeado en memoria (--telemetry)
+ * - HUD alimentado por un log o un socket local (--telemetry-replay/--telemetry-listen)
+ * - Benchmarks de CPU sin ventana (--bench)
  */
 
 extern "C"
@@ -16,7 +22,17 @@ extern "C"
 #include <GLFW/glfw3.h>
 }
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -24,8 +40,25 @@ extern "C"
 #include "gfx/TextureCube.h"
 #include "gfx/SimpleCube.h"
 #include "gfx/TerrainRenderer.h"
+#include "gfx/RenderQueue.h"
+#include "gfx/GLState.h"
+#include "gfx/Framebuffer.h"
+#include "gfx/HeadlessContext.h"
 #include "hud/FlightHUD.h"
+#include "hud/InstrumentRegistry.h"
+#include "flight/AirData.h"
+#include "flight/CameraAttitude.h"
 #include "flight/FlightData.h"
+#include "flight/FlightDynamics.h"
+#include "flight/Heightfield.h"
+#include "flight/InstrumentHistory.h"
+#include "flight/SimulationThread.h"
+#include "util/CameraPath.h"
+#include "util/CameraRecording.h"
+#include "util/Benchmarks.h"
+#include "util/ImageWriter.h"
+#include "util/TelemetryLog.h"
+#include "util/TelemetrySource.h"
 
 // ============================================================================
 // CONSTANTES DE CONFIGURACIÓN
@@ -41,21 +74,44 @@ static const float kGroundLevel = 1.8f;
 // Velocidad de movimiento de la cámara (m/s)
 static const float kCameraSpeed = 10.0f;
 
-// Sensibilidad del mouse para rotación de cámara
+// Sensibilidad del mouse para rotación de cámara (grados por píxel)
 static const float kMouseSensitivity = 0.1f;
 
+// Velocidad de alabeo de la cámara libre con Z/C (grados/s)
+static const float kCameraRollRate = 90.0f;
+
+// Pre-pass de profundidad antes del sombreado caro del terreno
+static const bool kDepthPrepass = true;
+
+// Reporte periódico de estadísticas de render (fragmentos del skybox, draw calls)
+static const bool kReportRenderStats = true;
+static const float kReportIntervalSec = 2.0f;
+
+// Modo física: velocidad y altura mínima al entrar (m/s, m)
+static const float kPhysicsStartSpeed = 55.0f;
+static const float kPhysicsStartAltitude = 150.0f;
+
+// Tasa fija del hilo de simulación (Hz)
+static const float kSimRateHz = 240.0f;
+
+// Posición del cubo de referencia
+static const glm::vec3 kCubePosition = glm::vec3(0.0f, 0.0f, 5.0f);
+
+// Pantallas extra del HUD (--hud-view): margen alrededor de sus instrumentos
+// y, en headless, alto de cada recuadro como fracción del frame
+static const float kHudViewMargin = 16.0f;
+static const float kHudInsetFraction = 0.25f;
+
 // ============================================================================
 // ESTADO GLOBAL DE LA CÁMARA
 // ============================================================================
 
 // Posición inicial: en el piso (Y=1.8m = altitud 0 pies)
 glm::vec3 cameraPos = glm::vec3(0.0f, kGroundLevel, 0.0f);
-glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f); // Mirando hacia -Z
-glm::vec3 cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);	  // Eje Y arriba
 
-// Ángulos de Euler para rotación de cámara
-float yaw = -90.0f; // Inicializado hacia -Z
-float pitch = 0.0f; // Mirando al horizonte
+// Orientación (quaternion) con la base front/up/right cacheada.
+// Identidad: mirando hacia -Z, alas niveladas
+flight::CameraAttitude cameraAttitude;
 
 // Mouse state para cálculo de delta
 float lastX = kWindowWidth / 2.0f;
@@ -74,8 +130,82 @@ float lastFrame = 0.0f; // Timestamp del frame anterior
 // ============================================================================
 
 flight::FlightData flightData;		 // Datos del avión (velocidad, altitud, etc.)
+flight::FlightDynamics dynamics;	 // Modelo 6-DOF (activo sólo en modo física)
+flight::ControlInputs controls;		 // Mandos del modo física
+flight::AirData airData;			 // Atmósfera ISA y viento (IAS y altitud barométrica)
+flight::Heightfield terrainHeights;	 // Relieve: colisión, radioaltímetro y malla del terreno
+flight::InstrumentHistory instrumentHistory; // Tendencias y VSI: la escribe quien produce FlightData
+bool physicsMode = false;			 // false: cámara libre, true: la cámara sigue al avión
 hud::FlightHUD *globalHUD = nullptr; // Puntero global al HUD (para callbacks)
 
+// Con datos externos (log o socket) no hay cámara libre ni física: la vista sigue al avión
+bool telemetryDriven = false;
+util::TelemetryPlayback *telemetryPlayback = nullptr; // controles de reproducción (flechas/espacio)
+
+// ============================================================================
+// OPCIONES DE LÍNEA DE COMANDOS Y ESCENA
+// ============================================================================
+
+struct AppOptions
+{
+	bool headless = false;
+	bool physics = false;	   // arrancar en modo física
+	bool serialSim = false;	   // simular en el hilo de render (sin hilo propio)
+	int width = kWindowWidth;
+	int height = kWindowHeight;
+	int frames = 600;		   // headless: cantidad de frames a renderizar
+	float fps = 60.0f;		   // headless: paso fijo = 1/fps
+	int dumpEvery = 0;		   // headless: guardar PPM cada N frames (0 = nunca)
+	std::string pathFile;	   // headless: recorrido de cámara (vacío = por defecto)
+	std::string outDir = "headless_out";
+	std::string recordFile;	   // grabar la pose de cámara de cada frame
+	std::string replayFile;	   // reproducir una grabación con paso fijo
+	std::string telemetryFile; // log de telemetría (FlightData por tick/frame)
+	std::string telemetryReplayFile; // HUD desde un log de telemetría
+	std::string telemetryListen;	 // HUD desde un socket (udp:PUERTO | unix:RUTA)
+	std::string telemetrySend;		 // emisor de prueba hacia ese endpoint y salir
+	double playbackSpeed = 1.0;		 // reproducción/emisión: velocidad relativa
+	float windFrom = 0.0f;			 // grados, de dónde viene el viento a 600 m
+	float windSpeed = 0.0f;			 // kt a 600 m (0 = calma)
+	float qnh = 1013.25f;			 // hPa: presión al nivel del mar y ajuste del altímetro
+	float terrainRelief = flight::HeightfieldConfig{}.relief; // m (0 = terreno plano)
+	float hudRate = -1.0f;			 // HUD a textura: redibujos/s como máximo (0 = sin tope, <0 = directo)
+	bool hudOnChange = false;		 // HUD a textura: redibujar sólo si cambia un valor visible
+	std::string hudLayouts = "layouts/hud.layout"; // layouts del HUD (recarga en caliente)
+	std::vector<gfx::Renderer2D::View> hudViews;	 // pantallas extra del HUD (--hud-view)
+	std::string bench;		   // benchmark de CPU a correr (sin OpenGL)
+	util::BenchOptions benchOptions;
+};
+
+/**
+ * @brief Todos los objetos de render del frame (deben vivir mientras el contexto GL)
+ */
+struct Scene
+{
+	gfx::TextureCube cubemap;		  // Textura del skybox (6 caras)
+	gfx::SkyboxRenderer skybox;		  // Renderizador del cielo
+	gfx::SimpleCube cube;			  // Cubos de referencia
+	gfx::TerrainRenderer terrain;	  // Renderizador del terreno
+	gfx::TerrainParams terrainParams; // Parámetros del terreno
+	gfx::RenderQueue renderQueue;	  // Orden de draw calls 3D
+	hud::FlightHUD flightHUD;		  // Sistema de HUD
+	bool measureCubeSky = false;	  // próximo frame: medir también el skybox anterior
+	GLuint cubeSkyFragments = 0;	  // fragmentos del skybox anterior (última medición)
+};
+
+/**
+ * @brief Pantalla extra del HUD: ventana propia con contexto compartido con la principal
+ *
+ * Comparte VBO/EBO, texturas y shaders con el contexto principal: el HUD se
+ * graba y se sube una vez por frame y cada pantalla sólo emite draw calls.
+ */
+struct HudScreen
+{
+	GLFWwindow *window = nullptr;
+	gfx::GLState glState;		// sombra del estado GL de este contexto
+	gfx::Renderer2D::View view; // región (ancho 0 = caja de sus instrumentos) y máscara
+};
+
 // ============================================================================
 // DECLARACIÓN DE FUNCIONES
 // ============================================================================
@@ -85,6 +215,31 @@ void mouse_callback(GLFWwindow *window, double xpos, double ypos);
 void processInput(GLFWwindow *window);
 void print_gl_version(void);
 
+static bool parseArgs(int argc, char **argv, AppOptions &opt);
+static void configureAirData(const AppOptions &opt);
+static void configureTerrain(const AppOptions &opt);
+static void configureHud(hud::FlightHUD &hud, const AppOptions &opt);
+static void applyCameraPose(const util::CameraPose &pose);
+static void setPhysicsMode(bool enabled);
+static void updateFlight(float dt);
+static void followAircraft(const flight::FlightData &data);
+static flight::SimInput makeSimInput(double time);
+static void hashFlightData(util::Digest &digest, const flight::FlightData &data);
+static bool initScene(Scene &scene, int width, int height);
+static void renderScene(Scene &scene, int width, int height, const flight::FlightData &data);
+static void reportRenderStats(Scene &scene, int width, int height);
+static bool parseHudView(const std::string &spec, gfx::Renderer2D::View &view);
+static glm::vec4 hudViewRegion(hud::FlightHUD &hud, const gfx::Renderer2D::View &view, int canvasWidth,
+							   int canvasHeight, int width, int height);
+static bool openHudScreens(GLFWwindow *mainWindow, Scene &scene, const AppOptions &opt,
+						   std::vector<std::unique_ptr<HudScreen>> &screens);
+static void renderHudScreens(GLFWwindow *mainWindow, Scene &scene, const AppOptions &opt,
+							 std::vector<std::unique_ptr<HudScreen>> &screens);
+static void closeHudScreen(GLFWwindow *mainWindow, Scene &scene, HudScreen &screen);
+static void drawHudInsets(Scene &scene, const AppOptions &opt);
+static int runInteractive(const AppOptions &opt);
+static int runHeadless(const AppOptions &opt);
+
 // ============================================================================
 // FUNCIÓN PRINCIPAL
 // ============================================================================
@@ -92,10 +247,73 @@ void print_gl_version(void);
 /**
  * @brief Punto de entrada del programa
  *
- * Inicializa todos los sistemas (ventana, OpenGL, recursos gráficos)
- * y ejecuta el loop principal de renderizado.
+ * Sin argumentos abre la ventana interactiva. Con --headless renderiza en un
+ * framebuffer offscreen siguiendo un recorrido de cámara guionado.
+ */
+int main(int argc, char **argv)
+{
+	AppOptions opt;
+	if (!parseArgs(argc, argv, opt))
+		return -1;
+
+	if (!opt.bench.empty())
+		return util::runBenchmark(opt.bench, opt.benchOptions);
+
+	if (!opt.telemetrySend.empty())
+	{
+		util::TelemetryEndpoint endpoint;
+		if (!util::TelemetryEndpoint::parse(opt.telemetrySend, endpoint))
+			return -1;
+		return util::runTelemetrySender(endpoint, opt.telemetryReplayFile, opt.playbackSpeed, opt.benchOptions.seconds);
+	}
+
+	configureAirData(opt);
+	configureTerrain(opt);
+	return opt.headless ? runHeadless(opt) : runInteractive(opt);
+}
+
+/**
+ * @brief Atmósfera y viento de la corrida; FlightData y el modelo 6-DOF la leen
+ *
+ * El viento de --wind vale a 600 m sobre el campo; en superficie se usa el
+ * perfil típico de capa límite: 60 % de la intensidad y 30° a la izquierda.
+ */
+static void configureAirData(const AppOptions &opt)
+{
+	using namespace flight::units::literals;
+
+	flight::AirDataConfig config;
+	config.seaLevelPressure = opt.qnh * 100.0f;
+	config.altimeterSetting = opt.qnh * 100.0f;
+	if (opt.windSpeed > 0.0f)
+	{
+		const flight::units::Degrees from(opt.windFrom);
+		const flight::units::Knots speed(opt.windSpeed);
+		config.wind = {{0_m, from - 30_deg, speed * 0.6f}, {600_m, from, speed}};
+	}
+
+	airData.configure(config);
+	flightData.airData = &airData;
+	dynamics.setAirData(&airData);
+}
+
+/**
+ * @brief Relieve compartido por la física, el radioaltímetro y la malla del terreno
  */
-int main()
+static void configureTerrain(const AppOptions &opt)
+{
+	flight::HeightfieldConfig config;
+	config.relief = opt.terrainRelief;
+	terrainHeights.build(config);
+	flightData.terrain = &terrainHeights;
+	dynamics.setTerrain(&terrainHeights);
+	flightData.history = &instrumentHistory;
+}
+
+/**
+ * @brief Ejecución normal: ventana visible, cámara controlada con teclado/mouse
+ */
+static int runInteractive(const AppOptions &opt)
 {
 	// ------------------------------------------------------------------------
 	// 1. INICIALIZACIÓN DE GLFW Y VENTANA
@@ -107,8 +325,8 @@ int main()
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
 	GLFWwindow *window = glfwCreateWindow(
-		kWindowWidth,
-		kWindowHeight,
+		opt.width,
+		opt.height,
 		kWindowTitle,
 		nullptr,
 		nullptr);
@@ -138,53 +356,483 @@ int main()
 	// 3. CONFIGURACIÓN DE OPENGL
 	// ------------------------------------------------------------------------
 
-	glViewport(0, 0, kWindowWidth, kWindowHeight);
-	glEnable(GL_DEPTH_TEST); // Habilitar test de profundidad para 3D
+	glViewport(0, 0, opt.width, opt.height);
+	gfx::GLState::current().enable(GL_DEPTH_TEST); // Habilitar test de profundidad para 3D
+
+	// ------------------------------------------------------------------------
+	// 4. GRABACIÓN / REPRODUCCIÓN DE CÁMARA
+	// ------------------------------------------------------------------------
+
+	util::CameraRecording replay;
+	const bool replaying = !opt.replayFile.empty();
+	if (replaying && !replay.load(opt.replayFile))
+		return -1;
+
+	util::CameraRecorder recorder;
+	if (!opt.recordFile.empty() && !recorder.open(opt.recordFile, 1.0f / opt.fps))
+		return -1;
+
+	util::TelemetryWriter telemetry;
+	if (!opt.telemetryFile.empty() && !telemetry.open(opt.telemetryFile))
+		return -1;
+	double telemetryTime = 0.0; // sin hilo: tiempo acumulado de frames
+
+	util::Digest flightDigest;
+	std::size_t replayFrame = 0;
+
+	// Fuente externa de FlightData: reemplaza a la cámara y a la física
+	util::TelemetryPlayback playback;
+	util::TelemetryReceiver receiver;
+	if (!opt.telemetryReplayFile.empty())
+	{
+		if (!playback.open(opt.telemetryReplayFile))
+			return -1;
+		playback.setSpeed(opt.playbackSpeed);
+		telemetryPlayback = &playback;
+		std::cout << "Telemetry replay: " << playback.startTime() << " - " << playback.endTime()
+				  << " s (flechas: seek/velocidad, espacio: pausa)" << std::endl;
+	}
+	else if (!opt.telemetryListen.empty())
+	{
+		util::TelemetryEndpoint endpoint;
+		if (!util::TelemetryEndpoint::parse(opt.telemetryListen, endpoint) || !receiver.open(endpoint))
+			return -1;
+		std::cout << "Listening for telemetry on " << opt.telemetryListen << std::endl;
+	}
+	telemetryDriven = playback.isOpen() || receiver.isOpen();
 
 	// ------------------------------------------------------------------------
-	// 4. CONFIGURACIÓN DE CALLBACKS
+	// 4b. CONFIGURACIÓN DE CALLBACKS
 	// ------------------------------------------------------------------------
 
 	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-	glfwSetCursorPosCallback(window, mouse_callback);
-	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED); // Mouse capturado
+	if (!replaying && !telemetryDriven) // al reproducir, el mouse no mueve la cámara
+	{
+		glfwSetCursorPosCallback(window, mouse_callback);
+		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED); // Mouse capturado
+	}
 
 	// ------------------------------------------------------------------------
-	// 5. CREACIÓN DE OBJETOS DE RENDERIZADO
+	// 5. CREACIÓN E INICIALIZACIÓN DE OBJETOS DE RENDERIZADO
 	// ------------------------------------------------------------------------
 
-	gfx::TextureCube cubemap;		  // Textura del skybox (6 caras)
-	gfx::SkyboxRenderer skybox;		  // Renderizador del cielo
-	gfx::SimpleCube cube;			  // Cubos de referencia
-	gfx::TerrainRenderer terrain;	  // Renderizador del terreno
-	gfx::TerrainParams terrainParams; // Parámetros del terreno
-	hud::FlightHUD flightHUD;		  // Sistema de HUD
+	Scene scene;
+	globalHUD = &scene.flightHUD; // Guardar puntero global para callbacks
 
-	globalHUD = &flightHUD; // Guardar puntero global para callbacks
+	if (!initScene(scene, opt.width, opt.height))
+		return -1;
+	configureHud(scene.flightHUD, opt);
+	setPhysicsMode(opt.physics && !replaying && !telemetryDriven);
+
+	std::vector<std::unique_ptr<HudScreen>> hudScreens;
+	if (!openHudScreens(window, scene, opt, hudScreens))
+		return -1;
+
+	// Hilo de simulación: no al reproducir, para mantener el paso fijo en lockstep
+	flight::SimulationThread::Config simConfig;
+	simConfig.rateHz = kSimRateHz;
+	simConfig.physicsStartSpeed = kPhysicsStartSpeed;
+	simConfig.physicsStartAltitude = kPhysicsStartAltitude;
+	flight::SimulationThread simThread(simConfig);
+	if (telemetry.isOpen())
+		simThread.setTelemetry(&telemetry);
+	simThread.setHistory(&instrumentHistory); // sin hilo la escribe el loop
+	if (!replaying && !telemetryDriven && !opt.serialSim)
+		simThread.start(flightData, makeSimInput(glfwGetTime()));
 
 	// ------------------------------------------------------------------------
-	// 6. INICIALIZACIÓN DE RECURSOS GRÁFICOS
+	// 6. LOOP PRINCIPAL DE RENDERIZADO
 	// ------------------------------------------------------------------------
 
+	while (!glfwWindowShouldClose(window))
+	{
+
+		// --- Timing ---
+		gfx::GLState::current().resetStats(); // contadores por frame
+		float currentFrame = glfwGetTime();
+		deltaTime = currentFrame - lastFrame;
+		lastFrame = currentFrame;
+
+		// --- Input (o frame grabado, con paso fijo) ---
+		if (replaying)
+		{
+			if (replayFrame == replay.frameCount())
+				break;
+			if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+				glfwSetWindowShouldClose(window, true);
+			applyCameraPose(replay.frame(replayFrame++));
+			deltaTime = replay.fixedDt();
+		}
+		else
+		{
+			processInput(window);
+		}
+		scene.flightHUD.pollLayoutFile(); // el archivo de layouts se editó: aplicarlo
+
+		// --- Actualización de lógica ---
+		// Con hilo: se publica el input y se toma el último snapshot, sin esperar
+		const flight::FlightData *frameData = &flightData;
+		if (telemetryDriven)
+		{
+			if (playback.isOpen())
+			{
+				playback.update(deltaTime, flightData);
+				instrumentHistory.record(flightData, playback.time()); // un seek atrás reinicia la ventana
+			}
+			else if (receiver.poll(flightData))
+			{
+				instrumentHistory.record(flightData, receiver.lastTime());
+				if (telemetry.isOpen())
+					telemetry.push(flightData, receiver.lastTime()); // grabar el stream recibido
+			}
+			followAircraft(flightData);
+		}
+		else if (simThread.running())
+		{
+			simThread.submit(makeSimInput(currentFrame));
+			frameData = &simThread.latest();
+			if (physicsMode)
+				followAircraft(*frameData);
+		}
+		else
+		{
+			updateFlight(deltaTime);
+			telemetryTime += deltaTime;
+			instrumentHistory.record(flightData, telemetryTime);
+			if (telemetry.isOpen())
+				telemetry.push(flightData, telemetryTime);
+		}
+		recorder.record(cameraPos, cameraAttitude.front(), cameraAttitude.up());
+		hashFlightData(flightDigest, *frameData);
+
+		// --- Manejo de resize de ventana ---
+		int width, height;
+		glfwGetFramebufferSize(window, &width, &height);
+		glViewport(0, 0, width, height);
+
+		static int lastWidth = width, lastHeight = height;
+		if (width != lastWidth || height != lastHeight)
+		{
+			scene.flightHUD.setScreenSize(width, height);
+			lastWidth = width;
+			lastHeight = height;
+		}
+
+		// --- Render 3D + HUD ---
+		renderScene(scene, width, height, *frameData);
+		renderHudScreens(window, scene, opt, hudScreens); // misma geometría, sin volver a subirla
+
+		static float lastStatsReport = 0.0f;
+		if (kReportRenderStats && currentFrame - lastStatsReport > kReportIntervalSec)
+		{
+			reportRenderStats(scene, width, height);
+			if (simThread.running())
+			{
+				static std::uint64_t lastTicks = 0;
+				const flight::SimulationThread::Stats ss = simThread.stats();
+				std::cout << "Simulation thread: " << (ss.ticks - lastTicks) / (currentFrame - lastStatsReport)
+						  << " ticks/s (objetivo " << kSimRateHz << "), " << ss.lateTicks << " re-sincronizaciones" << std::endl;
+				lastTicks = ss.ticks;
+			}
+			if (playback.isOpen())
+				std::cout << "Telemetry replay: t=" << playback.time() << " s, x" << playback.speed() << std::endl;
+			if (receiver.isOpen())
+			{
+				const util::TelemetryReceiver::Stats rs = receiver.stats();
+				std::cout << "Telemetry stream: " << rs.packets << " packets, " << rs.stale << " stale, "
+						  << rs.rejected << " rejected, t=" << receiver.lastTime() << " s" << std::endl;
+			}
+			lastStatsReport = currentFrame;
+		}
+
+		// --- Swap y eventos ---
+		glfwSwapBuffers(window);
+		glfwPollEvents();
+	}
+
+	// ------------------------------------------------------------------------
+	// 7. LIMPIEZA Y CIERRE
+	// ------------------------------------------------------------------------
+
+	if (recorder.isOpen())
+	{
+		const std::uint32_t recorded = recorder.frames();
+		if (recorder.close())
+			std::cout << "Recorded " << recorded << " frames to " << opt.recordFile << std::endl;
+	}
+	if (replaying)
+		std::cout << "Replayed " << replayFrame << "/" << replay.frameCount()
+				  << " frames, FlightData digest " << std::hex << flightDigest.value() << std::dec << std::endl;
+
+	for (const std::unique_ptr<HudScreen> &screen : hudScreens)
+		closeHudScreen(window, scene, *screen);
+	simThread.stop();
+	telemetryPlayback = nullptr;
+	if (telemetry.isOpen())
+	{
+		telemetry.close(); // vacía la cola antes de contar
+		const util::TelemetryWriter::Stats ts = telemetry.stats();
+		std::cout << "Telemetry: " << ts.written << " samples (" << ts.dropped << " dropped), "
+				  << ts.bytes << " bytes in " << ts.chunks << " chunks to " << opt.telemetryFile << std::endl;
+	}
+	std::cout << "Cleaning up resources..." << std::endl;
+	// Los destructores de C++ se encargan de liberar los recursos automáticamente
+
+	return 0;
+}
+
+/**
+ * @brief Ejecución sin usuario: contexto invisible, render a FBO, cámara guionada
+ *
+ * Usa una ventana GLFW invisible; si no hay servidor gráfico y el binario se
+ * compiló con HEADLESS_EGL=1, cae a un contexto EGL surfaceless (Mesa llvmpipe).
+ * Avanza con paso fijo 1/fps, guarda frames PPM opcionales y un CSV de tiempos.
+ * Con --replay la cámara y el dt salen de la grabación en lugar del recorrido.
+ */
+static int runHeadless(const AppOptions &opt)
+{
+	// ------------------------------------------------------------------------
+	// 1. CONTEXTO OPENGL SIN VENTANA VISIBLE
+	// ------------------------------------------------------------------------
+
+	GLFWwindow *window = nullptr;
+	gfx::HeadlessContext eglContext; // debe vivir más que la escena
+
+	if (glfwInit())
+	{
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		window = glfwCreateWindow(opt.width, opt.height, kWindowTitle, nullptr, nullptr);
+	}
+
+	if (window != nullptr)
+	{
+		glfwMakeContextCurrent(window);
+		if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+		{
+			std::cerr << "Failed to initialize GLAD" << std::endl;
+			return -1;
+		}
+	}
+	else if (!gfx::HeadlessContext::available() || !eglContext.create())
+	{
+		std::cerr << "Failed to create a headless OpenGL context" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	print_gl_version();
+	gfx::GLState::current().enable(GL_DEPTH_TEST);
+
+	// ------------------------------------------------------------------------
+	// 2. RECORRIDO DE CÁMARA Y SALIDA
+	// ------------------------------------------------------------------------
+
+	util::CameraPath path;
+	util::CameraRecording replay;
+	const bool replaying = !opt.replayFile.empty();
+	if (replaying)
+	{
+		if (!replay.load(opt.replayFile))
+			return -1;
+	}
+	else if (opt.pathFile.empty())
+		path.setDefault();
+	else if (!path.loadFromFile(opt.pathFile))
+		return -1;
+
+	const int frameCount = replaying ? (int)replay.frameCount() : opt.frames;
+	const float dt = replaying ? replay.fixedDt() : 1.0f / opt.fps;
+
+	std::error_code ec;
+	std::filesystem::create_directories(opt.outDir, ec);
+	if (ec)
+	{
+		std::cerr << "Cannot create output directory " << opt.outDir << ": " << ec.message() << std::endl;
+		return -1;
+	}
+
+	// ------------------------------------------------------------------------
+	// 3. ESCENA Y FRAMEBUFFER OFFSCREEN
+	// ------------------------------------------------------------------------
+
+	int exitCode = 0;
+	{
+		Scene scene;
+		globalHUD = &scene.flightHUD;
+		if (!initScene(scene, opt.width, opt.height))
+			return -1;
+		configureHud(scene.flightHUD, opt);
+		setPhysicsMode(opt.physics && !replaying && opt.telemetryReplayFile.empty());
+
+		gfx::Framebuffer target;
+		try
+		{
+			target.create(opt.width, opt.height);
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << "✗ " << e.what() << std::endl;
+			return -1;
+		}
+
+		// --------------------------------------------------------------------
+		// 4. LOOP CON PASO FIJO
+		// --------------------------------------------------------------------
+
+		using Clock = std::chrono::steady_clock;
+		std::vector<double> cpuMs, frameMs;
+		cpuMs.reserve(frameCount);
+		frameMs.reserve(frameCount);
+		std::vector<unsigned char> pixels;
+		util::Digest flightDigest;
+
+		util::TelemetryWriter telemetry;
+		if (!opt.telemetryFile.empty() && !telemetry.open(opt.telemetryFile))
+			return -1;
+
+		// Con --telemetry-replay el log reemplaza al recorrido y a la física
+		util::TelemetryPlayback playback;
+		if (!opt.telemetryReplayFile.empty())
+		{
+			if (!playback.open(opt.telemetryReplayFile))
+				return -1;
+			playback.setSpeed(opt.playbackSpeed);
+		}
+
+		std::cout << "Headless: " << frameCount << " frames " << opt.width << "x" << opt.height
+				  << " @ dt=" << dt << "s, output " << opt.outDir << std::endl;
+
+		for (int frame = 0; frame < frameCount; ++frame)
+		{
+			gfx::GLState::current().resetStats();
+			const Clock::time_point t0 = Clock::now();
+
+			// La cámara sale del recorrido/grabación en lugar de processInput/mouse_callback
+			// (en modo física la pone el modelo, con los mandos en su valor inicial)
+			deltaTime = dt;
+			if (playback.isOpen())
+			{
+				playback.update(frame == 0 ? 0.0 : dt, flightData);
+				followAircraft(flightData);
+			}
+			else
+			{
+				if (!physicsMode)
+					applyCameraPose(replaying ? replay.frame(frame) : path.sample(frame * dt));
+				updateFlight(deltaTime);
+			}
+			hashFlightData(flightDigest, flightData);
+			instrumentHistory.record(flightData, playback.isOpen() ? playback.time() : (frame + 1) * (double)dt);
+			if (telemetry.isOpen())
+				telemetry.push(flightData, (frame + 1) * (double)dt);
+
+			target.bind();
+			renderScene(scene, opt.width, opt.height, flightData);
+			drawHudInsets(scene, opt); // --hud-view: recuadros en el mismo frame
+
+			const Clock::time_point t1 = Clock::now();
+			glFinish(); // incluir el trabajo de GPU en el tiempo del frame
+			const Clock::time_point t2 = Clock::now();
+
+			cpuMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+			frameMs.push_back(std::chrono::duration<double, std::milli>(t2 - t0).count());
+
+			if (opt.dumpEvery > 0 && frame % opt.dumpEvery == 0)
+			{
+				char name[64];
+				std::snprintf(name, sizeof(name), "/frame_%05d.ppm", frame);
+				target.readPixels(pixels);
+				if (!util::writePPM(opt.outDir + name, opt.width, opt.height, pixels))
+					exitCode = -1;
+			}
+		}
+		gfx::Framebuffer::bindDefault();
+
+		// --------------------------------------------------------------------
+		// 5. TIEMPOS: CSV POR FRAME + RESUMEN
+		// --------------------------------------------------------------------
+
+		std::ofstream csv(opt.outDir + "/timing.csv");
+		csv << "frame,cpu_ms,frame_ms\n";
+		for (size_t i = 0; i < frameMs.size(); ++i)
+			csv << i << "," << cpuMs[i] << "," << frameMs[i] << "\n";
+
+		if (!frameMs.empty())
+		{
+			std::vector<double> sorted = frameMs;
+			std::sort(sorted.begin(), sorted.end());
+			double sum = 0.0;
+			for (double v : sorted)
+				sum += v;
+			const double avg = sum / sorted.size();
+			auto pct = [&](double p)
+			{ return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))]; };
+
+			std::cout << "Frame time (ms): avg " << avg << ", p50 " << pct(0.50)
+					  << ", p95 " << pct(0.95) << ", max " << sorted.back()
+					  << " (" << 1000.0 / avg << " fps)" << std::endl;
+		}
+		std::cout << "FlightData digest " << std::hex << flightDigest.value() << std::dec << std::endl;
+		if (telemetry.isOpen())
+		{
+			telemetry.close();
+			const util::TelemetryWriter::Stats ts = telemetry.stats();
+			std::cout << "Telemetry: " << ts.written << " samples (" << ts.dropped << " dropped) to "
+					  << opt.telemetryFile << std::endl;
+		}
+		reportRenderStats(scene, opt.width, opt.height);
+	}
+
+	if (window)
+	{
+		glfwDestroyWindow(window);
+		glfwTerminate();
+	}
+	return exitCode;
+}
+
+// ============================================================================
+// ESCENA: INICIALIZACIÓN Y RENDER
+// ============================================================================
+
+/**
+ * @brief Carga texturas, compila shaders e inicializa el HUD
+ */
+static bool initScene(Scene &scene, int width, int height)
+{
+	scene.renderQueue.setDepthPrepass(kDepthPrepass);
+
 	try
 	{
 		// Skybox: cargar atlas y compilar shaders
-		if (!cubemap.loadFromAtlas("Cubemap/Cubemap_Sky_01-512x512.png", false))
+		if (!scene.cubemap.loadFromAtlas("Cubemap/Cubemap_Sky_01-512x512.png", false))
 		{
 			std::cerr << "Failed to load cubemap atlas" << std::endl;
-			return -1;
+			return false;
 		}
-		skybox.init();
-		skybox.setCubemap(&cubemap);
+		scene.skybox.init();
+		scene.skybox.setCubemap(&scene.cubemap);
+		scene.skybox.setOcclusionQueryEnabled(kReportRenderStats);
+		scene.measureCubeSky = kReportRenderStats; // en el primer frame (espera la query)
 
 		// Cubos de referencia: crear geometría
-		cube.init();
+		scene.cube.init();
 
 		// Terreno: generar mesh, cargar texturas
-		terrain.init();
-		terrain.loadTextures("forrest_ground_01_4k.blend/textures");
+		scene.terrain.init();
+		scene.terrain.loadTextures("forrest_ground_01_4k.blend/textures");
+		if (!terrainHeights.empty())
+		{
+			std::vector<float> heights;
+			terrainHeights.copySamples(heights);
+			scene.terrain.setHeightmap(heights, terrainHeights.samplesPerSide(), terrainHeights.spacing());
+		}
 
 		// Configurar parámetros del terreno
+		gfx::TerrainParams &terrainParams = scene.terrainParams;
 		terrainParams.groundY = 0.0f;		  // Nivel del piso
 		terrainParams.tileScaleMacro = 0.05f; // Escala textura principal
 		terrainParams.tileScaleDetail = 0.4f; // Escala textura de detalle
@@ -192,86 +840,585 @@ int main()
 		terrainParams.fogDensity = 0.00f;	  // Niebla deshabilitada
 
 		// HUD: compilar shaders, inicializar altímetro
-		flightHUD.init(kWindowWidth, kWindowHeight);
-		flightHUD.setLayout("classic");
+		scene.flightHUD.init(width, height);
+		scene.flightHUD.setLayout("classic");
 
 		std::cout << "✓ All systems initialized successfully!" << std::endl;
 	}
 	catch (const std::exception &e)
 	{
 		std::cerr << "✗ Error initializing systems: " << e.what() << std::endl;
-		return -1;
+		return false;
 	}
+	return true;
+}
 
-	// ------------------------------------------------------------------------
-	// 7. LOOP PRINCIPAL DE RENDERIZADO
-	// ------------------------------------------------------------------------
+/**
+ * @brief Dibuja un frame completo (3D + HUD) en el framebuffer bindeado
+ *
+ * data debe seguir vivo hasta el final (el HUD guarda un puntero, no una copia).
+ */
+static void renderScene(Scene &scene, int width, int height, const flight::FlightData &data)
+{
+	// --- Limpiar buffers ---
+	glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	// --- Matrices de cámara ---
+	const flight::CameraBasis &eye = cameraAttitude.basis();
+	glm::mat4 view = glm::lookAt(cameraPos, cameraPos + eye.front, eye.up);
+	glm::mat4 projection = glm::perspective(
+		glm::radians(45.0f),
+		(float)width / (float)height,
+		0.1f,	// Near plane
+		1000.0f // Far plane (lejano para ver terreno)
+	);
+
+	// --- Renderizado 3D ---
+	// Para el reporte: el skybox anterior (cubo dibujado primero) bajo la misma
+	// query; lo cubre todo lo que viene después, la imagen no cambia.
+	if (scene.measureCubeSky)
+	{
+		scene.cubeSkyFragments = scene.skybox.measureCubePath(view, projection);
+		scene.measureCubeSky = false;
+	}
 
-	while (!glfwWindowShouldClose(window))
+	// La cola ordena por pasada/shader/textura y dibuja los opacos de
+	// adelante hacia atrás; el skybox va al final para aprovechar el early-Z.
+	gfx::RenderQueue &renderQueue = scene.renderQueue;
+	renderQueue.begin();
 	{
+		gfx::DrawItem item;
+		item.pass = gfx::RenderPass::Opaque;
+		item.shader = scene.terrain.programId();
+		item.texture = scene.terrain.albedoTexture();
+		item.depth = 0.0f; // la cámara siempre está sobre el terreno
+		item.draw = [&]()
+		{ scene.terrain.draw(view, projection, cameraPos, scene.terrainParams); };
+		item.depthShader = scene.terrain.depthProgramId();
+		item.drawDepth = [&]()
+		{ scene.terrain.drawDepthOnly(view, projection, cameraPos, scene.terrainParams); };
+		renderQueue.submit(std::move(item));
+	}
+	{
+		// Cubo de referencia
+		gfx::DrawItem item;
+		item.pass = gfx::RenderPass::Opaque;
+		item.shader = scene.cube.programId();
+		item.depth = glm::length(kCubePosition - cameraPos);
+		item.draw = [&]()
+		{ scene.cube.draw(view, projection, kCubePosition); };
+		renderQueue.submit(std::move(item));
+	}
+	{
+		gfx::DrawItem item;
+		item.pass = gfx::RenderPass::Sky;
+		item.shader = scene.skybox.programId();
+		item.draw = [&]()
+		{ scene.skybox.draw(view, projection); };
+		renderQueue.submit(std::move(item));
+	}
+	renderQueue.flush();
 
-		// --- Timing ---
-		float currentFrame = glfwGetTime();
-		deltaTime = currentFrame - lastFrame;
-		lastFrame = currentFrame;
+	// --- Renderizado 2D (HUD overlay) ---
+	scene.flightHUD.update(data);
+	scene.flightHUD.render(deltaTime);
+}
 
-		// --- Input ---
-		processInput(window);
+/**
+ * @brief Imprime fragmentos del skybox, draw calls y llamadas GL del último frame
+ *
+ * Comparación: fragmentos del skybox anterior (cubo dibujado primero), medidos
+ * con la misma query en el primer frame. Ese cubo rodea la cámara: cubre toda
+ * la pantalla mire donde mire, así que una medición alcanza.
+ */
+static void reportRenderStats(Scene &scene, int width, int height)
+{
+	const GLuint skyFragments = scene.skybox.lastSamplesPassed();
+	const float screenPixels = (float)width * (float)height;
+	const gfx::RenderQueueStats &qs = scene.renderQueue.stats();
+	std::cout << "Skybox: " << skyFragments << " fragmentos sombreados ("
+			  << 100.0f * skyFragments / screenPixels << "% de "
+			  << width << "x" << height << "), cubo anterior " << scene.cubeSkyFragments << " ("
+			  << 100.0f * scene.cubeSkyFragments / screenPixels << "%)" << std::endl;
+	std::cout << "RenderQueue: " << qs.drawCalls << " draw calls, "
+			  << qs.stateChanges() << " cambios de estado (shader "
+			  << qs.shaderChanges << ", textura " << qs.textureChanges
+			  << ", pasada " << qs.passChanges << ")"
+			  << (scene.renderQueue.depthPrepass() ? " [depth pre-pass]" : "") << std::endl;
+	const gfx::Renderer2D::Stats &hs = scene.flightHUD.renderStats();
+	std::cout << "HUD 2D: " << hs.commands << " comandos -> " << hs.drawCalls << " draw calls ("
+			  << hs.vertices << " vértices)" << std::endl;
+	const hud::FlightHUD::FrameStats &fs = scene.flightHUD.frameStats();
+	if (scene.flightHUD.offscreen())
+		std::cout << "HUD a textura: " << fs.redraws << " redibujos en " << fs.frames << " frames, CPU "
+				  << fs.frameUs() << " us/frame contra " << fs.redrawUs() << " redibujando siempre (ahorro "
+				  << fs.savedUs() << " us/frame)" << std::endl;
+	else
+		std::cout << "HUD directo: CPU " << fs.frameUs() << " us/frame" << std::endl;
+	if (fs.views > 0)
+		std::cout << "HUD vistas extra: " << fs.views << " dibujos, CPU " << fs.viewUs()
+				  << " us c/u (sin regrabar ni subir geometría)" << std::endl;
+	scene.flightHUD.resetFrameStats(); // por intervalo de reporte
+	const gfx::GLState::Stats &gs = gfx::GLState::current().stats();
+	std::cout << "GLState: " << gs.issued << " llamadas al driver, "
+			  << gs.filtered << " redundantes filtradas" << std::endl;
+}
 
-		// --- Actualización de lógica ---
-		flightData.updateFromCamera(cameraFront, cameraUp, cameraPos, deltaTime);
-		flightData.simulatePhysics(deltaTime);
+/**
+ * @brief Fija la cámara global a una pose grabada/guionada
+ *
+ * La actitud queda en el quaternion: al volver al control manual no salta.
+ */
+static void applyCameraPose(const util::CameraPose &pose)
+{
+	cameraPos = pose.position;
+	cameraAttitude.set(pose.front, pose.up);
+}
 
-		// --- Manejo de resize de ventana ---
-		int width, height;
-		glfwGetFramebufferSize(window, &width, &height);
-		glViewport(0, 0, width, height);
+/**
+ * @brief Activa/desactiva el modelo de vuelo
+ *
+ * Al entrar, el avión arranca nivelado en la posición y rumbo de la cámara.
+ * Al salir, la cámara libre continúa desde la última pose del avión, alabeo
+ * incluido (X nivela).
+ */
+static void setPhysicsMode(bool enabled)
+{
+	if (enabled == physicsMode)
+		return;
+	physicsMode = enabled;
 
-		static int lastWidth = width, lastHeight = height;
-		if (width != lastWidth || height != lastHeight)
+	if (enabled)
+	{
+		const glm::vec3 start(cameraPos.x, std::max(cameraPos.y, kPhysicsStartAltitude), cameraPos.z);
+		dynamics.reset(start, cameraAttitude.front(), kPhysicsStartSpeed);
+		controls = flight::ControlInputs{};
+		dynamics.setControls(controls);
+		flightData.dynamics = &dynamics;
+	}
+	else
+	{
+		flightData.dynamics = nullptr; // followAircraft ya dejó la actitud del avión
+	}
+	std::cout << "Flight model: " << (enabled ? "6-DOF physics" : "free camera") << std::endl;
+}
+
+/**
+ * @brief Actualiza FlightData para el frame y, en modo física, mueve la cámara
+ */
+static void updateFlight(float dt)
+{
+	if (physicsMode)
+	{
+		flightData.simulatePhysics(dt); // pasos fijos de 1 ms + interpolación
+		followAircraft(flightData);
+	}
+	else
+	{
+		flightData.updateFromCamera(cameraAttitude.basis(), cameraPos, dt); // base ya ortonormal
+		flightData.simulatePhysics(dt);
+	}
+}
+
+/**
+ * @brief En modo física la cámara va en la cabina del avión
+ */
+static void followAircraft(const flight::FlightData &data)
+{
+	cameraPos = data.position;
+	cameraAttitude.set(data.cameraFront, data.cameraUp);
+}
+
+/**
+ * @brief Muestra del input del frame para el hilo de simulación
+ */
+static flight::SimInput makeSimInput(double time)
+{
+	flight::SimInput in;
+	in.cameraPos = cameraPos;
+	in.camera = cameraAttitude.basis();
+	in.controls = controls;
+	in.physics = physicsMode;
+	in.time = time;
+	return in;
+}
+
+/**
+ * @brief Acumula en el hash las salidas de FlightData que ve el HUD
+ *
+ * Misma grabación + mismo dt ⇒ mismo digest. Sirve para verificar que un
+ * cambio de rendimiento no alteró los valores de los instrumentos.
+ */
+static void hashFlightData(util::Digest &digest, const flight::FlightData &data)
+{
+	digest.add(data.pitch.value());
+	digest.add(data.roll.value());
+	digest.add(data.heading.value());
+	digest.add(data.airspeed.value());
+	digest.add(data.altitude.value());
+	digest.add(data.verticalSpeed.value());
+	digest.add(&data.position, sizeof(data.position));
+	digest.add(&data.velocity, sizeof(data.velocity));
+}
+
+/**
+ * @brief Layouts (--hud-layouts) y modo de dibujo del HUD (--hud-rate / --hud-on-change)
+ */
+static void configureHud(hud::FlightHUD &hud, const AppOptions &opt)
+{
+	// Sin archivo queda el layout fijo de FlightHUD
+	if (!opt.hudLayouts.empty() && !hud.loadLayouts(opt.hudLayouts))
+		std::cerr << "Using built-in HUD layout" << std::endl;
+
+	if (opt.hudRate < 0.0f && !opt.hudOnChange)
+		return; // directo, cada frame
+	hud.setOffscreen(true, std::max(0.0f, opt.hudRate), opt.hudOnChange);
+	std::cout << "HUD a textura: ";
+	if (opt.hudRate > 0.0f)
+		std::cout << "hasta " << opt.hudRate << " redibujos/s";
+	else
+		std::cout << "sin tope";
+	std::cout << (opt.hudOnChange ? ", sólo si cambia un valor visible" : "") << std::endl;
+}
+
+// ============================================================================
+// PANTALLAS EXTRA DEL HUD
+// ============================================================================
+
+/**
+ * @brief --hud-view INSTR[,INSTR][@X,Y,W,H]: máscara de tipos y región opcional
+ */
+static bool parseHudView(const std::string &spec, gfx::Renderer2D::View &view)
+{
+	const size_t at = spec.find('@');
+	view.mask = hud::InstrumentRegistry::viewMask(spec.substr(0, at));
+	if (view.mask == 0)
+	{
+		std::cerr << "Invalid --hud-view, expected INSTR[,INSTR][@X,Y,W,H]" << std::endl;
+		return false;
+	}
+	if (at != std::string::npos &&
+		(std::sscanf(spec.c_str() + at + 1, "%f,%f,%f,%f", &view.region.x, &view.region.y, &view.region.z,
+					 &view.region.w) != 4 ||
+		 view.region.z <= 0.0f || view.region.w <= 0.0f))
+	{
+		std::cerr << "Invalid --hud-view region, expected X,Y,W,H in HUD pixels" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Región del lienzo del HUD que muestra una vista en un destino de width×height
+ *
+ * Sin región fija sigue a sus instrumentos en el layout actual (con margen).
+ * Con destino (width, height > 0) se agranda el lado corto, centrado, para
+ * no deformar con su relación de aspecto.
+ */
+static glm::vec4 hudViewRegion(hud::FlightHUD &hud, const gfx::Renderer2D::View &view, int canvasWidth,
+							   int canvasHeight, int width, int height)
+{
+	glm::vec4 region = view.region;
+	if (region.z <= 0.0f || region.w <= 0.0f)
+	{
+		region = hud.instrumentBounds(view.mask);
+		if (region.z > 0.0f && region.w > 0.0f)
+			region += glm::vec4(-kHudViewMargin, -kHudViewMargin, 2.0f * kHudViewMargin, 2.0f * kHudViewMargin);
+		else
+			region = glm::vec4(0.0f, 0.0f, (float)canvasWidth, (float)canvasHeight); // nada visible: todo
+	}
+
+	if (width <= 0 || height <= 0)
+		return region;
+	const float aspect = (float)width / (float)height;
+	if (region.z / region.w < aspect)
+	{
+		const float w = region.w * aspect;
+		region.x -= 0.5f * (w - region.z);
+		region.z = w;
+	}
+	else
+	{
+		const float h = region.z / aspect;
+		region.y -= 0.5f * (h - region.w);
+		region.w = h;
+	}
+	return region;
+}
+
+/**
+ * @brief Una ventana por --hud-view, con contexto compartido con mainWindow
+ *
+ * Cada una arranca del tamaño de su región y sin vsync (la espera la hace la
+ * ventana principal: si no, cada swap sumaría un vblank al frame).
+ */
+static bool openHudScreens(GLFWwindow *mainWindow, Scene &scene, const AppOptions &opt,
+						   std::vector<std::unique_ptr<HudScreen>> &screens)
+{
+	for (size_t i = 0; i < opt.hudViews.size(); ++i)
+	{
+		auto screen = std::make_unique<HudScreen>();
+		screen->view = opt.hudViews[i];
+
+		const glm::vec4 region = hudViewRegion(scene.flightHUD, screen->view, opt.width, opt.height, 0, 0);
+		const int width = std::max(64, (int)region.z);
+		const int height = std::max(64, (int)region.w);
+
+		const std::string title = std::string(kWindowTitle) + " - HUD " + std::to_string(i + 1);
+		screen->window = glfwCreateWindow(width, height, title.c_str(), nullptr, mainWindow);
+		if (!screen->window)
 		{
-			flightHUD.setScreenSize(width, height);
-			lastWidth = width;
-			lastHeight = height;
+			std::cerr << "Failed to create HUD view window " << i + 1 << std::endl;
+			for (const std::unique_ptr<HudScreen> &open : screens)
+				closeHudScreen(mainWindow, scene, *open);
+			screens.clear();
+			return false;
 		}
 
-		// --- Limpiar buffers ---
-		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glfwMakeContextCurrent(screen->window);
+		glfwSwapInterval(0);
+		gfx::GLState::makeCurrent(&screen->glState);
+		scene.flightHUD.addViewContext();
+		screens.push_back(std::move(screen));
+	}
 
-		// --- Matrices de cámara ---
-		glm::mat4 view = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
-		glm::mat4 projection = glm::perspective(
-			glm::radians(45.0f),
-			(float)width / (float)height,
-			0.1f,	// Near plane
-			1000.0f // Far plane (lejano para ver terreno)
-		);
+	glfwMakeContextCurrent(mainWindow);
+	gfx::GLState::makeCurrent(nullptr);
+	if (!screens.empty())
+		std::cout << "HUD: " << screens.size() << " pantalla(s) extra con contexto compartido" << std::endl;
+	return true;
+}
 
-		// --- Renderizado 3D ---
-		skybox.draw(view, projection);
-		terrain.draw(view, projection, cameraPos, terrainParams);
+/**
+ * @brief Dibuja el HUD del frame en cada pantalla extra (después de renderScene)
+ *
+ * Sólo draw calls: la geometría ya se grabó y se subió en el contexto
+ * principal. Una ventana cerrada por el usuario se destruye y deja de contar.
+ */
+static void renderHudScreens(GLFWwindow *mainWindow, Scene &scene, const AppOptions &opt,
+							 std::vector<std::unique_ptr<HudScreen>> &screens)
+{
+	if (screens.empty())
+		return;
 
-		// Cubo de referencia
-		cube.draw(view, projection, glm::vec3(0.0f, 0.0f, 5.0f)); // Adelante
+	for (size_t i = 0; i < screens.size();)
+	{
+		HudScreen &screen = *screens[i];
+		if (glfwWindowShouldClose(screen.window))
+		{
+			closeHudScreen(mainWindow, scene, screen);
+			screens.erase(screens.begin() + i);
+			continue;
+		}
+		++i;
 
-		// --- Renderizado 2D (HUD overlay) ---
-		flightHUD.update(flightData);
-		flightHUD.render();
+		glfwMakeContextCurrent(screen.window);
+		gfx::GLState::makeCurrent(&screen.glState);
 
-		// --- Swap y eventos ---
-		glfwSwapBuffers(window);
-		glfwPollEvents();
+		int width, height;
+		glfwGetFramebufferSize(screen.window, &width, &height);
+		if (width <= 0 || height <= 0)
+			continue; // minimizada
+		glViewport(0, 0, width, height);
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		gfx::Renderer2D::View view = screen.view;
+		view.region = hudViewRegion(scene.flightHUD, screen.view, opt.width, opt.height, width, height);
+		scene.flightHUD.renderView(view);
+		glfwSwapBuffers(screen.window);
 	}
 
-	// ------------------------------------------------------------------------
-	// 8. LIMPIEZA Y CIERRE
-	// ------------------------------------------------------------------------
+	glfwMakeContextCurrent(mainWindow);
+	gfx::GLState::makeCurrent(nullptr);
+}
 
-	std::cout << "Cleaning up resources..." << std::endl;
-	// Los destructores de C++ se encargan de liberar los recursos automáticamente
+static void closeHudScreen(GLFWwindow *mainWindow, Scene &scene, HudScreen &screen)
+{
+	glfwMakeContextCurrent(screen.window);
+	gfx::GLState::makeCurrent(&screen.glState);
+	scene.flightHUD.releaseViewContext();
+	glfwMakeContextCurrent(mainWindow);
+	gfx::GLState::makeCurrent(nullptr);
+	glfwDestroyWindow(screen.window);
+	screen.window = nullptr;
+}
 
-	return 0;
+/**
+ * @brief Headless: cada --hud-view como recuadro abajo a la izquierda del frame
+ *
+ * Mismo contexto y mismo FBO: sólo cambian el viewport, la región y la máscara.
+ */
+static void drawHudInsets(Scene &scene, const AppOptions &opt)
+{
+	if (opt.hudViews.empty())
+		return;
+
+	gfx::GLState &gl = gfx::GLState::current();
+	const int height = std::max(1, (int)(opt.height * kHudInsetFraction));
+	const int gap = (int)kHudViewMargin / 2;
+	int x = gap;
+	for (const gfx::Renderer2D::View &inset : opt.hudViews)
+	{
+		// Ancho según la región de la vista (o el de un cuadrado si sigue a sus instrumentos)
+		int width = height;
+		if (inset.region.z > 0.0f && inset.region.w > 0.0f)
+			width = std::max(1, (int)(height * inset.region.z / inset.region.w));
+		if (x + width > opt.width)
+			break; // no entra
+
+		gl.enable(GL_SCISSOR_TEST);
+		glScissor(x, gap, width, height);
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		gl.disable(GL_SCISSOR_TEST);
+
+		glViewport(x, gap, width, height);
+		gfx::Renderer2D::View view = inset;
+		view.region = hudViewRegion(scene.flightHUD, inset, opt.width, opt.height, width, height);
+		scene.flightHUD.renderView(view);
+		x += width + gap;
+	}
+	glViewport(0, 0, opt.width, opt.height);
+}
+
+// ============================================================================
+// LÍNEA DE COMANDOS
+// ============================================================================
+
+static void printUsage(const char *prog)
+{
+	std::cout << "Uso: " << prog << " [opciones]\n"
+			  << "  --headless         render offscreen sin ventana ni input\n"
+			  << "  --physics          arrancar con el modelo de vuelo 6-DOF (tecla P)\n"
+			  << "  --serial-sim       simular en el hilo de render (sin hilo de simulación)\n"
+			  << "  --size WxH         resolución (por defecto " << kWindowWidth << "x" << kWindowHeight << ")\n"
+			  << "  --frames N         headless: frames a renderizar (600)\n"
+			  << "  --fps F            headless/--record: paso fijo 1/F segundos (60)\n"
+			  << "  --path ARCHIVO     headless: recorrido de cámara (t x y z yaw pitch)\n"
+			  << "  --dump-every N     headless: guardar frame PPM cada N frames\n"
+			  << "  --out DIR          headless: carpeta de salida (headless_out)\n"
+			  << "  --record ARCHIVO   grabar la pose de cámara de cada frame (binario)\n"
+			  << "  --replay ARCHIVO   reproducir una grabación con su paso fijo\n"
+			  << "  --telemetry ARCHIVO log de telemetría comprimido (un registro por tick)\n"
+			  << "  --telemetry-replay ARCHIVO  HUD desde un log de telemetría (también headless)\n"
+			  << "  --telemetry-listen EP       HUD desde un socket local (udp:PUERTO | unix:RUTA)\n"
+			  << "  --telemetry-send EP         emisor de prueba: manda --telemetry-replay o un vuelo sintético\n"
+			  << "  --speed X          reproducción/emisión de telemetría: velocidad relativa (1)\n"
+			  << "  --wind DIR/KT      viento a 600 m (p. ej. 270/20); en superficie 60 % y 30° a la izquierda\n"
+			  << "  --qnh HPA          presión al nivel del mar y ajuste del altímetro (1013.25)\n"
+			  << "  --relief M         amplitud del relieve del terreno en metros (0 = plano)\n"
+			  << "  --hud-rate HZ      HUD en textura redibujada hasta HZ veces/s, compuesta cada frame\n"
+			  << "  --hud-on-change    HUD en textura redibujada sólo si cambia un valor visible\n"
+			  << "  --hud-layouts ARCHIVO       layouts del HUD, recargados al guardar (layouts/hud.layout)\n"
+			  << "  --hud-view INSTR[,INSTR][@X,Y,W,H]  pantalla extra del HUD (repetible): ventana con contexto\n"
+			  << "                     compartido, o recuadro en headless. INSTR: tipo del layout o all; X,Y,W,H:\n"
+			  << "                     región del HUD en px (por defecto, la caja de esos instrumentos)\n"
+			  << "  --seconds S        bench/--telemetry-send: segundos simulados (10)\n"
+			  << "  --bench NOMBRE     benchmark de CPU y salir (traffic, attitude, telemetry, airdata, terrain, hud2d,\n"
+			  << "                     instruments, history, glstate)\n"
+			  << "  --aircraft N       bench: tamaño del lote (10000)\n"
+			  << "  --threads N        bench: máximo de hilos (por defecto, todos)\n";
+}
+
+/**
+ * @brief Interpreta argv. Devuelve false ante error o --help.
+ */
+static bool parseArgs(int argc, char **argv, AppOptions &opt)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+
+		if (arg == "--headless")
+			opt.headless = true;
+		else if (arg == "--physics")
+			opt.physics = true;
+		else if (arg == "--serial-sim")
+			opt.serialSim = true;
+		else if (arg == "--size" && hasValue)
+		{
+			if (std::sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) != 2 || opt.width <= 0 || opt.height <= 0)
+			{
+				std::cerr << "Invalid --size, expected WxH" << std::endl;
+				return false;
+			}
+		}
+		else if (arg == "--frames" && hasValue)
+			opt.frames = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--fps" && hasValue)
+			opt.fps = std::max(1.0f, (float)std::atof(argv[++i]));
+		else if (arg == "--path" && hasValue)
+			opt.pathFile = argv[++i];
+		else if (arg == "--dump-every" && hasValue)
+			opt.dumpEvery = std::max(0, std::atoi(argv[++i]));
+		else if (arg == "--out" && hasValue)
+			opt.outDir = argv[++i];
+		else if (arg == "--record" && hasValue)
+			opt.recordFile = argv[++i];
+		else if (arg == "--replay" && hasValue)
+			opt.replayFile = argv[++i];
+		else if (arg == "--telemetry" && hasValue)
+			opt.telemetryFile = argv[++i];
+		else if (arg == "--telemetry-replay" && hasValue)
+			opt.telemetryReplayFile = argv[++i];
+		else if (arg == "--telemetry-listen" && hasValue)
+			opt.telemetryListen = argv[++i];
+		else if (arg == "--telemetry-send" && hasValue)
+			opt.telemetrySend = argv[++i];
+		else if (arg == "--speed" && hasValue)
+			opt.playbackSpeed = std::atof(argv[++i]);
+		else if (arg == "--wind" && hasValue)
+		{
+			if (std::sscanf(argv[++i], "%f/%f", &opt.windFrom, &opt.windSpeed) != 2 || opt.windSpeed < 0.0f)
+			{
+				std::cerr << "Invalid --wind, expected DIR/KT" << std::endl;
+				return false;
+			}
+		}
+		else if (arg == "--qnh" && hasValue)
+		{
+			opt.qnh = (float)std::atof(argv[++i]);
+			if (opt.qnh < 850.0f || opt.qnh > 1100.0f)
+			{
+				std::cerr << "Invalid --qnh, expected hPa (850-1100)" << std::endl;
+				return false;
+			}
+		}
+		else if (arg == "--relief" && hasValue)
+			opt.terrainRelief = std::max(0.0f, (float)std::atof(argv[++i]));
+		else if (arg == "--hud-rate" && hasValue)
+			opt.hudRate = std::max(0.0f, (float)std::atof(argv[++i]));
+		else if (arg == "--hud-on-change")
+			opt.hudOnChange = true;
+		else if (arg == "--hud-layouts" && hasValue)
+			opt.hudLayouts = argv[++i];
+		else if (arg == "--hud-view" && hasValue)
+		{
+			gfx::Renderer2D::View view;
+			if (!parseHudView(argv[++i], view))
+				return false;
+			opt.hudViews.push_back(view);
+		}
+		else if (arg == "--seconds" && hasValue)
+			opt.benchOptions.seconds = std::max(0.1f, (float)std::atof(argv[++i]));
+		else if (arg == "--bench" && hasValue)
+			opt.bench = argv[++i];
+		else if (arg == "--aircraft" && hasValue)
+			opt.benchOptions.aircraft = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--threads" && hasValue)
+			opt.benchOptions.threads = (unsigned)std::max(1, std::atoi(argv[++i]));
+		else
+		{
+			if (arg != "--help" && arg != "-h")
+				std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+			printUsage(argv[0]);
+			return false;
+		}
+	}
+	return true;
 }
 
 // ============================================================================
@@ -291,9 +1438,16 @@ void framebuffer_size_callback(GLFWwindow *window, int width, int height)
  *
  * Controles:
  * - ESC: Cerrar aplicación
- * - W/A/S/D: Movimiento horizontal
+ * - P: Alternar cámara libre / modelo de vuelo
+ * - Mouse: cabeceo/guiñada en ejes de la cámara (sin límite: loops)
+ * - W/A/S/D: Adelante/atrás/lateral según hacia dónde mira
  * - Q/E: Subir/bajar (con límite en el piso)
+ * - Z/C: Alabear izquierda/derecha; X: nivelar alas
  * - 1/2/3: Cambiar layout del HUD
+ *
+ * En modo física: W/S picar/tirar, A/D alabear, Q/E pedales, R/F acelerador.
+ * Con datos externos sólo quedan ESC y, al reproducir un log, ←/→ seek ±10 s,
+ * ↑/↓ velocidad ×2/÷2 y espacio pausa.
  */
 void processInput(GLFWwindow *window)
 {
@@ -303,29 +1457,108 @@ void processInput(GLFWwindow *window)
 		glfwSetWindowShouldClose(window, true);
 	}
 
-	// --- Movimiento de cámara (tipo vuelo libre) ---
-	float speed = kCameraSpeed * deltaTime;
-	glm::vec3 right = glm::normalize(glm::cross(cameraFront, cameraUp));
-
-	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) // Adelante
-		cameraPos += speed * cameraFront;
-	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) // Atrás
-		cameraPos -= speed * cameraFront;
-	if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) // Izquierda
-		cameraPos -= speed * right;
-	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) // Derecha
-		cameraPos += speed * right;
+	if (telemetryDriven)
+	{
+		if (!telemetryPlayback)
+			return;
+
+		// --- Reproducción (flancos de tecla) ---
+		static bool wasDown[4] = {false, false, false, false};
+		static double pausedSpeed = 1.0;
+		const int keys[4] = {GLFW_KEY_LEFT, GLFW_KEY_RIGHT, GLFW_KEY_UP, GLFW_KEY_DOWN};
+		bool pressed[4];
+		for (int k = 0; k < 4; ++k)
+		{
+			const bool down = glfwGetKey(window, keys[k]) == GLFW_PRESS;
+			pressed[k] = down && !wasDown[k];
+			wasDown[k] = down;
+		}
+		static bool spaceWasDown = false;
+		const bool spaceDown = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+
+		util::TelemetryPlayback &pb = *telemetryPlayback;
+		if (pressed[0])
+			pb.seek(pb.time() - 10.0);
+		if (pressed[1])
+			pb.seek(pb.time() + 10.0);
+		if (pressed[2] && pb.speed() != 0.0)
+			pb.setSpeed(pb.speed() * 2.0);
+		if (pressed[3] && pb.speed() != 0.0)
+			pb.setSpeed(pb.speed() * 0.5);
+		if (spaceDown && !spaceWasDown)
+		{
+			if (pb.speed() != 0.0)
+			{
+				pausedSpeed = pb.speed();
+				pb.setSpeed(0.0);
+			}
+			else
+				pb.setSpeed(pausedSpeed);
+		}
+		spaceWasDown = spaceDown;
+		return;
+	}
 
-	// --- Controles de altitud ---
-	if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) // Subir
-		cameraPos.y += speed;
-	if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) // Bajar
-		cameraPos.y -= speed;
+	// --- Cambio de modo (flanco de la tecla P) ---
+	static bool physicsKeyWasDown = false;
+	const bool physicsKeyDown = glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS;
+	if (physicsKeyDown && !physicsKeyWasDown)
+		setPhysicsMode(!physicsMode);
+	physicsKeyWasDown = physicsKeyDown;
 
-	// --- Colisión con el piso ---
-	if (cameraPos.y < kGroundLevel)
+	if (physicsMode)
+	{
+		// --- Mandos: el stick vuelve al centro al soltar, el acelerador se mantiene ---
+		auto axis = [window](int negative, int positive)
+		{
+			return (glfwGetKey(window, positive) == GLFW_PRESS ? 1.0f : 0.0f) -
+				   (glfwGetKey(window, negative) == GLFW_PRESS ? 1.0f : 0.0f);
+		};
+		controls.elevator = axis(GLFW_KEY_W, GLFW_KEY_S);
+		controls.aileron = axis(GLFW_KEY_A, GLFW_KEY_D);
+		controls.rudder = axis(GLFW_KEY_Q, GLFW_KEY_E);
+		controls.throttle = glm::clamp(controls.throttle + axis(GLFW_KEY_F, GLFW_KEY_R) * 0.5f * deltaTime, 0.0f, 1.0f);
+		dynamics.setControls(controls);
+	}
+	else
 	{
-		cameraPos.y = kGroundLevel;
+		// --- Movimiento de cámara (tipo vuelo libre) ---
+		float speed = kCameraSpeed * deltaTime;
+		const glm::vec3 &front = cameraAttitude.front();
+		const glm::vec3 &right = cameraAttitude.right();
+
+		if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) // Adelante
+			cameraPos += speed * front;
+		if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) // Atrás
+			cameraPos -= speed * front;
+		if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) // Izquierda
+			cameraPos -= speed * right;
+		if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) // Derecha
+			cameraPos += speed * right;
+
+		// --- Controles de altitud ---
+		if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) // Subir
+			cameraPos.y += speed;
+		if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) // Bajar
+			cameraPos.y -= speed;
+
+		// --- Alabeo ---
+		float roll = 0.0f;
+		if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS) // Izquierda
+			roll -= kCameraRollRate * deltaTime;
+		if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS) // Derecha
+			roll += kCameraRollRate * deltaTime;
+		if (roll != 0.0f)
+			cameraAttitude.rotate(flight::units::Degrees(0.0f), flight::units::Degrees(0.0f), flight::units::Degrees(roll));
+		if (glfwGetKey(window, GLFW_KEY_X) == GLFW_PRESS) // Nivelar
+			cameraAttitude.level();
+
+		// --- Colisión con el terreno ---
+		const float groundLevel = terrainHeights.height(cameraPos.x, cameraPos.z) + kGroundLevel;
+		if (cameraPos.y < groundLevel)
+		{
+			cameraPos.y = groundLevel;
+		}
 	}
 
 	// --- Controles de HUD (con anti-rebote) ---
@@ -334,36 +1567,26 @@ void processInput(GLFWwindow *window)
 
 	if (currentTime - lastLayoutChange > 0.5f)
 	{
-		// TODO sin manejo de layout por ahora
-		//  if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS)
-		//  {
-		//  	if (globalHUD)
-		//  		globalHUD->setLayout("classic");
-		//  	lastLayoutChange = currentTime;
-		//  	std::cout << "HUD Layout: Classic" << std::endl;
-		//  }
-		//  if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS)
-		//  {
-		//  	if (globalHUD)
-		//  		globalHUD->setLayout("modern");
-		//  	lastLayoutChange = currentTime;
-		//  	std::cout << "HUD Layout: Modern" << std::endl;
-		//  }
-		//  if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS)
-		//  {
-		//  	if (globalHUD)
-		//  		globalHUD->setLayout("minimal");
-		//  	lastLayoutChange = currentTime;
-		//  	std::cout << "HUD Layout: Minimal" << std::endl;
-		//  }
+		static const char *const LAYOUT_KEYS[] = {"classic", "modern", "minimal"}; // teclas 1/2/3
+		for (int k = 0; k < 3; ++k)
+		{
+			if (glfwGetKey(window, GLFW_KEY_1 + k) == GLFW_PRESS)
+			{
+				if (globalHUD)
+					globalHUD->setLayout(LAYOUT_KEYS[k]);
+				lastLayoutChange = currentTime;
+			}
+		}
 	}
 }
 
 /**
  * @brief Callback para manejar movimiento del mouse y rotación de cámara
  *
- * Implementa rotación tipo FPS usando ángulos de Euler (yaw/pitch).
- * El pitch está limitado a ±89° para evitar gimbal lock.
+ * Gira el quaternion de la cámara en sus propios ejes (cabeceo alrededor de
+ * right, guiñada alrededor de up): sin límite de pitch ni gimbal lock, así
+ * que se puede pasar por la vertical y hacer loops. Con alabeo, la guiñada
+ * es la del avión (alrededor de su eje vertical), no la del mundo.
  */
 void mouse_callback(GLFWwindow *window, double xpos, double ypos)
 {
@@ -385,22 +1608,8 @@ void mouse_callback(GLFWwindow *window, double xpos, double ypos)
 	xoffset *= kMouseSensitivity;
 	yoffset *= kMouseSensitivity;
 
-	// Actualizar ángulos de Euler
-	yaw += xoffset;
-	pitch += yoffset;
-
-	// Limitar pitch para evitar flip vertical (gimbal lock)
-	if (pitch > 89.0f)
-		pitch = 89.0f;
-	if (pitch < -89.0f)
-		pitch = -89.0f;
-
-	// Calcular vector dirección usando ángulos de Euler
-	glm::vec3 direction;
-	direction.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
-	direction.y = sin(glm::radians(pitch));
-	direction.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-	cameraFront = glm::normalize(direction);
+	// Girar en ejes de cámara (la base se recalcula una vez y queda cacheada)
+	cameraAttitude.rotate(flight::units::Degrees(yoffset), flight::units::Degrees(xoffset), flight::units::Degrees(0.0f));
 }
 
 /**
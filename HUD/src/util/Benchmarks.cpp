@@ -0,0 +1,1248 @@
+#include "Benchmarks.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include "flight/AirData.h"
+#include "flight/AircraftStateBatch.h"
+#include "flight/AttitudeBatch.h"
+#include "flight/FlightData.h"
+#include "flight/Heightfield.h"
+#include "flight/InstrumentHistory.h"
+#include "gfx/GLState.h"
+#include "gfx/RenderQueue.h"
+#include "gfx/Renderer2D.h"
+#include "gfx/SimpleCube.h"
+#include "gfx/SkyboxRenderer.h"
+#include "gfx/TerrainRenderer.h"
+#include "gfx/TextureCube.h"
+#include "hud/Altimeter.h"
+#include "hud/FlightHUD.h"
+#include "hud/InstrumentRegistry.h"
+#include "hud/SpeedIndicator.h"
+#include "util/ImageAtlas.h"
+#include "util/TelemetryLog.h"
+#include "util/WorkerPool.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace util {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const float kFrameDt = 1.0f / 60.0f; // el lote avanza al ritmo del render
+
+// Tráfico determinista: grilla de 1 km, rumbos y mandos variados
+void spawnTraffic(flight::AircraftStateBatch& batch, int count) {
+    batch.resize(count);
+    const int side = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(count))));
+    for (int i = 0; i < count; ++i) {
+        const glm::vec3 pos((i % side) * 1000.0f, 300.0f + (i % 7) * 150.0f, (i / side) * -1000.0f);
+        batch.spawn(i, pos, static_cast<float>((i * 37) % 360), 45.0f + (i % 5) * 5.0f);
+
+        flight::ControlInputs c;
+        c.throttle = 0.45f + (i % 4) * 0.05f;
+        c.aileron = ((i % 3) - 1) * 0.05f; // algunos viran suave
+        c.elevator = 0.02f;
+        batch.setControls(i, c);
+    }
+}
+
+int runTraffic(const BenchOptions& opt) {
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned maxThreads = opt.threads ? opt.threads : hw;
+    const int frames = std::max(1, static_cast<int>(opt.seconds / kFrameDt));
+
+    std::cout << "Traffic benchmark: " << opt.aircraft << " aircraft, " << opt.seconds
+              << " s simulated @ " << 1.0f / flight::AircraftStateBatch().stepSize() << " Hz, "
+              << "hardware threads " << hw << std::endl;
+    std::cout << "threads   ms/frame   aircraft-steps/s   x realtime   speedup" << std::endl;
+
+    // 1, 2, 4... mientras no alcance el máximo, y el máximo una vez
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(maxThreads);
+
+    double baseline = 0.0;
+    float checksum = 0.0f;
+    for (const unsigned threads : counts) {
+        flight::AircraftStateBatch batch;
+        spawnTraffic(batch, opt.aircraft);
+        WorkerPool pool(threads - 1); // el hilo llamador es el primero
+
+        long long steps = 0;
+        const Clock::time_point t0 = Clock::now();
+        for (int f = 0; f < frames; ++f)
+            steps += batch.advanceParallel(kFrameDt, pool);
+        const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+        if (threads == 1) baseline = sec;
+        checksum += batch.altitude[batch.size() / 2]; // evita que el optimizador descarte el trabajo
+
+        char line[128];
+        std::snprintf(line, sizeof(line), "%7u %10.3f %18.3e %12.1f %9.2f",
+                      threads, 1000.0 * sec / frames, static_cast<double>(steps) * opt.aircraft / sec,
+                      opt.seconds / sec, baseline / sec);
+        std::cout << line << std::endl;
+    }
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
+
+// Tolerancia del lote frente a FlightData::updateAttitude (grados)
+const float kAttitudeToleranceDeg = 0.01f;
+
+float angleError(float a, float b) {
+    const float d = std::fmod(std::abs(a - b), 360.0f);
+    return std::min(d, 360.0f - d);
+}
+
+/**
+ * Compara AttitudeBatch con FlightData::updateAttitude (la actitud de
+ * updateFromCamera, sin posición ni instrumentos derivados) sobre tracks
+ * aleatorios (semilla fija) y mide throughput de ambas. Falla si el error
+ * supera la tolerancia.
+ */
+int runAttitude(const BenchOptions& opt) {
+    const std::size_t n = static_cast<std::size_t>(opt.aircraft);
+    const int frames = std::max(1, static_cast<int>(opt.seconds / kFrameDt));
+    const float tau = flight::FlightData{}.tauAttitude;
+
+    // Trayectorias: yaw/pitch/roll con deriva aleatoria por track
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> start(-180.0f, 180.0f), drift(-2.0f, 2.0f);
+    std::vector<float> yaw(n), pitch(n), roll(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        yaw[i] = start(rng);
+        pitch[i] = start(rng) * 0.4f;
+        roll[i] = start(rng) * 0.5f;
+    }
+
+    flight::AttitudeBatch batch;
+    batch.resize(n);
+    std::vector<flight::FlightData> scalar(n);
+
+    double scalarSec = 0.0, batchSec = 0.0;
+    float maxErr = 0.0f;
+    for (int f = 0; f < frames; ++f) {
+        for (std::size_t i = 0; i < n; ++i) {
+            yaw[i] += drift(rng);
+            pitch[i] = std::clamp(pitch[i] + drift(rng), -85.0f, 85.0f);
+            roll[i] = std::clamp(roll[i] + drift(rng), -170.0f, 170.0f);
+
+            const float y = glm::radians(yaw[i]), p = glm::radians(pitch[i]), r = glm::radians(roll[i]);
+            const glm::vec3 front(std::cos(y) * std::cos(p), std::sin(p), std::sin(y) * std::cos(p));
+            const glm::vec3 right = glm::normalize(glm::cross(front, glm::vec3(0.0f, 1.0f, 0.0f)));
+            const glm::vec3 up = glm::cross(right, front) * std::cos(r) + right * std::sin(r);
+
+            batch.frontX[i] = front.x; batch.frontY[i] = front.y; batch.frontZ[i] = front.z;
+            batch.upX[i] = up.x; batch.upY[i] = up.y; batch.upZ[i] = up.z;
+        }
+
+        Clock::time_point t0 = Clock::now();
+        for (std::size_t i = 0; i < n; ++i) {
+            const glm::vec3 front(batch.frontX[i], batch.frontY[i], batch.frontZ[i]);
+            const glm::vec3 up(batch.upX[i], batch.upY[i], batch.upZ[i]);
+            scalar[i].updateAttitude(front, up, kFrameDt);
+        }
+        Clock::time_point t1 = Clock::now();
+        batch.update(kFrameDt, tau);
+        Clock::time_point t2 = Clock::now();
+
+        scalarSec += std::chrono::duration<double>(t1 - t0).count();
+        batchSec += std::chrono::duration<double>(t2 - t1).count();
+
+        for (std::size_t i = 0; i < n; ++i) {
+            maxErr = std::max(maxErr, angleError(batch.pitch[i], scalar[i].pitch.value()));
+            maxErr = std::max(maxErr, angleError(batch.roll[i], scalar[i].roll.value()));
+            maxErr = std::max(maxErr, angleError(batch.heading[i], scalar[i].heading.value()));
+        }
+    }
+
+    const double bases = static_cast<double>(n) * frames;
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "Attitude: %zu tracks x %d frames | escalar %.1f Mbases/s | lote %.1f Mbases/s | x%.2f",
+                  n, frames, bases / scalarSec * 1e-6, bases / batchSec * 1e-6, scalarSec / batchSec);
+    std::cout << line << std::endl;
+
+    const bool ok = maxErr <= kAttitudeToleranceDeg;
+    std::cout << "Max error vs escalar: " << maxErr << " deg (tolerancia " << kAttitudeToleranceDeg
+              << ") " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : -1;
+}
+
+// Telemetría: una hora a 1 kHz (un vuelo de 60 s repetido con el tiempo desplazado)
+const double kTelemetryRateHz = 1000.0;
+const double kTelemetrySeconds = 3600.0;
+const int kTelemetryLoopSamples = 60000;
+const int kTelemetrySeeks = 1000;
+
+TelemetrySample telemetrySample(const std::vector<TelemetrySample>& loop, std::size_t i) {
+    TelemetrySample s = loop[i % loop.size()];
+    s.time = static_cast<double>(i) / kTelemetryRateHz;
+    return s;
+}
+
+/**
+ * Escribe una hora de telemetría con cada codec, la relee completa (debe ser
+ * idéntica bit a bit) y mide seeks aleatorios. Falla si algo no coincide.
+ */
+int runTelemetry(const BenchOptions&) {
+    // Vuelo de referencia: un avión con mandos suaves, muestreado a 1 kHz
+    flight::AircraftStateBatch batch;
+    batch.resize(1);
+    batch.spawn(0, glm::vec3(0.0f, 300.0f, 0.0f), 90.0f, 55.0f);
+    flight::ControlInputs c;
+    c.aileron = 0.03f;
+    c.elevator = 0.02f;
+    batch.setControls(0, c);
+
+    std::vector<TelemetrySample> loop(kTelemetryLoopSamples);
+    for (int i = 0; i < kTelemetryLoopSamples; ++i) {
+        batch.advance(static_cast<float>(1.0 / kTelemetryRateHz));
+        batch.updateInstruments();
+        loop[i] = TelemetrySample::fromFlightData(batch.view(0), 0.0);
+    }
+
+    const std::size_t total = static_cast<std::size_t>(kTelemetrySeconds * kTelemetryRateHz);
+    const std::string path = (std::filesystem::temp_directory_path() / "hud_telemetry_bench.htl").string();
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<double> seekTime(0.0, kTelemetrySeconds);
+    bool ok = true;
+
+    for (TelemetryCodec codec : {TelemetryCodec::Raw, TelemetryCodec::Xor}) {
+        const char* codecName = codec == TelemetryCodec::Raw ? "raw" : "xor";
+
+        // --- Escritura: push() medido aparte del total (el hilo escritor corre en paralelo) ---
+        TelemetryWriter writer;
+        TelemetryWriter::Options wo;
+        wo.codec = codec;
+        if (!writer.open(path, wo))
+            return -1;
+
+        double pushSec = 0.0;
+        std::uint64_t retries = 0;
+        const Clock::time_point start = Clock::now();
+        for (std::size_t i = 0; i < total; ++i) {
+            const TelemetrySample s = telemetrySample(loop, i);
+            const Clock::time_point t0 = Clock::now();
+            // El bench empuja mucho más rápido que 1 kHz: si la cola se llena, esperar al escritor
+            while (!writer.push(s)) {
+                ++retries;
+                std::this_thread::yield();
+            }
+            pushSec += std::chrono::duration<double>(Clock::now() - t0).count();
+        }
+        writer.close();
+        const double writeSec = std::chrono::duration<double>(Clock::now() - start).count();
+        const TelemetryWriter::Stats ws = writer.stats();
+
+        // --- Lectura completa: debe reproducir exactamente lo escrito ---
+        TelemetryReader reader;
+        if (!reader.open(path))
+            return -1;
+        const std::uintmax_t fileBytes = std::filesystem::file_size(path);
+
+        Clock::time_point t0 = Clock::now();
+        TelemetrySample got;
+        std::size_t read = 0, mismatches = 0;
+        while (reader.next(got)) {
+            const TelemetrySample want = telemetrySample(loop, read++);
+            if (std::memcmp(got.values, want.values, sizeof(want.values)) != 0 ||
+                std::abs(got.time - want.time) > 1e-6)
+                ++mismatches;
+        }
+        const double readSec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+        // --- Seeks aleatorios ---
+        std::size_t badSeeks = 0;
+        t0 = Clock::now();
+        for (int k = 0; k < kTelemetrySeeks; ++k) {
+            const double t = seekTime(rng);
+            if (!reader.seek(t) || !reader.next(got) || got.time < t - 1e-6 || got.time > t + 1.0 / kTelemetryRateHz + 1e-6)
+                ++badSeeks;
+        }
+        const double seekSec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+        char line[200];
+        std::snprintf(line, sizeof(line),
+                      "Telemetry %s: %zu samples | %.1f ns/push | write %.2f Msamples/s | %.2f bytes/sample "
+                      "(%.1f MB, %zu chunks)",
+                      codecName, total, pushSec / total * 1e9, total / writeSec * 1e-6,
+                      static_cast<double>(ws.bytes) / total, fileBytes / 1e6, reader.chunkCount());
+        std::cout << line << std::endl;
+        std::snprintf(line, sizeof(line), "  read %.2f Msamples/s | seek %.1f us (%d aleatorios) | cola llena %llu veces",
+                      read / readSec * 1e-6, seekSec / kTelemetrySeeks * 1e6, kTelemetrySeeks,
+                      static_cast<unsigned long long>(retries));
+        std::cout << line << std::endl;
+
+        if (read != total || ws.written != total || mismatches || badSeeks) {
+            std::cout << "  FAIL: leídas " << read << "/" << total << ", " << mismatches << " distintas, "
+                      << badSeeks << " seeks malos" << std::endl;
+            ok = false;
+        }
+        reader.close();
+    }
+
+    std::filesystem::remove(path);
+    return ok ? 0 : -1;
+}
+
+// Tolerancias de las tablas de AirData frente a las fórmulas directas
+const float kAirDataDensityTolerance = 1e-4f; // relativo
+const float kAirDataAltitudeToleranceFt = 1.0f;
+const float kAirDataSpeedToleranceKt = 0.05f;
+
+// Atmósfera no estándar y viento cizallado: ejercita todos los términos
+flight::AirDataConfig airDataBenchConfig() {
+    using namespace flight::units::literals;
+    flight::AirDataConfig c;
+    c.seaLevelPressure = 99500.0f;
+    c.altimeterSetting = 99500.0f;
+    c.temperatureOffset = 12.0f;
+    c.fieldElevation = 450_m;
+    c.wind = {{0_m, 240_deg, 8_kt}, {600_m, 270_deg, 25_kt}, {3000_m, 290_deg, 60_kt}};
+    return c;
+}
+
+/**
+ * Lo mismo que una entrada de las tablas, pero con pow/exp en cada llamada:
+ * TAS/IAS en kt y altitud indicada en ft para la altitud geométrica MSL h.
+ */
+void directAirData(const flight::AirDataConfig& c, float h, float vx, float vy, float vz,
+                   float& tasKt, float& iasKt, float& altitudeFt, float& density) {
+    using flight::AirData;
+    const float mpsToKt = flight::units::factor<flight::units::MetersPerSecond, flight::units::Knots>();
+    const float mToFt = flight::units::factor<flight::units::Meters, flight::units::Feet>();
+
+    const double p = c.seaLevelPressure / static_cast<double>(AirData::kSeaLevelPressure) *
+                     AirData::kSeaLevelPressure * AirData::isaPressureRatio(h);
+    const double t = AirData::kSeaLevelTemperature - AirData::kLapseRate * std::min(h, AirData::kTropopause);
+    density = static_cast<float>(p / (AirData::kGasConstant * (t + c.temperatureOffset)));
+
+    // Viento: búsqueda lineal entre capas (misma convención que configure)
+    float wx = 0.0f, wz = 0.0f;
+    const float above = h - c.fieldElevation.value();
+    auto components = [](const flight::WindLayer& l, float& x, float& z) {
+        const float from = flight::units::Radians(l.fromDirection).value();
+        const float speed = flight::units::MetersPerSecond(l.speed).value();
+        x = -speed * std::sin(from);
+        z = speed * std::cos(from);
+    };
+    if (!c.wind.empty()) {
+        std::size_t k = 0;
+        while (k < c.wind.size() && c.wind[k].altitude.value() <= above)
+            ++k;
+        if (k == 0 || k == c.wind.size()) {
+            components(k == 0 ? c.wind.front() : c.wind.back(), wx, wz);
+        } else {
+            float x0, z0, x1, z1;
+            components(c.wind[k - 1], x0, z0);
+            components(c.wind[k], x1, z1);
+            const float f = (above - c.wind[k - 1].altitude.value()) /
+                            (c.wind[k].altitude - c.wind[k - 1].altitude).value();
+            wx = x0 + (x1 - x0) * f;
+            wz = z0 + (z1 - z0) * f;
+        }
+    }
+
+    const float ax = vx - wx, az = vz - wz;
+    const float tas = std::sqrt(ax * ax + vy * vy + az * az);
+    tasKt = tas * mpsToKt;
+    iasKt = tas * std::sqrt(density / AirData::kSeaLevelDensity) * mpsToKt;
+    altitudeFt = (AirData::isaPressureAltitude(static_cast<float>(p)) -
+                  AirData::isaPressureAltitude(c.altimeterSetting)) * mToFt;
+}
+
+/**
+ * Barrido de altitud (tablas vs fórmulas) y throughput del lote SoA contra la
+ * versión directa por avión. Falla si algún error supera su tolerancia.
+ */
+int runAirData(const BenchOptions& opt) {
+    const flight::AirDataConfig config = airDataBenchConfig();
+    const flight::AirData air(config);
+    const float datumOffset = config.fieldElevation.value() - flight::FlightData::kAltitudeDatum.value();
+
+    // --- Precisión: cada 0.37 m (no alineado con la grilla) ---
+    float densityErr = 0.0f, altitudeErr = 0.0f, speedErr = 0.0f;
+    for (float h = flight::AirData::kMinAltitude; h < flight::AirData::kMaxAltitude; h += 0.37f) {
+        const glm::vec3 pos(0.0f, h - datumOffset, 0.0f), vel(40.0f, 3.0f, -35.0f);
+        float tas, ias, alt, rho;
+        directAirData(config, h, vel.x, vel.y, vel.z, tas, ias, alt, rho);
+        const flight::AirDataSample s = air.evaluate(pos, vel);
+
+        densityErr = std::max(densityErr, std::abs(air.density(h) - rho) / rho);
+        altitudeErr = std::max(altitudeErr, std::abs(s.indicatedAltitude.value() - alt));
+        speedErr = std::max(speedErr, std::abs(s.indicatedAirspeed.value() - ias));
+        speedErr = std::max(speedErr, std::abs(s.trueAirspeed.value() - tas));
+    }
+
+    // --- Throughput: tráfico aleatorio entre el campo y FL350 ---
+    const std::size_t n = static_cast<std::size_t>(opt.aircraft);
+    const int frames = std::max(1, static_cast<int>(opt.seconds / kFrameDt));
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> alt(0.0f, 10700.0f), v(-80.0f, 80.0f);
+    std::vector<float> posY(n), velX(n), velY(n), velZ(n), tas(n), ias(n), indicated(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        posY[i] = alt(rng);
+        velX[i] = v(rng);
+        velY[i] = v(rng) * 0.1f;
+        velZ[i] = v(rng);
+    }
+
+    double directSec = 0.0, tableSec = 0.0;
+    volatile float sink = 0.0f; // que el compilador no descarte la versión directa
+    for (int f = 0; f < frames; ++f) {
+        Clock::time_point t0 = Clock::now();
+        for (std::size_t i = 0; i < n; ++i) {
+            float t, a, h, rho;
+            directAirData(config, posY[i] + datumOffset, velX[i], velY[i], velZ[i], t, a, h, rho);
+            sink = sink + a + h;
+        }
+        Clock::time_point t1 = Clock::now();
+        air.evaluate(posY.data(), velX.data(), velY.data(), velZ.data(), tas.data(), ias.data(), indicated.data(), n);
+        Clock::time_point t2 = Clock::now();
+
+        directSec += std::chrono::duration<double>(t1 - t0).count();
+        tableSec += std::chrono::duration<double>(t2 - t1).count();
+    }
+
+    const double samples = static_cast<double>(n) * frames;
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "AirData: %zu aviones x %d frames | directo %.1f Mmuestras/s | tablas %.1f Mmuestras/s | x%.1f",
+                  n, frames, samples / directSec * 1e-6, samples / tableSec * 1e-6, directSec / tableSec);
+    std::cout << line << std::endl;
+    std::cout << "(tablas de " << flight::AirData::kTableStep
+              << " m entre " << flight::AirData::kMinAltitude << " y " << flight::AirData::kMaxAltitude << " m)"
+              << std::endl;
+
+    const bool ok = densityErr <= kAirDataDensityTolerance && altitudeErr <= kAirDataAltitudeToleranceFt &&
+                    speedErr <= kAirDataSpeedToleranceKt;
+    std::cout << "Max error: densidad " << densityErr << " (rel, tolerancia " << kAirDataDensityTolerance
+              << ") | altitud " << altitudeErr << " ft (" << kAirDataAltitudeToleranceFt << ") | velocidad "
+              << speedErr << " kt (" << kAirDataSpeedToleranceKt << ") " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : -1;
+}
+
+// Terreno: consultas por corrida y rayos verificados contra la marcha de referencia
+const int kTerrainQueries = 1 << 20;
+const int kTerrainRays = 1 << 18;
+const int kTerrainCheckedRays = 4000;
+const int kTerrainEdgeRays = 2000;         // alineados con los ejes, sobre líneas de la grilla
+const float kTerrainMarchStep = 0.25f;     // m, paso de la marcha de referencia
+const float kTerrainHitTolerance = 0.01f;  // m
+const double kTerrainTargetPerSecond = 1e6;
+
+// Primer cruce por marcha fija + bisección (lento, pero sin jerarquía ni cuadrática)
+bool marchRay(const flight::Heightfield& terrain, const glm::vec3& o, const glm::vec3& d, float maxDistance, float& t) {
+    auto above = [&](float s) {
+        const glm::vec3 p = o + d * s;
+        return p.y - terrain.height(p.x, p.z);
+    };
+    float prev = 0.0f;
+    for (float s = kTerrainMarchStep; s <= maxDistance + kTerrainMarchStep; s += kTerrainMarchStep) {
+        const float cur = std::min(s, maxDistance);
+        const glm::vec3 p = o + d * cur;
+        if (std::max(std::abs(p.x), std::abs(p.z)) > terrain.halfExtent())
+            return false; // raycast sólo cubre la grilla
+        if (above(cur) <= 0.0f) {
+            float lo = prev, hi = cur;
+            for (int k = 0; k < 40; ++k) {
+                const float mid = 0.5f * (lo + hi);
+                (above(mid) > 0.0f ? lo : hi) = mid;
+            }
+            t = hi;
+            return true;
+        }
+        prev = cur;
+    }
+    return false;
+}
+
+double perSecond(double count, Clock::time_point t0, Clock::time_point t1) {
+    return count / std::chrono::duration<double>(t1 - t0).count();
+}
+
+/**
+ * Heightfield por defecto: throughput de altura, altura+normal y raycast en un
+ * hilo, y verificación de los rayos contra una marcha de referencia (ningún
+ * cruce que la marcha vea puede faltar, todo impacto debe estar sobre la
+ * superficie). Falla sólo por errores, no por velocidad.
+ */
+int runTerrain(const BenchOptions&) {
+    Clock::time_point b0 = Clock::now();
+    const flight::Heightfield terrain{flight::HeightfieldConfig{}};
+    Clock::time_point b1 = Clock::now();
+    const float extent = terrain.halfExtent();
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> xz(-extent, extent), unit(0.0f, 1.0f);
+    std::vector<float> px(kTerrainQueries), pz(kTerrainQueries);
+    for (int i = 0; i < kTerrainQueries; ++i) {
+        px[i] = xz(rng);
+        pz[i] = xz(rng);
+    }
+
+    // Rayos de radioaltímetro y línea de vista: 20-400 m sobre el suelo, 1°-60° hacia abajo
+    std::vector<glm::vec3> origins(kTerrainRays), dirs(kTerrainRays);
+    for (int i = 0; i < kTerrainRays; ++i) {
+        const float x = xz(rng) * 0.8f, z = xz(rng) * 0.8f;
+        origins[i] = glm::vec3(x, terrain.height(x, z) + 20.0f + 380.0f * unit(rng), z);
+        const float azimuth = 6.2831853f * unit(rng), depression = glm::radians(1.0f + 59.0f * unit(rng));
+        dirs[i] = glm::vec3(std::cos(azimuth) * std::cos(depression), -std::sin(depression),
+                            std::sin(azimuth) * std::cos(depression));
+    }
+    const float maxDistance = 3000.0f;
+
+    // Radioaltímetro: un rayo hacia abajo cada ~2.5 cm de una trayectoria que cruza el mapa
+    // (consultas coherentes, como las de un avión en vuelo)
+    const glm::vec3 trackStart(-0.75f * extent, 0.0f, -0.3f * extent), trackStep(0.023f, 0.0f, 0.0092f);
+    const float radarRange = flight::units::Meters(flight::FlightData::kRadarAltimeterRange).value();
+
+    Clock::time_point t0 = Clock::now();
+    float acc = 0.0f; // checksum: que el compilador no descarte las consultas
+    for (int i = 0; i < kTerrainQueries; ++i)
+        acc += terrain.height(px[i], pz[i]);
+    Clock::time_point t1 = Clock::now();
+    glm::vec3 n(0.0f);
+    for (int i = 0; i < kTerrainQueries; ++i) {
+        glm::vec3 ni;
+        acc += terrain.height(px[i], pz[i], ni);
+        n += ni;
+    }
+    Clock::time_point t2 = Clock::now();
+    int hits = 0;
+    flight::TerrainHit hit;
+    for (int i = 0; i < kTerrainRays; ++i)
+        hits += terrain.raycast(origins[i], dirs[i], maxDistance, hit) ? 1 : 0;
+    Clock::time_point t3 = Clock::now();
+    for (int i = 0; i < kTerrainRays; ++i) {
+        glm::vec3 p = trackStart + trackStep * static_cast<float>(i);
+        p.y = 150.0f + 60.0f * std::sin(i * 1e-4f);
+        acc += terrain.raycast(p, glm::vec3(0.0f, -1.0f, 0.0f), radarRange, hit) ? hit.distance : 0.0f;
+    }
+    Clock::time_point t4 = Clock::now();
+    acc += n.y;
+
+    const double heights = perSecond(kTerrainQueries, t0, t1);
+    const double normals = perSecond(kTerrainQueries, t1, t2);
+    const double rays = perSecond(kTerrainRays, t2, t3);
+    const double radar = perSecond(kTerrainRays, t3, t4);
+    char line[200];
+    std::snprintf(line, sizeof(line),
+                  "Terrain: %dx%d celdas de %.0f m (build %.0f ms) | altura %.1f M/s | altura+normal %.1f M/s",
+                  terrain.samplesPerSide() - 1, terrain.samplesPerSide() - 1, terrain.spacing(),
+                  std::chrono::duration<double, std::milli>(b1 - b0).count(), heights * 1e-6, normals * 1e-6);
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line),
+                  "Raycast: aleatorios hasta %.0f m %.2f M/s (%d%% impactan) | radioaltímetro en vuelo %.2f M/s",
+                  maxDistance, rays * 1e-6, hits * 100 / kTerrainRays, radar * 1e-6);
+    std::cout << line << std::endl;
+    auto target = [](double rate) { return rate >= kTerrainTargetPerSecond ? "OK" : "NO"; };
+    std::cout << "Objetivo 1 M consultas/s en un hilo: altura " << target(heights) << ", raycast aleatorio "
+              << target(rays) << ", radioaltímetro " << target(radar) << " (checksum " << acc << ")" << std::endl;
+
+    // Casos borde: componentes de la dirección exactamente en cero con el origen sobre
+    // una línea de la grilla (x = 0 es borde de todos los bloques). Radioaltímetro con
+    // alas niveladas (0,-1,0), línea de vista horizontal y rayos en un plano vertical
+    const float spacing = terrain.spacing();
+    std::uniform_int_distribution<int> gridLine(-static_cast<int>(0.8f * extent / spacing), static_cast<int>(0.8f * extent / spacing));
+    const glm::vec3 axisDirs[] = {{0.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f},
+                                  {0.0f, 0.0f, -1.0f}, {1.0f, -0.1f, 0.0f}, {0.0f, -0.2f, -1.0f}};
+    const int axisCount = static_cast<int>(sizeof(axisDirs) / sizeof(axisDirs[0]));
+    for (int i = 0; i < kTerrainEdgeRays; ++i) {
+        // Un cuarto en x = 0 / z = 0 exactos, el resto en líneas de la grilla al azar
+        const float x = i % 4 == 0 ? 0.0f : gridLine(rng) * spacing, z = i % 8 == 0 ? 0.0f : gridLine(rng) * spacing;
+        const glm::vec3 d = axisDirs[i % axisCount];
+        const float clearance = d.y < 0.0f ? 20.0f + 380.0f * unit(rng) : 2.0f + 20.0f * unit(rng);
+        origins.push_back(glm::vec3(x, terrain.height(x, z) + clearance, z));
+        dirs.push_back(glm::normalize(d)); // marchRay mide t en metros
+    }
+
+    // --- Verificación contra la marcha ---
+    int missed = 0, offSurface = 0;
+    float worstLate = 0.0f;
+    auto check = [&](const glm::vec3& origin, const glm::vec3& dir) {
+        float tm;
+        const bool marched = marchRay(terrain, origin, dir, maxDistance, tm);
+        const bool found = terrain.raycast(origin, dir, maxDistance, hit);
+        if (found && std::abs(hit.point.y - terrain.height(hit.point.x, hit.point.z)) > kTerrainHitTolerance)
+            ++offSurface;
+        // Un cruce rasante puede escaparse de la marcha, nunca de la jerarquía
+        if (marched && (!found || hit.distance > tm + kTerrainHitTolerance)) {
+            ++missed;
+            worstLate = std::max(worstLate, found ? hit.distance - tm : maxDistance);
+        }
+    };
+    for (int i = 0; i < kTerrainCheckedRays; ++i)
+        check(origins[i], dirs[i]);
+    for (int i = 0; i < kTerrainEdgeRays; ++i)
+        check(origins[kTerrainRays + i], dirs[kTerrainRays + i]);
+
+    const bool ok = missed == 0 && offSurface == 0;
+    std::cout << "Raycast vs marcha (" << kTerrainCheckedRays << " rayos + " << kTerrainEdgeRays
+              << " alineados a la grilla): " << missed << " perdidos (peor " << worstLate << " m), " << offSurface
+              << " fuera de la superficie " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : -1;
+}
+
+// HUD 2D: muchos instrumentos con tapes recortados (scissor + máscara cada uno)
+const int kHudInstrumentPairs = 32; // altímetro + velocímetro por par
+const int kHudFrames = 2000;
+const size_t kHudMaxDrawCalls = 3;  // sin máscara, escritura de máscaras, contenido
+const GLuint kHudIconTexture = 7;   // id cualquiera: sin contexto GL sólo cuenta como estado
+const unsigned kHudMaxWorkers = 4;   // como FlightHUD
+
+/**
+ * Graba un frame de muchos instrumentos en Renderer2D y arma la lista de
+ * draw calls (sin GL): comandos grabados (= draw calls sin ordenar) contra
+ * draw calls después de ordenar y fusionar. Con íconos intercalados se
+ * agrega a lo sumo un estado (la textura). Falla si se pasa del tope.
+ */
+int runHud2D(const BenchOptions&) {
+    std::vector<std::unique_ptr<hud::Instrument>> instruments;
+    for (int i = 0; i < kHudInstrumentPairs; ++i) {
+        const glm::vec2 cell(static_cast<float>(i % 8) * 320.0f, static_cast<float>(i / 8) * 520.0f);
+        auto speed = std::make_unique<hud::SpeedIndicator>();
+        speed->setPosition(cell);
+        speed->setSize(glm::vec2(120.0f, 450.0f));
+        auto altimeter = std::make_unique<hud::Altimeter>();
+        altimeter->setPosition(cell + glm::vec2(160.0f, 0.0f));
+        altimeter->setSize(glm::vec2(120.0f, 450.0f));
+        instruments.push_back(std::move(speed));
+        instruments.push_back(std::move(altimeter));
+    }
+
+    gfx::Renderer2D renderer;
+    flight::FlightData data;
+    bool ok = true;
+    for (int icons = 0; icons <= 1; ++icons) {
+        double sec = 0.0;
+        gfx::Renderer2D::Stats stats;
+        for (int f = 0; f < kHudFrames; ++f) {
+            data.altitude = flight::units::Feet(1000.0f + static_cast<float>(f) * 3.7f);
+            data.airspeed = flight::units::Knots(90.0f + static_cast<float>(f % 400) * 0.25f);
+
+            Clock::time_point t0 = Clock::now();
+            renderer.begin();
+            for (const auto& instrument : instruments) {
+                instrument->render(renderer, data);
+                if (icons)
+                    renderer.drawImage(instrument->getPosition(), glm::vec2(16.0f), kHudIconTexture);
+            }
+            renderer.buildDrawList();
+            sec += std::chrono::duration<double>(Clock::now() - t0).count();
+            stats = renderer.stats();
+        }
+
+        const size_t limit = kHudMaxDrawCalls + icons;
+        const bool pass = stats.drawCalls <= limit;
+        ok = ok && pass;
+        char line[200];
+        std::snprintf(line, sizeof(line),
+                      "HUD 2D%s: %zu instrumentos | %zu comandos -> %zu draw calls (tope %zu) | %zu vértices | %.1f us/frame %s",
+                      icons ? " + íconos" : "", instruments.size(), stats.commands, stats.drawCalls, limit,
+                      stats.vertices, sec / kHudFrames * 1e6, pass ? "OK" : "FAIL");
+        std::cout << line << std::endl;
+    }
+    std::cout << "(us/frame = grabar + ordenar + fusionar en CPU; sin ordenar sería un draw call por comando)" << std::endl;
+
+    // Serie contra arenas por instrumento en el pool (como FlightHUD): mismo
+    // resultado, la grabación repartida entre núcleos
+    WorkerPool pool(WorkerPool::defaultWorkers(kHudMaxWorkers));
+    std::vector<std::unique_ptr<gfx::Renderer2D>> arenas;
+    for (size_t i = 0; i < instruments.size(); ++i)
+        arenas.push_back(std::make_unique<gfx::Renderer2D>());
+
+    gfx::Renderer2D::Stats serialStats, parallelStats;
+    double serialSec = 0.0, parallelSec = 0.0;
+    for (int f = 0; f < kHudFrames; ++f) {
+        data.altitude = flight::units::Feet(1000.0f + static_cast<float>(f) * 3.7f);
+        data.airspeed = flight::units::Knots(90.0f + static_cast<float>(f % 400) * 0.25f);
+
+        Clock::time_point t0 = Clock::now();
+        renderer.begin();
+        for (const auto& instrument : instruments)
+            instrument->render(renderer, data);
+        renderer.buildDrawList();
+        Clock::time_point t1 = Clock::now();
+        serialStats = renderer.stats();
+
+        renderer.begin();
+        pool.parallelFor(instruments.size(), [&](size_t i) {
+            arenas[i]->begin();
+            instruments[i]->render(*arenas[i], data);
+        });
+        for (const auto& arena : arenas)
+            renderer.append(*arena);
+        renderer.buildDrawList();
+        Clock::time_point t2 = Clock::now();
+        parallelStats = renderer.stats();
+
+        serialSec += std::chrono::duration<double>(t1 - t0).count();
+        parallelSec += std::chrono::duration<double>(t2 - t1).count();
+    }
+
+    const bool same = serialStats.commands == parallelStats.commands &&
+                      serialStats.drawCalls == parallelStats.drawCalls &&
+                      serialStats.vertices == parallelStats.vertices && serialStats.indices == parallelStats.indices;
+    ok = ok && same;
+    char line[200];
+    std::snprintf(line, sizeof(line),
+                  "HUD 2D paralelo (%u workers + llamador): %.1f us/frame contra %.1f en serie (x%.2f) | %zu draw calls %s",
+                  pool.workers(), parallelSec / kHudFrames * 1e6, serialSec / kHudFrames * 1e6,
+                  parallelSec > 0.0 ? serialSec / parallelSec : 0.0, parallelStats.drawCalls,
+                  same ? "OK" : "FAIL (distinto de serie)");
+    std::cout << line << std::endl;
+    return ok ? 0 : -1;
+}
+
+// Registro de instrumentos: pools por tipo contra el vector de unique_ptr
+const int kRegistryInstruments = 1000; // mitad altímetros, mitad velocímetros
+const int kRegistryFrames = 100;
+const int kRegistryChecks = 2000;      // pasadas de sameDisplay (poco trabajo por instrumento)
+
+/**
+ * Los mismos 1000 instrumentos como antes en FlightHUD (unique_ptr
+ * intercalados, render() virtual por instrumento) y en InstrumentRegistry
+ * (un pool por tipo, loop no virtual). Se graba y ordena cada frame (sin GL)
+ * y se recorre sameDisplay con datos iguales (sin corte temprano). Falla si
+ * la geometría difiere: el orden cambia, los draw calls y vértices no.
+ */
+int runInstruments(const BenchOptions&) {
+    const int altimeterType = hud::InstrumentRegistry::typeIndex("altimeter");
+    const int speedType = hud::InstrumentRegistry::typeIndex("speed");
+    if (altimeterType < 0 || speedType < 0) {
+        std::cerr << "Altimeter/SpeedIndicator not registered" << std::endl;
+        return -1;
+    }
+
+    std::vector<std::unique_ptr<hud::Instrument>> scattered;
+    hud::InstrumentRegistry registry;
+    for (int i = 0; i < kRegistryInstruments; ++i) {
+        const glm::vec2 cell(static_cast<float>(i % 40) * 160.0f, static_cast<float>(i / 40) * 520.0f);
+        const bool altimeter = (i % 2) == 0;
+        std::unique_ptr<hud::Instrument> instrument;
+        if (altimeter)
+            instrument = std::make_unique<hud::Altimeter>();
+        else
+            instrument = std::make_unique<hud::SpeedIndicator>();
+        hud::Instrument& pooled = registry.add(static_cast<size_t>(altimeter ? altimeterType : speedType));
+        for (hud::Instrument* target : {instrument.get(), &pooled}) {
+            target->setPosition(cell);
+            target->setSize(glm::vec2(120.0f, 450.0f));
+        }
+        scattered.push_back(std::move(instrument));
+    }
+
+    gfx::Renderer2D renderer;
+    flight::FlightData data;
+    gfx::Renderer2D::Stats virtualStats, pooledStats;
+    double virtualSec = 0.0, pooledSec = 0.0;
+    for (int f = 0; f < kRegistryFrames; ++f) {
+        data.altitude = flight::units::Feet(1000.0f + static_cast<float>(f) * 3.7f);
+        data.airspeed = flight::units::Knots(90.0f + static_cast<float>(f % 400) * 0.25f);
+
+        Clock::time_point t0 = Clock::now();
+        renderer.begin();
+        for (const auto& instrument : scattered) {
+            if (instrument->isEnabled())
+                instrument->render(renderer, data);
+        }
+        renderer.buildDrawList();
+        Clock::time_point t1 = Clock::now();
+        virtualStats = renderer.stats();
+
+        renderer.begin();
+        registry.render(renderer, data);
+        renderer.buildDrawList();
+        Clock::time_point t2 = Clock::now();
+        pooledStats = renderer.stats();
+
+        virtualSec += std::chrono::duration<double>(t1 - t0).count();
+        pooledSec += std::chrono::duration<double>(t2 - t1).count();
+    }
+
+    // sameDisplay con los mismos datos: todos responden true, se recorren todos
+    size_t virtualSame = 0, pooledSame = 0;
+    Clock::time_point t0 = Clock::now();
+    for (int c = 0; c < kRegistryChecks; ++c) {
+        bool same = true;
+        for (const auto& instrument : scattered) {
+            if (instrument->isEnabled() && !instrument->sameDisplay(data, data)) {
+                same = false;
+                break;
+            }
+        }
+        virtualSame += same;
+    }
+    Clock::time_point t1 = Clock::now();
+    for (int c = 0; c < kRegistryChecks; ++c)
+        pooledSame += registry.sameDisplay(data, data);
+    Clock::time_point t2 = Clock::now();
+    const double checks = static_cast<double>(kRegistryChecks) * kRegistryInstruments;
+    const double virtualNs = std::chrono::duration<double>(t1 - t0).count() / checks * 1e9;
+    const double pooledNs = std::chrono::duration<double>(t2 - t1).count() / checks * 1e9;
+
+    const bool same = virtualStats.drawCalls == pooledStats.drawCalls &&
+                      virtualStats.vertices == pooledStats.vertices && virtualStats.indices == pooledStats.indices &&
+                      virtualSame == pooledSame;
+    char line[200];
+    std::snprintf(line, sizeof(line),
+                  "Render %d instrumentos: pools %.1f us/frame contra %.1f virtual (x%.2f) | %zu -> %zu comandos, %zu draw calls",
+                  kRegistryInstruments, pooledSec / kRegistryFrames * 1e6, virtualSec / kRegistryFrames * 1e6,
+                  pooledSec > 0.0 ? virtualSec / pooledSec : 0.0, virtualStats.commands, pooledStats.commands,
+                  pooledStats.drawCalls);
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "sameDisplay: pools %.2f ns/instrumento contra %.2f virtual (x%.2f) %s",
+                  pooledNs, virtualNs, pooledNs > 0.0 ? virtualNs / pooledNs : 0.0,
+                  same ? "OK" : "FAIL (distinto del vector)");
+    std::cout << line << std::endl;
+    return same ? 0 : -1;
+}
+
+
+// Historia de instrumentos: ventana corta y larga sobre el mismo vuelo a 1 kHz
+const double kHistoryRateHz = 1000.0;
+const double kHistorySeconds = 600.0;
+const std::size_t kHistoryCapacity = 65536; // entra la ventana de 60 s a 1 kHz
+const int kHistoryCheckEvery = 997;        // registros entre verificaciones contra fuerza bruta
+
+// Vuelo sintético: trepadas y descensos de períodos distintos (los extremos se mueven)
+void historyFlight(double t, flight::FlightData& data) {
+    const float s = static_cast<float>(t);
+    data.airspeed = flight::units::Knots(110.0f + 25.0f * std::sin(s * 0.05f) + 3.0f * std::sin(s * 1.3f));
+    data.altitude = flight::units::Feet(5000.0f + 1500.0f * std::sin(s * 0.011f) + 40.0f * std::sin(s * 0.7f));
+    data.verticalSpeed = flight::units::FeetPerMinute(60.0f * (1500.0f * 0.011f * std::cos(s * 0.011f) +
+                                                              40.0f * 0.7f * std::cos(s * 0.7f)));
+}
+
+/**
+ * InstrumentHistory con ventanas de 1 s y 60 s: ns por record() (debe ser el
+ * mismo: O(1) sin importar la ventana) y, cada kHistoryCheckEvery registros,
+ * rate/min/max contra un recorrido completo de la ventana. Un hilo lector
+ * llama a latest() sin parar y verifica que cada muestra sea coherente (el
+ * valor es el del vuelo en ese tiempo y min <= valor <= max): una muestra
+ * rota por el seqlock se notaría. Falla si algo no coincide.
+ */
+int runHistory(const BenchOptions&) {
+    const std::size_t total = static_cast<std::size_t>(kHistorySeconds * kHistoryRateHz);
+    const int channels = flight::TrendSample::kChannels;
+
+    // Valores de referencia en float, como los guarda la historia
+    std::vector<double> times(total);
+    std::vector<float> values(total * channels);
+    flight::FlightData data;
+    for (std::size_t i = 0; i < total; ++i) {
+        times[i] = static_cast<double>(i) / kHistoryRateHz;
+        historyFlight(times[i], data);
+        values[i * channels + static_cast<int>(flight::TrendChannel::Airspeed)] = data.airspeed.value();
+        values[i * channels + static_cast<int>(flight::TrendChannel::Altitude)] = data.altitude.value();
+        values[i * channels + static_cast<int>(flight::TrendChannel::VerticalSpeed)] = data.verticalSpeed.value();
+    }
+
+    // FlightData de la muestra i, sin volver a evaluar el vuelo
+    auto sampleData = [&](std::size_t i, flight::FlightData& out) {
+        out.airspeed = flight::units::Knots(values[i * channels + static_cast<int>(flight::TrendChannel::Airspeed)]);
+        out.altitude = flight::units::Feet(values[i * channels + static_cast<int>(flight::TrendChannel::Altitude)]);
+        out.verticalSpeed = flight::units::FeetPerMinute(
+            values[i * channels + static_cast<int>(flight::TrendChannel::VerticalSpeed)]);
+    };
+
+    bool ok = true;
+    for (float windowSec : {1.0f, 60.0f}) {
+        // --- Tiempo de record() solo (sin lector que compita por el núcleo) ---
+        double recordSec = 0.0;
+        {
+            flight::InstrumentHistory history(windowSec, kHistoryCapacity);
+            const Clock::time_point t0 = Clock::now();
+            for (std::size_t i = 0; i < total; ++i) {
+                sampleData(i, data);
+                history.record(data, times[i]);
+            }
+            recordSec = std::chrono::duration<double>(Clock::now() - t0).count();
+        }
+
+        // --- Verificación con un lector concurrente ---
+        flight::InstrumentHistory history(windowSec, kHistoryCapacity);
+        std::atomic<bool> done{false};
+        std::uint64_t reads = 0, torn = 0;
+        std::thread reader([&] {
+            flight::TrendSample sample;
+            flight::FlightData expected;
+            while (!done.load(std::memory_order_acquire)) {
+                if (!history.latest(sample))
+                    continue;
+                ++reads;
+                historyFlight(sample.time, expected);
+                bool good = sample.valueOf(flight::TrendChannel::Airspeed) == expected.airspeed.value() &&
+                            sample.valueOf(flight::TrendChannel::Altitude) == expected.altitude.value();
+                for (int c = 0; c < channels; ++c)
+                    good = good && sample.min[c] <= sample.value[c] && sample.value[c] <= sample.max[c];
+                torn += !good;
+            }
+        });
+
+        std::size_t checks = 0, mismatches = 0;
+        for (std::size_t begin = 0; begin < total; begin += kHistoryCheckEvery) {
+            const std::size_t end = std::min(total, begin + kHistoryCheckEvery);
+            for (std::size_t i = begin; i < end; ++i) {
+                sampleData(i, data);
+                history.record(data, times[i]);
+            }
+
+            // Fuerza bruta sobre la última muestra: misma ventana (tiempo y capacidad)
+            const std::size_t last = end - 1;
+            std::size_t first = last;
+            while (first > 0 && last - (first - 1) < kHistoryCapacity &&
+                   times[last] - times[first - 1] <= windowSec)
+                --first;
+            flight::TrendSample got;
+            if (!history.latest(got) || got.time != times[last]) {
+                ++mismatches;
+                continue;
+            }
+            const float span = static_cast<float>(times[last] - times[first]);
+            for (int c = 0; c < channels; ++c) {
+                float lo = values[first * channels + c], hi = lo;
+                for (std::size_t i = first; i <= last; ++i) {
+                    lo = std::min(lo, values[i * channels + c]);
+                    hi = std::max(hi, values[i * channels + c]);
+                }
+                const float rate = span > 0.0f ? (values[last * channels + c] - values[first * channels + c]) / span : 0.0f;
+                if (got.min[c] != lo || got.max[c] != hi || got.rate[c] != rate)
+                    ++mismatches;
+            }
+            ++checks;
+        }
+        done.store(true, std::memory_order_release);
+        reader.join();
+
+        const bool good = mismatches == 0 && torn == 0;
+        ok = ok && good;
+        char line[200];
+        std::snprintf(line, sizeof(line),
+                      "Historia ventana %4.0f s: %.1f ns/record | %zu verificaciones, %llu lecturas concurrentes, %llu rotas %s",
+                      windowSec, recordSec / total * 1e9, checks, static_cast<unsigned long long>(reads),
+                      static_cast<unsigned long long>(torn), good ? "OK" : "FAIL");
+        std::cout << line << std::endl;
+    }
+    return ok ? 0 : -1;
+}
+
+// ============================== GL de conteo (glstate) ==============================
+
+// Funciones de glad que tocan init y un frame completo. Las primeras son las que filtra GLState
+#define BENCH_GL_STATE_CALLS(X) \
+    X(glEnable) X(glDisable) X(glDepthFunc) X(glDepthMask) X(glColorMask) X(glBlendFunc) \
+    X(glBlendFuncSeparate) X(glUseProgram) X(glBindVertexArray) X(glActiveTexture) X(glBindTexture)
+#define BENCH_GL_OTHER_CALLS(X) \
+    X(glAttachShader) X(glBeginQuery) X(glBindBuffer) X(glBindFramebuffer) X(glBindRenderbuffer) \
+    X(glBufferData) X(glBufferSubData) X(glClear) X(glClearColor) X(glClearStencil) X(glCompileShader) \
+    X(glDeleteBuffers) X(glDeleteFramebuffers) X(glDeleteProgram) X(glDeleteQueries) X(glDeleteRenderbuffers) \
+    X(glDeleteShader) X(glDeleteSync) X(glDeleteTextures) X(glDeleteVertexArrays) X(glDrawArrays) \
+    X(glDrawElements) X(glEnableVertexAttribArray) X(glEndQuery) X(glFenceSync) X(glFlush) \
+    X(glFramebufferRenderbuffer) X(glFramebufferTexture2D) X(glGenerateMipmap) X(glGetError) \
+    X(glGetProgramInfoLog) X(glGetShaderInfoLog) X(glGetUniformLocation) X(glLinkProgram) X(glPixelStorei) \
+    X(glReadPixels) X(glRenderbufferStorage) X(glShaderSource) X(glStencilFunc) X(glStencilMask) \
+    X(glStencilOp) X(glTexImage2D) X(glTexParameterf) X(glTexParameteri) X(glUniform1f) X(glUniform1i) \
+    X(glUniform1ui) X(glUniform3fv) X(glUniform4fv) X(glUniformMatrix4fv) X(glVertexAttribIPointer) \
+    X(glVertexAttribPointer) X(glViewport) X(glWaitSync)
+#define BENCH_GL_GEN_CALLS(X) \
+    X(glGenBuffers) X(glGenFramebuffers) X(glGenQueries) X(glGenRenderbuffers) X(glGenTextures) X(glGenVertexArrays)
+#define BENCH_GL_SPECIAL_CALLS(X) \
+    X(glCreateShader) X(glCreateProgram) X(glGetShaderiv) X(glGetProgramiv) X(glGetIntegerv) \
+    X(glGetQueryObjectuiv) X(glCheckFramebufferStatus)
+#define BENCH_GL_ALL_CALLS(X) \
+    BENCH_GL_STATE_CALLS(X) BENCH_GL_OTHER_CALLS(X) BENCH_GL_GEN_CALLS(X) BENCH_GL_SPECIAL_CALLS(X)
+
+#define BENCH_GL_ENUM(fn) kGL_##fn,
+enum BenchGLCall : int { BENCH_GL_ALL_CALLS(BENCH_GL_ENUM) kGLCallCount };
+#undef BENCH_GL_ENUM
+const int kGLStateCallCount = kGL_glBindTexture + 1;
+
+#define BENCH_GL_NAME(fn) #fn,
+const char* const kGLCallNames[kGLCallCount] = {BENCH_GL_ALL_CALLS(BENCH_GL_NAME)};
+#undef BENCH_GL_NAME
+
+const int kGLStateWidth = 1280, kGLStateHeight = 720; // lo que devuelve GL_VIEWPORT
+
+std::uint64_t gGLCalls[kGLCallCount];
+GLuint gGLNextName = 0; // nombres únicos para que GLState vea objetos distintos
+
+// Stub genérico: cuenta y devuelve 0 / nullptr / nada
+template <int Index, typename Fn>
+struct CountingStub;
+template <int Index, typename R, typename... A>
+struct CountingStub<Index, R(GLAPIENTRY*)(A...)> {
+    static R GLAPIENTRY call(A...) {
+        ++gGLCalls[Index];
+        return R();
+    }
+};
+
+template <int Index>
+void GLAPIENTRY genNamesStub(GLsizei n, GLuint* names) {
+    ++gGLCalls[Index];
+    for (GLsizei i = 0; i < n; ++i) names[i] = ++gGLNextName;
+}
+
+GLuint GLAPIENTRY createShaderStub(GLenum) {
+    ++gGLCalls[kGL_glCreateShader];
+    return ++gGLNextName;
+}
+
+GLuint GLAPIENTRY createProgramStub() {
+    ++gGLCalls[kGL_glCreateProgram];
+    return ++gGLNextName;
+}
+
+// Compilación y link siempre exitosos
+void GLAPIENTRY getShaderivStub(GLuint, GLenum, GLint* value) {
+    ++gGLCalls[kGL_glGetShaderiv];
+    *value = GL_TRUE;
+}
+
+void GLAPIENTRY getProgramivStub(GLuint, GLenum, GLint* value) {
+    ++gGLCalls[kGL_glGetProgramiv];
+    *value = GL_TRUE;
+}
+
+void GLAPIENTRY getIntegervStub(GLenum name, GLint* value) {
+    ++gGLCalls[kGL_glGetIntegerv];
+    if (name == GL_VIEWPORT) {
+        value[0] = value[1] = 0;
+        value[2] = kGLStateWidth;
+        value[3] = kGLStateHeight;
+    } else {
+        *value = 0;
+    }
+}
+
+// Queries de oclusión nunca disponibles (el skybox conserva el último valor)
+void GLAPIENTRY getQueryObjectuivStub(GLuint, GLenum, GLuint* value) {
+    ++gGLCalls[kGL_glGetQueryObjectuiv];
+    *value = 0;
+}
+
+GLenum GLAPIENTRY checkFramebufferStatusStub(GLenum) {
+    ++gGLCalls[kGL_glCheckFramebufferStatus];
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+/**
+ * Reemplaza los punteros de glad por stubs que cuentan llamadas (sin driver
+ * ni contexto) y los restaura al salir del scope.
+ */
+class CountingGL {
+public:
+    CountingGL() {
+#define BENCH_GL_SAVE(fn) saved_##fn = glad_##fn;
+        BENCH_GL_ALL_CALLS(BENCH_GL_SAVE)
+#undef BENCH_GL_SAVE
+#define BENCH_GL_COUNT(fn) glad_##fn = &CountingStub<kGL_##fn, decltype(glad_##fn)>::call;
+        BENCH_GL_STATE_CALLS(BENCH_GL_COUNT)
+        BENCH_GL_OTHER_CALLS(BENCH_GL_COUNT)
+#undef BENCH_GL_COUNT
+#define BENCH_GL_GEN(fn) glad_##fn = &genNamesStub<kGL_##fn>;
+        BENCH_GL_GEN_CALLS(BENCH_GL_GEN)
+#undef BENCH_GL_GEN
+        glad_glCreateShader = &createShaderStub;
+        glad_glCreateProgram = &createProgramStub;
+        glad_glGetShaderiv = &getShaderivStub;
+        glad_glGetProgramiv = &getProgramivStub;
+        glad_glGetIntegerv = &getIntegervStub;
+        glad_glGetQueryObjectuiv = &getQueryObjectuivStub;
+        glad_glCheckFramebufferStatus = &checkFramebufferStatusStub;
+        reset();
+    }
+
+    ~CountingGL() {
+#define BENCH_GL_RESTORE(fn) glad_##fn = saved_##fn;
+        BENCH_GL_ALL_CALLS(BENCH_GL_RESTORE)
+#undef BENCH_GL_RESTORE
+    }
+
+    CountingGL(const CountingGL&) = delete;
+    CountingGL& operator=(const CountingGL&) = delete;
+
+    void reset() { std::fill(std::begin(gGLCalls), std::end(gGLCalls), 0); }
+
+private:
+#define BENCH_GL_SAVED(fn) decltype(glad_##fn) saved_##fn;
+    BENCH_GL_ALL_CALLS(BENCH_GL_SAVED)
+#undef BENCH_GL_SAVED
+};
+
+struct GLFrameCalls {
+    std::uint64_t perCall[kGLCallCount];
+    std::uint64_t state = 0;     // llamadas de estado que llegaron al "driver"
+    std::uint64_t other = 0;     // draws, uniforms, buffers, queries...
+    gfx::GLState::Stats stats;   // lo que cree GLState
+};
+
+/**
+ * Un frame como renderScene de main.cpp (terreno con pre-pass, cubo, skybox
+ * por la RenderQueue y el HUD encima) con los renderers reales sobre un GL
+ * de conteo. Se mide un frame ya en régimen, sin cache (toda llamada pasa) y
+ * con cache. Falla si lo contado no coincide con GLState::stats() o si el
+ * cache cambia alguna llamada que no es de estado.
+ */
+int runGLState(const BenchOptions&) {
+    CountingGL counting;
+    gfx::GLState gl;
+    gfx::GLState::makeCurrent(&gl);
+
+    GLFrameCalls off{}, on{};
+    try {
+        gfx::TextureCube cubemap;
+        gfx::SkyboxRenderer skybox;
+        gfx::SimpleCube cube;
+        gfx::TerrainRenderer terrain;
+        hud::FlightHUD flightHUD;
+        gfx::RenderQueue queue;
+        queue.setDepthPrepass(true);
+
+        // Sin texturas de disco: caras de 1×1 y un relieve chico. Las texturas del
+        // terreno quedan en 0, el mismo patrón de binds por unidad que con archivos
+        util::CubeFaces faces;
+        for (util::ImageRGBA& face : faces.face) face = {{255, 255, 255, 255}, 1, 1};
+        faces.size = 1;
+        cubemap.loadCubeFaces(faces);
+        skybox.init();
+        skybox.setCubemap(&cubemap);
+        skybox.setOcclusionQueryEnabled(true);
+        cube.init();
+        terrain.init();
+        terrain.setHeightmap(std::vector<float>(16 * 16, 0.0f), 16, 8.0f);
+        flightHUD.init(kGLStateWidth, kGLStateHeight);
+        flightHUD.setLayout("classic");
+
+        using namespace flight::units::literals;
+        flight::FlightData data;
+        data.pitch = 4_deg;
+        data.roll = -12_deg;
+        data.heading = 75_deg;
+        data.airspeed = 140_kt;
+        data.altitude = 2300_ft;
+
+        const glm::vec3 cameraPos(0.0f, 60.0f, 20.0f), cubePos(0.0f, 0.0f, 5.0f);
+        const glm::mat4 view = glm::lookAt(cameraPos, cameraPos + glm::vec3(0.0f, -0.2f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4 projection = glm::perspective(glm::radians(45.0f), static_cast<float>(kGLStateWidth) / kGLStateHeight, 0.1f, 1000.0f);
+        const gfx::TerrainParams params;
+        gl.enable(GL_DEPTH_TEST);
+
+        auto frame = [&]() {
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            queue.begin();
+            gfx::DrawItem ground;
+            ground.shader = terrain.programId();
+            ground.texture = terrain.albedoTexture();
+            ground.draw = [&]() { terrain.draw(view, projection, cameraPos, params); };
+            ground.depthShader = terrain.depthProgramId();
+            ground.drawDepth = [&]() { terrain.drawDepthOnly(view, projection, cameraPos, params); };
+            queue.submit(std::move(ground));
+            gfx::DrawItem box;
+            box.shader = cube.programId();
+            box.depth = glm::length(cubePos - cameraPos);
+            box.draw = [&]() { cube.draw(view, projection, cubePos); };
+            queue.submit(std::move(box));
+            gfx::DrawItem sky;
+            sky.pass = gfx::RenderPass::Sky;
+            sky.shader = skybox.programId();
+            sky.draw = [&]() { skybox.draw(view, projection); };
+            queue.submit(std::move(sky));
+            queue.flush();
+            flightHUD.update(data);
+            flightHUD.render(kFrameDt);
+        };
+
+        auto measure = [&](bool filtering, GLFrameCalls& out) {
+            gl.setFiltering(filtering);
+            frame(); // el primer frame en cada modo llena el cache
+            counting.reset();
+            gl.resetStats();
+            frame();
+            std::copy(std::begin(gGLCalls), std::end(gGLCalls), out.perCall);
+            for (int i = 0; i < kGLCallCount; ++i)
+                (i < kGLStateCallCount ? out.state : out.other) += gGLCalls[i];
+            out.stats = gl.stats();
+        };
+        measure(false, off);
+        measure(true, on);
+    } catch (const std::exception& e) {
+        gfx::GLState::makeCurrent(nullptr);
+        std::cerr << "GLState bench: " << e.what() << std::endl;
+        return -1;
+    }
+    gfx::GLState::makeCurrent(nullptr);
+
+    std::cout << "GLState: un frame (terreno con pre-pass, cubo, skybox, HUD) sobre GL de conteo" << std::endl;
+    char line[160];
+    std::snprintf(line, sizeof(line), "  llamadas de estado al driver: sin cache %llu | con cache %llu (%llu filtradas, -%.0f%%)",
+                  static_cast<unsigned long long>(off.state), static_cast<unsigned long long>(on.state),
+                  static_cast<unsigned long long>(on.stats.filtered),
+                  off.state ? 100.0 * (off.state - on.state) / off.state : 0.0);
+    std::cout << line << std::endl;
+    for (int i = 0; i < kGLStateCallCount; ++i) {
+        if (off.perCall[i] == 0) continue;
+        std::snprintf(line, sizeof(line), "    %-20s %4llu -> %4llu", kGLCallNames[i],
+                      static_cast<unsigned long long>(off.perCall[i]), static_cast<unsigned long long>(on.perCall[i]));
+        std::cout << line << std::endl;
+    }
+    std::cout << "  resto de GL (draws, uniforms, buffers): " << off.other << " sin cache, " << on.other
+              << " con cache" << std::endl;
+
+    // GLState tiene que contar exactamente lo que llegó, y el cache sólo quita estado
+    bool sameOther = true;
+    for (int i = kGLStateCallCount; i < kGLCallCount; ++i)
+        sameOther = sameOther && off.perCall[i] == on.perCall[i];
+    const bool ok = off.state == off.stats.issued && off.stats.filtered == 0 && on.state == on.stats.issued &&
+                    on.state <= off.state && sameOther;
+    std::cout << "GLState::stats() contra lo contado: sin cache " << off.stats.issued << "/" << off.state
+              << ", con cache " << on.stats.issued << "/" << on.state << (sameOther ? "" : ", resto distinto")
+              << " " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : -1;
+}
+
+} // namespace
+
+int runBenchmark(const std::string& name, const BenchOptions& options) {
+    if (name == "traffic")
+        return runTraffic(options);
+    if (name == "attitude")
+        return runAttitude(options);
+    if (name == "telemetry")
+        return runTelemetry(options);
+    if (name == "airdata")
+        return runAirData(options);
+    if (name == "terrain")
+        return runTerrain(options);
+    if (name == "hud2d")
+        return runHud2D(options);
+    if (name == "instruments")
+        return runInstruments(options);
+    if (name == "history")
+        return runHistory(options);
+    if (name == "glstate")
+        return runGLState(options);
+
+    std::cerr << "Unknown benchmark: " << name
+              << " (available: traffic, attitude, telemetry, airdata, terrain, hud2d, instruments, history, glstate)"
+              << std::endl;
+    return -1;
+}
+
+} // namespace util
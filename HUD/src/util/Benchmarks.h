@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+
+namespace util {
+
+/**
+ * Benchmarks de CPU sin contexto OpenGL (main --bench NOMBRE).
+ *
+ *   traffic   lote SoA de aviones (AircraftStateBatch), escalando hilos 1,2,4..N
+ *   attitude  AttitudeBatch vs FlightData::updateAttitude: tolerancia y throughput
+ *             (termina con error si se excede la tolerancia)
+ *   telemetry una hora a 1 kHz al log mapeado (raw y xor): ns/push, bytes/muestra,
+ *             relectura bit a bit y seeks aleatorios (archivo temporal, se borra)
+ *   airdata   tablas ISA/viento de AirData vs pow/exp por avión: error máximo y
+ *             throughput del lote (termina con error si se excede la tolerancia)
+ *   terrain   Heightfield en un hilo: altura, normal y raycast por segundo; rayos
+ *             verificados contra una marcha de referencia (error si alguno falla)
+ *   hud2d     decenas de instrumentos en Renderer2D sin GL: comandos grabados vs
+ *             draw calls después de ordenar/fusionar (error si pasa de 3, +1 con íconos);
+ *             después serie contra arenas en WorkerPool (error si el resultado difiere)
+ *   instruments 1000 instrumentos en InstrumentRegistry contra unique_ptr con render()
+ *             virtual: us/frame y ns por sameDisplay (error si la geometría difiere)
+ *   history   InstrumentHistory a 1 kHz con ventanas de 1 s y 60 s: ns/record (igual
+ *             en las dos), rate/min/max contra fuerza bruta y un lector concurrente
+ *             (error si algo no coincide o se lee una muestra rota)
+ *   glstate   un frame completo (terreno, cubo, skybox, HUD) con los punteros de glad
+ *             cambiados por stubs que cuentan: llamadas de estado con y sin el cache
+ *             de GLState (error si GLState::stats() no coincide con lo contado)
+ */
+struct BenchOptions {
+    int aircraft = 10000;  // tamaño del lote (aviones en "traffic", tracks en "attitude")
+    unsigned threads = 0;  // máximo de hilos (0 = hardware_concurrency)
+    float seconds = 10.0f; // tiempo simulado por corrida
+};
+
+// Devuelve el código de salida del proceso (0 = ok, -1 = benchmark desconocido)
+int runBenchmark(const std::string& name, const BenchOptions& options);
+
+} // namespace util
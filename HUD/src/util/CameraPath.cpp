@@ -0,0 +1,95 @@
+#include "CameraPath.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace util {
+
+static glm::vec3 frontFromEuler(float yawDeg, float pitchDeg) {
+    const float yaw = glm::radians(yawDeg);
+    const float pitch = glm::radians(pitchDeg);
+    return glm::normalize(glm::vec3(std::cos(yaw) * std::cos(pitch),
+                                    std::sin(pitch),
+                                    std::sin(yaw) * std::cos(pitch)));
+}
+
+bool CameraPath::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open camera path: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<CameraKeyframe> keys;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(file, line)) {
+        ++lineNo;
+        const size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream in(line);
+        CameraKeyframe k;
+        if (!(in >> k.time)) continue; // línea vacía o comentario
+        if (!(in >> k.position.x >> k.position.y >> k.position.z >> k.yaw >> k.pitch)) {
+            std::cerr << path << ":" << lineNo << ": expected 't x y z yaw pitch'" << std::endl;
+            return false;
+        }
+        keys.push_back(k);
+    }
+
+    if (keys.empty()) {
+        std::cerr << "Camera path has no keyframes: " << path << std::endl;
+        return false;
+    }
+
+    std::stable_sort(keys.begin(), keys.end(),
+                     [](const CameraKeyframe& a, const CameraKeyframe& b) { return a.time < b.time; });
+    keys_ = std::move(keys);
+    return true;
+}
+
+void CameraPath::setDefault() {
+    keys_ = {
+        {0.0f, glm::vec3(0.0f, 1.8f, 0.0f), -90.0f, 0.0f},       // en el piso
+        {2.0f, glm::vec3(0.0f, 1.8f, -20.0f), -90.0f, 0.0f},     // carreteo
+        {6.0f, glm::vec3(0.0f, 30.0f, -120.0f), -90.0f, 10.0f},  // ascenso
+        {10.0f, glm::vec3(60.0f, 80.0f, -220.0f), -45.0f, 5.0f}, // viraje
+        {14.0f, glm::vec3(160.0f, 60.0f, -260.0f), 0.0f, -5.0f},
+        {18.0f, glm::vec3(260.0f, 10.0f, -260.0f), 0.0f, -2.0f}, // vuelo bajo
+    };
+}
+
+CameraPose CameraPath::sample(float time) const {
+    CameraPose pose{glm::vec3(0.0f, 1.8f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)};
+    if (keys_.empty()) return pose;
+
+    // Primer keyframe con tiempo > time
+    auto it = std::upper_bound(keys_.begin(), keys_.end(), time,
+                               [](float t, const CameraKeyframe& k) { return t < k.time; });
+
+    const CameraKeyframe* a;
+    const CameraKeyframe* b;
+    if (it == keys_.begin()) {
+        a = b = &keys_.front();
+    } else if (it == keys_.end()) {
+        a = b = &keys_.back();
+    } else {
+        b = &*it;
+        a = &*(it - 1);
+    }
+
+    const float span = b->time - a->time;
+    const float s = span > 0.0f ? glm::clamp((time - a->time) / span, 0.0f, 1.0f) : 0.0f;
+
+    // Yaw por el arco corto
+    const float dYaw = std::fmod(b->yaw - a->yaw + 540.0f, 360.0f) - 180.0f;
+
+    pose.position = glm::mix(a->position, b->position, s);
+    pose.front = frontFromEuler(a->yaw + dYaw * s, glm::mix(a->pitch, b->pitch, s));
+    return pose;
+}
+
+} // namespace util
@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace util {
+
+/**
+ * Recorrido de cámara guionado para ejecuciones sin usuario (headless/benchmarks).
+ *
+ * Keyframes con tiempo, posición y ángulos de Euler en grados (misma convención
+ * que main.cpp: yaw = -90 mira hacia -Z). Entre keyframes se interpola linealmente
+ * (yaw por el arco más corto).
+ *
+ * Formato de archivo de texto, una línea por keyframe:
+ *   # t[s]  x  y  z  yaw  pitch
+ *   0.0     0  1.8  0  -90  0
+ */
+struct CameraKeyframe {
+    float time;
+    glm::vec3 position;
+    float yaw;
+    float pitch;
+};
+
+struct CameraPose {
+    glm::vec3 position;
+    glm::vec3 front;
+    glm::vec3 up;
+};
+
+class CameraPath {
+public:
+    bool loadFromFile(const std::string& path);
+    void setDefault(); // vuelo bajo: carreteo, ascenso, viraje y descenso
+
+    CameraPose sample(float time) const; // fuera de rango: se mantiene el extremo
+    float duration() const { return keys_.empty() ? 0.0f : keys_.back().time; }
+    bool empty() const { return keys_.empty(); }
+
+private:
+    std::vector<CameraKeyframe> keys_;
+};
+
+} // namespace util
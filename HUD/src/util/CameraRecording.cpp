@@ -0,0 +1,124 @@
+#include "CameraRecording.h"
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+namespace util {
+
+namespace {
+
+const char kMagic[4] = {'H', 'R', 'E', 'C'};
+const std::uint32_t kVersion = 1;
+const std::size_t kFloatsPerFrame = 9;
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t frames;
+    float fixedDt;
+};
+static_assert(sizeof(Header) == 16, "cabecera de grabación sin padding");
+
+} // namespace
+
+// ============================== Grabación ==============================
+
+bool CameraRecorder::open(const std::string& path, float fixedDt) {
+    close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "Failed to open camera recording for writing: " << path << std::endl;
+        return false;
+    }
+
+    // Cabecera provisional: el total se completa en close()
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.frames = 0;
+    header.fixedDt = fixedDt;
+    frames_ = 0;
+    failed_ = std::fwrite(&header, sizeof(header), 1, file_) != 1;
+    return !failed_;
+}
+
+void CameraRecorder::record(const glm::vec3& position, const glm::vec3& front, const glm::vec3& up) {
+    if (!file_ || failed_) return;
+
+    const float data[kFloatsPerFrame] = {
+        position.x, position.y, position.z,
+        front.x, front.y, front.z,
+        up.x, up.y, up.z,
+    };
+    if (std::fwrite(data, sizeof(data), 1, file_) != 1) {
+        std::cerr << "Camera recording write failed after " << frames_ << " frames" << std::endl;
+        failed_ = true;
+        return;
+    }
+    ++frames_;
+}
+
+bool CameraRecorder::close() {
+    if (!file_) return !failed_;
+
+    // Completar el total de frames en la cabecera
+    bool ok = !failed_ &&
+              std::fseek(file_, offsetof(Header, frames), SEEK_SET) == 0 &&
+              std::fwrite(&frames_, sizeof(frames_), 1, file_) == 1;
+    ok = (std::fclose(file_) == 0) && ok;
+    file_ = nullptr;
+
+    if (!ok) std::cerr << "Failed to finalize camera recording" << std::endl;
+    return ok;
+}
+
+// ============================== Reproducción ==============================
+
+bool CameraRecording::load(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Failed to open camera recording: " << path << std::endl;
+        return false;
+    }
+
+    Header header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion) {
+        std::cerr << "Not a camera recording (or unsupported version): " << path << std::endl;
+        std::fclose(file);
+        return false;
+    }
+    if (!(header.fixedDt > 0.0f) || header.frames == 0) {
+        std::cerr << "Camera recording is empty or has invalid timestep: " << path << std::endl;
+        std::fclose(file);
+        return false;
+    }
+
+    std::vector<float> data(static_cast<std::size_t>(header.frames) * kFloatsPerFrame);
+    const std::size_t read = std::fread(data.data(), sizeof(float) * kFloatsPerFrame, header.frames, file);
+    std::fclose(file);
+    if (read != header.frames) {
+        std::cerr << "Camera recording truncated: " << read << " of " << header.frames
+                  << " frames in " << path << std::endl;
+        return false;
+    }
+
+    frames_.resize(header.frames);
+    for (std::size_t i = 0; i < frames_.size(); ++i) {
+        const float* f = &data[i * kFloatsPerFrame];
+        frames_[i].position = glm::vec3(f[0], f[1], f[2]);
+        frames_[i].front = glm::vec3(f[3], f[4], f[5]);
+        frames_[i].up = glm::vec3(f[6], f[7], f[8]);
+    }
+    fixedDt_ = header.fixedDt;
+    return true;
+}
+
+CameraPose CameraRecording::frame(std::size_t index) const {
+    if (frames_.empty())
+        return CameraPose{glm::vec3(0.0f, 1.8f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)};
+    return frames_[index < frames_.size() ? index : frames_.size() - 1];
+}
+
+} // namespace util
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "CameraPath.h"
+
+namespace util {
+
+/**
+ * Grabación binaria de la pose de cámara, un registro por frame.
+ *
+ * Se guarda la pose ya resuelta (posición + front + up) y no el input crudo:
+ * así la reproducción no depende de la sensibilidad del mouse, del framerate
+ * de la sesión grabada ni de cómo se recalcula el vector front.
+ *
+ * Formato (little-endian, floats IEEE-754):
+ *   cabecera  "HREC" | uint32 versión | uint32 frames | float dt fijo
+ *   frame     float[9] = position.xyz, front.xyz, up.xyz   (36 bytes)
+ *
+ * Al reproducir se avanza con el dt fijo de la cabecera, de modo que dos
+ * ejecuciones (o dos builds) ven exactamente la misma secuencia de frames.
+ */
+class CameraRecorder {
+public:
+    CameraRecorder() = default;
+    ~CameraRecorder() { close(); }
+
+    CameraRecorder(const CameraRecorder&) = delete;
+    CameraRecorder& operator=(const CameraRecorder&) = delete;
+
+    bool open(const std::string& path, float fixedDt);
+    void record(const glm::vec3& position, const glm::vec3& front, const glm::vec3& up);
+    bool close(); // escribe el total de frames en la cabecera
+
+    bool isOpen() const { return file_ != nullptr; }
+    std::uint32_t frames() const { return frames_; }
+
+private:
+    std::FILE* file_ = nullptr;
+    std::uint32_t frames_ = 0;
+    bool failed_ = false;
+};
+
+class CameraRecording {
+public:
+    bool load(const std::string& path);
+
+    std::size_t frameCount() const { return frames_.size(); }
+    float fixedDt() const { return fixedDt_; }
+    CameraPose frame(std::size_t index) const; // fuera de rango: último frame
+
+private:
+    std::vector<CameraPose> frames_;
+    float fixedDt_ = 1.0f / 60.0f;
+};
+
+/**
+ * Hash FNV-1a de 64 bits para comparar salidas entre ejecuciones.
+ * Dos reproducciones del mismo archivo deben dar el mismo valor.
+ */
+class Digest {
+public:
+    void add(const void* data, std::size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash_ ^= p[i];
+            hash_ *= 0x100000001b3ULL;
+        }
+    }
+    void add(float v) { add(&v, sizeof(v)); }
+    std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+} // namespace util
@@ -0,0 +1,88 @@
+#include "FileWatcher.h"
+#include <iostream>
+#include <system_error>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace util {
+
+namespace fs = std::filesystem;
+
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+bool FileWatcher::watch(const std::string& path) {
+    stop();
+    const fs::path file(path);
+    path_ = path;
+    name_ = file.filename().string();
+
+#ifdef __linux__
+    const fs::path dir = file.has_parent_path() ? file.parent_path() : fs::path(".");
+    fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd_ >= 0)
+        wd_ = inotify_add_watch(fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (fd_ >= 0 && wd_ >= 0)
+        return true;
+
+    std::cerr << "inotify unavailable for " << path << " (" << std::strerror(errno)
+              << "), polling modification time" << std::endl;
+    if (fd_ >= 0)
+        close(fd_);
+    fd_ = wd_ = -1;
+#endif
+
+    std::error_code ec;
+    lastWrite_ = fs::last_write_time(file, ec);
+    return true;
+}
+
+void FileWatcher::stop() {
+#ifdef __linux__
+    if (fd_ >= 0)
+        close(fd_); // libera también el watch
+#endif
+    fd_ = wd_ = -1;
+    path_.clear();
+    name_.clear();
+}
+
+bool FileWatcher::changed() {
+    if (path_.empty())
+        return false;
+
+#ifdef __linux__
+    if (fd_ >= 0) {
+        // Vaciar la cola entera: un guardado puede generar varios eventos
+        alignas(inotify_event) char buffer[4096];
+        bool hit = false;
+        for (;;) {
+            const ssize_t n = read(fd_, buffer, sizeof(buffer));
+            if (n <= 0)
+                break; // EAGAIN: no hay más
+            for (ssize_t offset = 0; offset < n;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if (event->len > 0 && name_ == event->name)
+                    hit = true;
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+        return hit;
+    }
+#endif
+
+    std::error_code ec;
+    const fs::file_time_type write = fs::last_write_time(path_, ec);
+    if (ec || write == lastWrite_)
+        return false;
+    lastWrite_ = write;
+    return true;
+}
+
+} // namespace util
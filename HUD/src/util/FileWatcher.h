@@ -0,0 +1,39 @@
+#pragma once
+#include <filesystem>
+#include <string>
+
+namespace util {
+
+/**
+ * Aviso de cambios en un archivo, para recargar configuración en caliente.
+ *
+ * En Linux usa inotify sobre el directorio (no sobre el archivo): los editores
+ * que guardan escribiendo un temporal y renombrándolo reemplazan el inodo, y un
+ * watch sobre el archivo quedaría huérfano. El fd es no bloqueante, así que
+ * changed() se puede llamar cada frame: sin eventos es una lectura que falla.
+ * En otros sistemas compara la fecha de modificación (stat por llamada).
+ */
+class FileWatcher {
+public:
+    FileWatcher() = default;
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool watch(const std::string& path);
+    void stop();
+    bool watching() const { return !path_.empty(); }
+
+    // true si el archivo se escribió o reemplazó desde la llamada anterior
+    bool changed();
+
+private:
+    std::string path_;
+    std::string name_; // nombre dentro del directorio vigilado
+    int fd_ = -1;
+    int wd_ = -1;
+    std::filesystem::file_time_type lastWrite_{};
+};
+
+} // namespace util
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace util {
+
+/**
+ * Historia circular lock-free: un productor, cualquier cantidad de lectores.
+ *
+ * Capacidad potencia de 2 fija desde el constructor. push() nunca reserva ni
+ * espera: pisa la muestra más vieja. Cada slot es un seqlock (número de
+ * secuencia + contenido en palabras atómicas relajadas): un lector copia la
+ * muestra y la descarta si el productor la pisó mientras tanto, en lugar de
+ * bloquearlo. Sin carreras de datos (limpio con TSan) para T trivialmente copiable.
+ *
+ * Las muestras se numeran desde 0 en orden de push(); la n sigue disponible
+ * mientras n + capacity() > count().
+ */
+template <typename T>
+class HistoryRing {
+    static_assert(std::is_trivially_copyable<T>::value, "HistoryRing needs a trivially copyable T");
+
+public:
+    explicit HistoryRing(std::size_t capacity) {
+        std::size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        slots_ = std::make_unique<Slot[]>(cap);
+        mask_ = cap - 1;
+    }
+
+    HistoryRing(const HistoryRing&) = delete;
+    HistoryRing& operator=(const HistoryRing&) = delete;
+
+    // --- Productor ---
+    void push(const T& value) {
+        const std::uint64_t n = count_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[n & mask_];
+        std::uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        slot.seq.store(2 * n + 1, std::memory_order_relaxed); // impar: escribiendo
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i)
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        slot.seq.store(2 * n + 2, std::memory_order_release); // muestra n completa
+        count_.store(n + 1, std::memory_order_release);
+    }
+
+    // --- Lectores (cualquier hilo) ---
+    std::uint64_t count() const { return count_.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return mask_ + 1; }
+
+    // false si n todavía no existe o ya fue pisada
+    bool read(std::uint64_t n, T& out) const {
+        const Slot& slot = slots_[n & mask_];
+        const std::uint64_t expected = 2 * n + 2;
+        if (slot.seq.load(std::memory_order_acquire) != expected)
+            return false;
+        std::uint64_t words[kWords];
+        for (std::size_t i = 0; i < kWords; ++i)
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != expected)
+            return false;
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    // La muestra más reciente (reintenta si la pisan durante la copia)
+    bool latest(T& out) const {
+        for (;;) {
+            const std::uint64_t n = count();
+            if (n == 0)
+                return false;
+            if (read(n - 1, out))
+                return true;
+        }
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + 7) / 8;
+
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};
+        std::atomic<std::uint64_t> words[kWords];
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::uint64_t> count_{0};
+};
+
+} // namespace util
@@ -0,0 +1,24 @@
+#include "ImageWriter.h"
+#include <fstream>
+#include <iostream>
+
+namespace util {
+
+bool writePPM(const std::string& path, int width, int height, const std::vector<unsigned char>& rgb) {
+    if (rgb.size() < static_cast<size_t>(width) * height * 3) {
+        std::cerr << "writePPM: buffer too small for " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "writePPM: cannot open " << path << std::endl;
+        return false;
+    }
+
+    out << "P6\n" << width << " " << height << "\n255\n";
+    out.write(reinterpret_cast<const char*>(rgb.data()), static_cast<std::streamsize>(width) * height * 3);
+    return static_cast<bool>(out);
+}
+
+} // namespace util
@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace util {
+
+// Guarda una imagen RGB8 (filas de arriba hacia abajo) como PPM binario (P6)
+bool writePPM(const std::string& path, int width, int height, const std::vector<unsigned char>& rgb);
+
+} // namespace util
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace util {
+
+/**
+ * Cola circular lock-free de un productor y un consumidor.
+ *
+ * Capacidad potencia de 2 fija desde el constructor: push/pop nunca reservan
+ * memoria ni bloquean. push devuelve false si está llena (el llamador decide
+ * si descarta), pop devuelve false si está vacía.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity) {
+        std::size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        slots_.resize(cap);
+        mask_ = cap - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // --- Productor ---
+    bool push(const T& value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) > mask_) return false; // llena
+        slots_[head & mask_] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // --- Consumidor ---
+    bool pop(T& out) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return false; // vacía
+        out = slots_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::vector<T> slots_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::size_t> head_{0}; // escribe el productor
+    alignas(64) std::atomic<std::size_t> tail_{0}; // escribe el consumidor
+};
+
+} // namespace util
@@ -0,0 +1,441 @@
+#include "TelemetryLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace util {
+
+namespace {
+
+const char kMagic[4] = {'H', 'T', 'L', 'M'};
+const std::uint16_t kVersion = 1;
+const std::size_t kPageBytes = 4096;
+const std::size_t kFirstChunkOffset = kPageBytes; // la cabecera ocupa la página 0
+const std::uint32_t kChunkMagic = 0x4B4E4843;     // "CHNK"
+const int kChannels = TelemetrySample::kChannels;
+const int kTagBytes = (kChannels + 1) / 2;        // un nibble por canal
+const std::size_t kMaxRecordBytes = 10 + kTagBytes + 4 * kChannels;
+
+struct FileHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint8_t codec;
+    std::uint8_t channels;
+    std::uint32_t chunkBytes;
+    std::uint32_t reserved;
+};
+
+struct ChunkHeader {
+    std::uint32_t magic;
+    std::uint32_t count; // muestras en el chunk
+    std::uint32_t bytes; // payload usado (después de esta cabecera)
+    std::uint32_t reserved;
+    double firstTime;
+    double lastTime;
+};
+static_assert(sizeof(FileHeader) == 16, "cabecera de telemetría sin padding");
+static_assert(sizeof(ChunkHeader) == 32, "cabecera de chunk sin padding");
+
+inline std::uint32_t floatBits(float v) {
+    std::uint32_t b;
+    std::memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+inline float bitsFloat(std::uint32_t b) {
+    float v;
+    std::memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+inline unsigned char* putVarint(unsigned char* p, std::uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = static_cast<unsigned char>(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = static_cast<unsigned char>(v);
+    return p;
+}
+
+inline const unsigned char* getVarint(const unsigned char* p, const unsigned char* end, std::uint64_t& v) {
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        const unsigned char byte = *p++;
+        v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return p;
+    }
+    return nullptr; // truncado
+}
+
+inline std::uint64_t zigzag(std::int64_t v) { return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63); }
+inline std::int64_t unzigzag(std::uint64_t v) { return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1); }
+
+// Bytes significativos (little-endian) de un XOR: 0..4
+inline int significantBytes(std::uint32_t x) {
+    return x == 0 ? 0 : 4 - (__builtin_clz(x) >> 3);
+}
+
+} // namespace
+
+// ============================== Muestra ==============================
+
+TelemetrySample TelemetrySample::fromFlightData(const flight::FlightData& d, double time) {
+    TelemetrySample s;
+    s.time = time;
+    const float v[kChannels] = {d.pitch.value(), d.roll.value(), d.heading.value(),
+                                d.airspeed.value(), d.verticalSpeed.value(), d.altitude.value(),
+                                d.position.x, d.position.y, d.position.z,
+                                d.velocity.x, d.velocity.y, d.velocity.z};
+    std::memcpy(s.values, v, sizeof(v));
+    return s;
+}
+
+void TelemetrySample::applyChannels(const float* v, flight::FlightData& d) {
+    using namespace flight::units;
+    d.pitch = Degrees(v[0]);
+    d.roll = Degrees(v[1]);
+    d.heading = Degrees(v[2]);
+    d.yaw = Degrees(v[2]);
+    d.airspeed = Knots(v[3]);
+    d.verticalSpeed = FeetPerMinute(v[4]);
+    d.altitude = Feet(v[5]);
+    d.position = glm::vec3(v[6], v[7], v[8]);
+    d.velocity = glm::vec3(v[9], v[10], v[11]);
+
+    // Base de cámara desde la actitud (inversa de attitudeFromBasis), para que
+    // la vista 3D siga a datos que no vienen de la cámara
+    const float h = Radians(d.heading).value(), p = Radians(d.pitch).value(), r = Radians(d.roll).value();
+    const glm::vec3 front(std::sin(h) * std::cos(p), std::sin(p), -std::cos(h) * std::cos(p));
+    const glm::vec3 levelRight(std::cos(h), 0.0f, std::sin(h));
+    const glm::vec3 levelUp = glm::cross(levelRight, front);
+    d.cameraFront = front;
+    d.cameraUp = levelUp * std::cos(r) - levelRight * std::sin(r);
+    d.cameraRight = glm::cross(d.cameraFront, d.cameraUp);
+}
+
+const char* TelemetrySample::channelName(int channel) {
+    static const char* names[kChannels] = {"pitch", "roll", "heading", "airspeed", "verticalSpeed", "altitude",
+                                           "posX", "posY", "posZ", "velX", "velY", "velZ"};
+    return channel >= 0 && channel < kChannels ? names[channel] : "?";
+}
+
+// ============================== Escritor ==============================
+
+TelemetryWriter::TelemetryWriter() = default;
+
+TelemetryWriter::~TelemetryWriter() { close(); }
+
+bool TelemetryWriter::open(const std::string& path, const Options& options) {
+    close();
+    options_ = options;
+    options_.chunkBytes = std::max<std::size_t>(kPageBytes, (options.chunkBytes + kPageBytes - 1) / kPageBytes * kPageBytes);
+    // El hilo anterior ya terminó (close): la cola se reemplaza sin carreras
+    queue_ = std::make_unique<SpscQueue<TelemetrySample>>(options.queueCapacity);
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "Failed to open telemetry log: " << path << std::endl;
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.codec = static_cast<std::uint8_t>(options_.codec);
+    header.channels = kChannels;
+    header.chunkBytes = static_cast<std::uint32_t>(options_.chunkBytes);
+    if (::pwrite(fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        std::cerr << "Failed to write telemetry header: " << path << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    chunkIndex_ = 0;
+    chunk_ = nullptr;
+    written_ = dropped_ = bytes_ = chunks_ = 0;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&TelemetryWriter::run, this);
+    return true;
+}
+
+void TelemetryWriter::close() {
+    if (fd_ < 0) return;
+
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) thread_.join(); // el hilo vacía la cola antes de salir
+
+    // Recortar el espacio no usado del último chunk
+    std::size_t size = kFirstChunkOffset;
+    if (chunk_) {
+        const std::size_t tail = sizeof(ChunkHeader) + used_;
+        finishChunk();
+        size += (chunkIndex_ - 1) * options_.chunkBytes + tail;
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+        std::cerr << "Failed to trim telemetry log" << std::endl;
+    ::close(fd_);
+    fd_ = -1;
+}
+
+bool TelemetryWriter::push(const TelemetrySample& sample) {
+    if (queue_ && queue_->push(sample)) return true;
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+TelemetryWriter::Stats TelemetryWriter::stats() const {
+    Stats s;
+    s.written = written_.load(std::memory_order_relaxed);
+    s.dropped = dropped_.load(std::memory_order_relaxed);
+    s.bytes = bytes_.load(std::memory_order_relaxed);
+    s.chunks = chunks_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void TelemetryWriter::run() {
+    TelemetrySample sample;
+    for (;;) {
+        bool any = false;
+        while (queue_->pop(sample)) {
+            append(sample);
+            any = true;
+        }
+        if (!any) {
+            if (!running_.load(std::memory_order_acquire)) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+bool TelemetryWriter::beginChunk() {
+    const std::size_t offset = kFirstChunkOffset + chunkIndex_ * options_.chunkBytes;
+    if (::ftruncate(fd_, static_cast<off_t>(offset + options_.chunkBytes)) != 0) {
+        std::cerr << "Failed to grow telemetry log" << std::endl;
+        return false;
+    }
+    void* map = ::mmap(nullptr, options_.chunkBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, static_cast<off_t>(offset));
+    if (map == MAP_FAILED) {
+        std::cerr << "Failed to map telemetry chunk " << chunkIndex_ << std::endl;
+        return false;
+    }
+
+    chunk_ = static_cast<unsigned char*>(map);
+    ChunkHeader header{};
+    header.magic = kChunkMagic;
+    std::memcpy(chunk_, &header, sizeof(header));
+    used_ = 0;
+
+    // Cada chunk se decodifica solo: sin valores previos
+    prevMicros_ = 0;
+    std::fill(std::begin(prevBits_), std::end(prevBits_), 0u);
+    ++chunkIndex_;
+    chunks_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void TelemetryWriter::finishChunk() {
+    if (!chunk_) return;
+    ::msync(chunk_, options_.chunkBytes, MS_ASYNC);
+    ::munmap(chunk_, options_.chunkBytes);
+    chunk_ = nullptr;
+}
+
+void TelemetryWriter::append(const TelemetrySample& sample) {
+    const std::size_t capacity = options_.chunkBytes - sizeof(ChunkHeader);
+    if (chunk_ && capacity - used_ < kMaxRecordBytes) finishChunk();
+    if (!chunk_ && !beginChunk()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    unsigned char* const start = chunk_ + sizeof(ChunkHeader) + used_;
+    unsigned char* p = start;
+
+    const std::int64_t micros = std::llround(sample.time * 1e6);
+    p = putVarint(p, zigzag(micros - prevMicros_));
+    prevMicros_ = micros;
+
+    if (options_.codec == TelemetryCodec::Raw) {
+        std::memcpy(p, sample.values, sizeof(sample.values));
+        p += sizeof(sample.values);
+    } else {
+        unsigned char* tags = p;
+        std::memset(tags, 0, kTagBytes);
+        p += kTagBytes;
+        for (int c = 0; c < kChannels; ++c) {
+            const std::uint32_t bits = floatBits(sample.values[c]);
+            std::uint32_t x = bits ^ prevBits_[c];
+            prevBits_[c] = bits;
+
+            const int n = significantBytes(x);
+            tags[c >> 1] |= static_cast<unsigned char>(n << ((c & 1) * 4));
+            for (int b = 0; b < n; ++b, x >>= 8) *p++ = static_cast<unsigned char>(x);
+        }
+    }
+
+    // Cabecera del chunk al día en cada registro: un log cortado sigue legible
+    ChunkHeader* header = reinterpret_cast<ChunkHeader*>(chunk_);
+    if (header->count == 0) header->firstTime = sample.time;
+    header->lastTime = sample.time;
+    header->count += 1;
+    used_ += static_cast<std::size_t>(p - start);
+    header->bytes = static_cast<std::uint32_t>(used_);
+
+    written_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(static_cast<std::uint64_t>(p - start), std::memory_order_relaxed);
+}
+
+// ============================== Lector ==============================
+
+bool TelemetryReader::open(const std::string& path) {
+    close();
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        std::cerr << "Failed to open telemetry log: " << path << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    FileHeader header{};
+    if (::fstat(fd_, &st) != 0 || static_cast<std::size_t>(st.st_size) < kFirstChunkOffset ||
+        ::pread(fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.channels != kChannels || header.codec > static_cast<std::uint8_t>(TelemetryCodec::Xor) ||
+        header.chunkBytes < kPageBytes) {
+        std::cerr << "Not a telemetry log (or unsupported version): " << path << std::endl;
+        close();
+        return false;
+    }
+
+    mapBytes_ = static_cast<std::size_t>(st.st_size);
+    void* map = ::mmap(nullptr, mapBytes_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+        std::cerr << "Failed to map telemetry log: " << path << std::endl;
+        close();
+        return false;
+    }
+    map_ = static_cast<const unsigned char*>(map);
+    chunkBytes_ = header.chunkBytes;
+    codec_ = static_cast<TelemetryCodec>(header.codec);
+
+    // Índice disperso: sólo las cabeceras de chunk
+    for (std::size_t offset = kFirstChunkOffset; offset + sizeof(ChunkHeader) <= mapBytes_; offset += chunkBytes_) {
+        ChunkHeader ch;
+        std::memcpy(&ch, map_ + offset, sizeof(ch));
+        const std::size_t available = std::min(chunkBytes_, mapBytes_ - offset) - sizeof(ChunkHeader);
+        if (ch.magic != kChunkMagic || ch.count == 0 || ch.bytes > available) break;
+        index_.push_back({ch.firstTime, ch.lastTime, ch.count, offset});
+        sampleCount_ += ch.count;
+    }
+
+    chunk_ = 0;
+    remaining_ = 0;
+    cursor_ = nullptr;
+    return true;
+}
+
+void TelemetryReader::close() {
+    if (map_) ::munmap(const_cast<unsigned char*>(map_), mapBytes_);
+    if (fd_ >= 0) ::close(fd_);
+    map_ = nullptr;
+    fd_ = -1;
+    index_.clear();
+    sampleCount_ = 0;
+    remaining_ = 0;
+    cursor_ = nullptr;
+}
+
+double TelemetryReader::startTime() const { return index_.empty() ? 0.0 : index_.front().firstTime; }
+double TelemetryReader::endTime() const { return index_.empty() ? 0.0 : index_.back().lastTime; }
+
+bool TelemetryReader::loadChunk(std::size_t chunk) {
+    if (chunk >= index_.size()) {
+        remaining_ = 0;
+        return false;
+    }
+    chunk_ = chunk;
+    remaining_ = index_[chunk].count;
+    cursor_ = map_ + index_[chunk].offset + sizeof(ChunkHeader);
+    prevMicros_ = 0;
+    std::fill(std::begin(prevBits_), std::end(prevBits_), 0u);
+    return true;
+}
+
+bool TelemetryReader::seek(double time) {
+    if (index_.empty()) return false;
+
+    // Último chunk que empieza en o antes de time
+    auto it = std::upper_bound(index_.begin(), index_.end(), time,
+                               [](double t, const IndexEntry& e) { return t < e.firstTime; });
+    const std::size_t chunk = it == index_.begin() ? 0 : static_cast<std::size_t>(it - index_.begin()) - 1;
+    if (!loadChunk(chunk)) return false;
+
+    // Avanzar dentro del chunk hasta la primera muestra >= time
+    while (remaining_ > 0) {
+        const unsigned char* saveCursor = cursor_;
+        const std::int64_t saveMicros = prevMicros_;
+        std::uint32_t saveBits[kChannels];
+        std::memcpy(saveBits, prevBits_, sizeof(saveBits));
+        const std::uint32_t saveRemaining = remaining_;
+
+        TelemetrySample s;
+        if (!next(s)) return false;
+        if (s.time >= time) {
+            // Deshacer: que next() vuelva a entregar esta muestra
+            chunk_ = chunk;
+            cursor_ = saveCursor;
+            prevMicros_ = saveMicros;
+            std::memcpy(prevBits_, saveBits, sizeof(saveBits));
+            remaining_ = saveRemaining;
+            return true;
+        }
+    }
+    return loadChunk(chunk + 1);
+}
+
+bool TelemetryReader::next(TelemetrySample& out) {
+    while (remaining_ == 0)
+        if (!loadChunk(cursor_ ? chunk_ + 1 : 0)) return false;
+
+    const IndexEntry& entry = index_[chunk_];
+    const unsigned char* end = map_ + entry.offset + sizeof(ChunkHeader) +
+                               std::min(chunkBytes_, mapBytes_ - entry.offset) - sizeof(ChunkHeader);
+    const unsigned char* p = cursor_;
+
+    std::uint64_t zz;
+    p = getVarint(p, end, zz);
+    if (!p) return false;
+    prevMicros_ += unzigzag(zz);
+    out.time = static_cast<double>(prevMicros_) * 1e-6;
+
+    if (codec_ == TelemetryCodec::Raw) {
+        if (end - p < static_cast<std::ptrdiff_t>(sizeof(out.values))) return false;
+        std::memcpy(out.values, p, sizeof(out.values));
+        p += sizeof(out.values);
+    } else {
+        if (end - p < kTagBytes) return false;
+        const unsigned char* tags = p;
+        p += kTagBytes;
+        for (int c = 0; c < kChannels; ++c) {
+            const int n = (tags[c >> 1] >> ((c & 1) * 4)) & 0xF;
+            if (n > 4 || end - p < n) return false;
+            std::uint32_t x = 0;
+            for (int b = 0; b < n; ++b) x |= static_cast<std::uint32_t>(*p++) << (8 * b);
+            prevBits_[c] ^= x;
+            out.values[c] = bitsFloat(prevBits_[c]);
+        }
+    }
+
+    cursor_ = p;
+    --remaining_;
+    return true;
+}
+
+} // namespace util
@@ -0,0 +1,160 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "flight/FlightData.h"
+#include "SpscQueue.h"
+
+namespace util {
+
+/**
+ * Log de telemetría de vuelo en disco, mapeado en memoria y por chunks.
+ *
+ * Archivo:
+ *   [página 0]  cabecera: "HTLM" | versión | codec | canales | tamaño de chunk
+ *   [chunk k]   en offset 4096 + k·chunkBytes, tamaño fijo (múltiplo de página):
+ *               cabecera de chunk (muestras, bytes usados, t inicial/final) + registros
+ *
+ * Cada chunk arranca desde cero (sin "valor previo"), así se decodifica solo:
+ * el índice disperso es la lista de tiempos iniciales de los chunks, que el
+ * lector arma leyendo sólo las cabeceras. Buscar un tiempo = búsqueda binaria
+ * de chunk + decodificar dentro de ese chunk.
+ *
+ * Registro: tiempo en µs como delta zigzag-varint + 12 canales float.
+ *   Raw: 4 bytes por canal.
+ *   Xor: bits XOR con la muestra anterior del mismo canal, guardando sólo los
+ *        bytes significativos (nibble de largo por canal). Sin pérdida.
+ *
+ * El frame loop sólo hace push() a una cola lock-free; un hilo escribe en el
+ * mapeo. Si la cola se llena la muestra se descarta y se cuenta (nunca bloquea).
+ */
+
+enum class TelemetryCodec : std::uint8_t {
+    Raw = 0,
+    Xor = 1,
+};
+
+struct TelemetrySample {
+    static constexpr int kChannels = 12;
+
+    double time = 0.0; // s
+    // pitch, roll, heading, airspeed, verticalSpeed, altitude, pos.xyz, vel.xyz
+    float values[kChannels] = {};
+
+    static TelemetrySample fromFlightData(const flight::FlightData& data, double time);
+    void applyTo(flight::FlightData& data) const { applyChannels(values, data); }
+    // Copia los canales (en el orden de values) a data y rearma la base de cámara
+    static void applyChannels(const float* values, flight::FlightData& data);
+    static const char* channelName(int channel);
+};
+
+class TelemetryWriter {
+public:
+    struct Options {
+        TelemetryCodec codec = TelemetryCodec::Xor;
+        std::size_t chunkBytes = 64 * 1024;   // múltiplo de página; acota lo que decodifica un seek
+        std::size_t queueCapacity = 1 << 16;  // ~65 s de margen a 1 kHz; se reserva en open()
+    };
+
+    struct Stats {
+        std::uint64_t written = 0;
+        std::uint64_t dropped = 0; // cola llena
+        std::uint64_t bytes = 0;   // payload codificado
+        std::uint64_t chunks = 0;
+    };
+
+    TelemetryWriter();
+    ~TelemetryWriter();
+
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    bool open(const std::string& path, const Options& options);
+    bool open(const std::string& path) { return open(path, Options{}); }
+    void close(); // vacía la cola, cierra el chunk y recorta el archivo
+
+    // Desde el frame loop / hilo de simulación: no bloquea ni reserva memoria
+    bool push(const TelemetrySample& sample);
+    bool push(const flight::FlightData& data, double time) { return push(TelemetrySample::fromFlightData(data, time)); }
+
+    bool isOpen() const { return fd_ >= 0; }
+    Stats stats() const;
+
+private:
+    void run();
+    bool beginChunk();
+    void append(const TelemetrySample& sample);
+    void finishChunk();
+
+    Options options_;
+    std::unique_ptr<SpscQueue<TelemetrySample>> queue_; // nullptr hasta el primer open()
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    // Sólo el hilo escritor
+    int fd_ = -1;
+    std::size_t chunkIndex_ = 0;
+    unsigned char* chunk_ = nullptr;
+    std::size_t used_ = 0;
+    std::int64_t prevMicros_ = 0;
+    std::uint32_t prevBits_[TelemetrySample::kChannels] = {};
+
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> bytes_{0};
+    std::atomic<std::uint64_t> chunks_{0};
+};
+
+class TelemetryReader {
+public:
+    TelemetryReader() = default;
+    ~TelemetryReader() { close(); }
+
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    std::size_t sampleCount() const { return sampleCount_; }
+    std::size_t chunkCount() const { return index_.size(); }
+    double startTime() const;
+    double endTime() const;
+    TelemetryCodec codec() const { return codec_; }
+
+    // Posiciona en la primera muestra con time >= t (índice disperso + decodificación)
+    bool seek(double time);
+    // Siguiente muestra en orden; false al final del log
+    bool next(TelemetrySample& out);
+
+private:
+    struct IndexEntry {
+        double firstTime;
+        double lastTime;
+        std::uint32_t count;
+        std::size_t offset;
+    };
+
+    bool loadChunk(std::size_t chunk);
+
+    int fd_ = -1;
+    const unsigned char* map_ = nullptr;
+    std::size_t mapBytes_ = 0;
+    std::size_t chunkBytes_ = 0;
+    TelemetryCodec codec_ = TelemetryCodec::Raw;
+    std::vector<IndexEntry> index_;
+    std::size_t sampleCount_ = 0;
+
+    // Cursor de decodificación
+    std::size_t chunk_ = 0;
+    std::uint32_t remaining_ = 0;
+    const unsigned char* cursor_ = nullptr;
+    std::int64_t prevMicros_ = 0;
+    std::uint32_t prevBits_[TelemetrySample::kChannels] = {};
+};
+
+} // namespace util
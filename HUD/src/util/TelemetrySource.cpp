@@ -0,0 +1,279 @@
+#include "TelemetrySource.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "flight/AircraftStateBatch.h"
+
+namespace util {
+
+namespace {
+
+const double kSyntheticRateHz = 100.0; // emisor sintético: tasa del lote de tráfico
+
+bool makeUnixAddress(const std::string& path, sockaddr_un& addr) {
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Invalid Unix socket path: " << path << std::endl;
+        return false;
+    }
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+sockaddr_in makeLoopbackAddress(int port) {
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<std::uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return addr;
+}
+
+} // namespace
+
+// ============================== Endpoint ==============================
+
+bool TelemetryEndpoint::parse(const std::string& text, TelemetryEndpoint& out) {
+    if (text.compare(0, 4, "udp:") == 0) {
+        out.kind = Kind::Udp;
+        out.port = std::atoi(text.c_str() + 4);
+        if (out.port > 0 && out.port < 65536) return true;
+    } else if (text.compare(0, 5, "unix:") == 0) {
+        out.kind = Kind::Unix;
+        out.path = text.substr(5);
+        if (!out.path.empty()) return true;
+    }
+    std::cerr << "Invalid telemetry endpoint '" << text << "' (expected udp:PORT or unix:PATH)" << std::endl;
+    return false;
+}
+
+// ============================== Reproducción ==============================
+
+bool TelemetryPlayback::open(const std::string& path) {
+    open_ = reader_.open(path);
+    if (!open_) return false;
+    if (reader_.sampleCount() == 0) {
+        std::cerr << "Telemetry log is empty: " << path << std::endl;
+        open_ = false;
+        return false;
+    }
+    seek(reader_.startTime());
+    return true;
+}
+
+void TelemetryPlayback::seek(double time) {
+    if (!open_) return;
+    clock_ = std::clamp(time, startTime(), endTime());
+    // Primera muestra >= clock_: como mucho un tick adelantada
+    hasCurrent_ = reader_.seek(clock_) && reader_.next(current_);
+    hasNext_ = hasCurrent_ && reader_.next(next_);
+}
+
+bool TelemetryPlayback::update(double dt, flight::FlightData& data) {
+    if (!open_) return false;
+
+    const double target = std::clamp(clock_ + dt * speed_, startTime(), endTime());
+    if (target < clock_) {
+        seek(target); // hacia atrás: el formato sólo decodifica hacia adelante
+    } else {
+        clock_ = target;
+        while (hasNext_ && next_.time <= clock_) {
+            current_ = next_;
+            hasNext_ = reader_.next(next_);
+        }
+    }
+
+    if (hasCurrent_) current_.applyTo(data);
+    return hasCurrent_;
+}
+
+// ============================== Receptor ==============================
+
+bool TelemetryReceiver::open(const TelemetryEndpoint& endpoint) {
+    close();
+
+    if (endpoint.kind == TelemetryEndpoint::Kind::Udp) {
+        fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        const sockaddr_in addr = makeLoopbackAddress(endpoint.port);
+        if (fd_ < 0 || ::bind(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "Failed to listen for telemetry on udp:" << endpoint.port << std::endl;
+            close();
+            return false;
+        }
+    } else {
+        sockaddr_un addr;
+        if (!makeUnixAddress(endpoint.path, addr)) return false;
+        ::unlink(endpoint.path.c_str()); // socket huérfano de una corrida anterior
+        fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd_ < 0 || ::bind(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "Failed to listen for telemetry on unix:" << endpoint.path << std::endl;
+            close();
+            return false;
+        }
+        unixPath_ = endpoint.path;
+    }
+
+    hasSequence_ = false;
+    stats_ = Stats{};
+    return true;
+}
+
+void TelemetryReceiver::close() {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    if (!unixPath_.empty()) ::unlink(unixPath_.c_str());
+    unixPath_.clear();
+}
+
+bool TelemetryReceiver::poll(flight::FlightData& data) {
+    if (fd_ < 0) return false;
+
+    // Los datagramas caen directo en packets_: el kernel es la única copia
+    iovec iov[kBatch];
+    mmsghdr msgs[kBatch];
+    std::memset(msgs, 0, sizeof(msgs));
+    for (int i = 0; i < kBatch; ++i) {
+        iov[i].iov_base = &packets_[i];
+        iov[i].iov_len = sizeof(TelemetryPacket);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    bool any = false;
+    for (;;) {
+        const int n = ::recvmmsg(fd_, msgs, kBatch, MSG_DONTWAIT, nullptr);
+        if (n <= 0) break;
+
+        const TelemetryPacket* newest = nullptr;
+        for (int i = 0; i < n; ++i) {
+            const TelemetryPacket& p = packets_[i];
+            if (msgs[i].msg_len != sizeof(TelemetryPacket) || (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) ||
+                p.magic != TelemetryPacket::kMagic) {
+                ++stats_.rejected;
+                continue;
+            }
+            // Diferencia con signo: tolera el desborde del contador
+            if (hasSequence_ && static_cast<std::int32_t>(p.sequence - lastSequence_) <= 0) {
+                ++stats_.stale;
+                continue;
+            }
+            hasSequence_ = true;
+            lastSequence_ = p.sequence;
+            newest = &p;
+            ++stats_.packets;
+        }
+
+        // Aplicar antes de que el próximo lote pise el arreglo
+        if (newest) {
+            TelemetrySample::applyChannels(newest->values, data);
+            lastTime_ = newest->time;
+            any = true;
+        }
+        if (n < kBatch) break;
+    }
+    return any;
+}
+
+// ============================== Emisor ==============================
+
+bool TelemetrySender::open(const TelemetryEndpoint& endpoint) {
+    close();
+
+    int rc = -1;
+    if (endpoint.kind == TelemetryEndpoint::Kind::Udp) {
+        fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        const sockaddr_in addr = makeLoopbackAddress(endpoint.port);
+        if (fd_ >= 0) rc = ::connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    } else {
+        sockaddr_un addr;
+        if (!makeUnixAddress(endpoint.path, addr)) return false;
+        fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd_ >= 0) rc = ::connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    }
+
+    if (rc != 0) {
+        std::cerr << "Failed to connect telemetry sender (is the receiver running?)" << std::endl;
+        close();
+        return false;
+    }
+    sequence_ = 0;
+    return true;
+}
+
+void TelemetrySender::close() {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+}
+
+bool TelemetrySender::send(const TelemetrySample& sample) {
+    if (fd_ < 0) return false;
+
+    TelemetryPacket p;
+    p.magic = TelemetryPacket::kMagic;
+    p.sequence = ++sequence_;
+    p.time = sample.time;
+    std::memcpy(p.values, sample.values, sizeof(p.values));
+    return ::send(fd_, &p, sizeof(p), MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(p));
+}
+
+int runTelemetrySender(const TelemetryEndpoint& endpoint, const std::string& logPath, double speed, double seconds) {
+    TelemetrySender sender;
+    if (!sender.open(endpoint)) return -1;
+    if (!(speed > 0.0)) speed = 1.0;
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    std::uint64_t failed = 0;
+
+    // Espera hasta que el reloj real alcance t (en tiempo de datos)
+    auto waitUntil = [&](double dataSeconds) {
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(
+                                                  std::chrono::duration<double>(dataSeconds / speed)));
+    };
+
+    if (!logPath.empty()) {
+        TelemetryReader reader;
+        if (!reader.open(logPath)) return -1;
+        std::cout << "Sending " << reader.sampleCount() << " samples from " << logPath << " at x" << speed << std::endl;
+
+        TelemetrySample s;
+        const double t0 = reader.startTime();
+        while (reader.next(s)) {
+            waitUntil(s.time - t0);
+            failed += sender.send(s) ? 0 : 1;
+        }
+    } else {
+        // Vuelo sintético: un avión virando suave, como en el bench de tráfico
+        flight::AircraftStateBatch batch(static_cast<float>(kSyntheticRateHz));
+        batch.resize(1);
+        batch.spawn(0, glm::vec3(0.0f, 300.0f, 0.0f), 0.0f, 55.0f);
+        flight::ControlInputs c;
+        c.aileron = 0.05f;
+        c.elevator = 0.02f;
+        batch.setControls(0, c);
+
+        const int total = static_cast<int>(seconds * kSyntheticRateHz);
+        std::cout << "Sending synthetic flight (" << seconds << " s) at x" << speed << std::endl;
+        for (int i = 1; i <= total; ++i) {
+            batch.advance(static_cast<float>(1.0 / kSyntheticRateHz));
+            batch.updateInstruments();
+            const double t = i / kSyntheticRateHz;
+            waitUntil(t);
+            failed += sender.send(TelemetrySample::fromFlightData(batch.view(0), t)) ? 0 : 1;
+        }
+    }
+
+    std::cout << "Sent " << sender.sent() - failed << "/" << sender.sent() << " packets" << std::endl;
+    return 0;
+}
+
+} // namespace util
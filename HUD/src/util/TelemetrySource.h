@@ -0,0 +1,138 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "flight/FlightData.h"
+#include "TelemetryLog.h"
+
+namespace util {
+
+/**
+ * Fuentes de FlightData que no son la cámara ni el modelo de vuelo:
+ *
+ *   TelemetryPlayback  reproduce un log de TelemetryWriter a cualquier
+ *                      velocidad (también hacia atrás) con seek.
+ *   TelemetryReceiver  recibe un stream local por UDP o socket Unix (datagramas).
+ *   TelemetrySender    el lado emisor, para pruebas (main --telemetry-send).
+ *
+ * En la red viaja TelemetryPacket tal cual en memoria (little-endian, 64 bytes).
+ * El receptor recibe directo sobre un arreglo de paquetes alineados y copia los
+ * canales a FlightData sin pasar por un buffer intermedio ni parsear texto.
+ */
+
+struct TelemetryPacket {
+    static constexpr std::uint32_t kMagic = 0x4B505448; // "HTPK"
+
+    std::uint32_t magic;
+    std::uint32_t sequence; // creciente por emisor; descarta duplicados y desordenados
+    double time;            // s, reloj del emisor
+    float values[TelemetrySample::kChannels];
+};
+static_assert(sizeof(TelemetryPacket) == 64, "TelemetryPacket es un formato de red: sin padding");
+
+// "udp:PUERTO" (127.0.0.1) o "unix:/ruta/al/socket"
+struct TelemetryEndpoint {
+    enum class Kind { Udp, Unix };
+
+    Kind kind = Kind::Udp;
+    int port = 0;
+    std::string path;
+
+    static bool parse(const std::string& text, TelemetryEndpoint& out);
+};
+
+class TelemetryPlayback {
+public:
+    bool open(const std::string& path);
+    bool isOpen() const { return open_; }
+
+    // Avanza el reloj dt·speed y aplica a data la última muestra con time <= reloj.
+    // Devuelve false si todavía no hay ninguna muestra para mostrar.
+    bool update(double dt, flight::FlightData& data);
+
+    void seek(double time); // se recorta a [startTime, endTime]
+    void setSpeed(double speed) { speed_ = speed; } // 0 = pausa, negativo = hacia atrás
+    double speed() const { return speed_; }
+
+    double time() const { return clock_; }
+    double startTime() const { return reader_.startTime(); }
+    double endTime() const { return reader_.endTime(); }
+    bool finished() const { return speed_ > 0.0 && clock_ >= endTime() && !hasNext_; }
+
+private:
+    TelemetryReader reader_;
+    bool open_ = false;
+    double clock_ = 0.0;
+    double speed_ = 1.0;
+
+    TelemetrySample current_, next_;
+    bool hasCurrent_ = false;
+    bool hasNext_ = false;
+};
+
+class TelemetryReceiver {
+public:
+    struct Stats {
+        std::uint64_t packets = 0;  // aplicados
+        std::uint64_t rejected = 0; // tamaño o magic inválidos
+        std::uint64_t stale = 0;    // secuencia vieja o repetida
+    };
+
+    TelemetryReceiver() = default;
+    ~TelemetryReceiver() { close(); }
+
+    TelemetryReceiver(const TelemetryReceiver&) = delete;
+    TelemetryReceiver& operator=(const TelemetryReceiver&) = delete;
+
+    bool open(const TelemetryEndpoint& endpoint);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+
+    // Drena lo pendiente sin bloquear y aplica a data el paquete más nuevo.
+    // true si llegó al menos uno válido.
+    bool poll(flight::FlightData& data);
+
+    double lastTime() const { return lastTime_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    static constexpr int kBatch = 32; // paquetes por recvmmsg
+
+    int fd_ = -1;
+    std::string unixPath_; // para borrar el socket al cerrar
+    bool hasSequence_ = false;
+    std::uint32_t lastSequence_ = 0;
+    double lastTime_ = 0.0;
+    Stats stats_;
+    TelemetryPacket packets_[kBatch];
+};
+
+class TelemetrySender {
+public:
+    TelemetrySender() = default;
+    ~TelemetrySender() { close(); }
+
+    TelemetrySender(const TelemetrySender&) = delete;
+    TelemetrySender& operator=(const TelemetrySender&) = delete;
+
+    bool open(const TelemetryEndpoint& endpoint);
+    void close();
+
+    // false si el datagrama no salió (p. ej. nadie escuchando en el socket Unix)
+    bool send(const TelemetrySample& sample);
+
+    std::uint32_t sent() const { return sequence_; }
+
+private:
+    int fd_ = -1;
+    std::uint32_t sequence_ = 0;
+};
+
+/**
+ * Emisor de prueba: manda el log `logPath` (o, si está vacío, un vuelo
+ * sintético de `seconds` segundos) al endpoint en tiempo real × speed.
+ * Devuelve el código de salida del proceso.
+ */
+int runTelemetrySender(const TelemetryEndpoint& endpoint, const std::string& logPath, double speed, double seconds);
+
+} // namespace util
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+
+namespace util {
+
+/**
+ * Triple buffer lock-free para un productor y un consumidor.
+ *
+ * El productor escribe en su buffer privado (writeBuffer) y lo publica con
+ * publish(); el consumidor llama a update() para tomar el último publicado y
+ * lo lee con read(). Ninguno de los dos espera nunca al otro: si el productor
+ * publica dos veces antes de que el consumidor mire, el valor intermedio se
+ * descarta (siempre se lee el más reciente).
+ *
+ * El índice "del medio" y un bit de "nuevo" viven en un único atómico; el
+ * intercambio usa acq_rel para que el contenido escrito sea visible al lector.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) : buffers_{initial, initial, initial} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- Productor ---
+    T& writeBuffer() { return buffers_[back_]; }
+    void publish() {
+        const unsigned prev = middle_.exchange(back_ | kNewBit, std::memory_order_acq_rel);
+        back_ = prev & kIndexMask;
+    }
+
+    // --- Consumidor ---
+    // true si había un valor nuevo (read() ya lo devuelve)
+    bool update() {
+        if (!(middle_.load(std::memory_order_relaxed) & kNewBit)) return false;
+        const unsigned prev = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = prev & kIndexMask;
+        return true;
+    }
+    const T& read() const { return buffers_[front_]; }
+
+private:
+    static constexpr unsigned kIndexMask = 0x3;
+    static constexpr unsigned kNewBit = 0x4;
+
+    // Cada índice en su propia línea de caché: productor y consumidor no se pisan
+    T buffers_[3];
+    alignas(64) unsigned back_ = 0;             // sólo productor
+    alignas(64) std::atomic<unsigned> middle_{1};
+    alignas(64) unsigned front_ = 2;            // sólo consumidor
+};
+
+} // namespace util
@@ -0,0 +1,127 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+namespace util {
+
+namespace {
+
+std::uint64_t packRange(std::uint64_t begin, std::uint64_t end) {
+    return begin | (end << 32);
+}
+
+} // namespace
+
+WorkerPool::WorkerPool(unsigned workers) : ranges_(new Range[workers + 1]) {
+    threads_.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i)
+        threads_.emplace_back(&WorkerPool::run, this, i + 1);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : threads_)
+        t.join();
+}
+
+unsigned WorkerPool::defaultWorkers(unsigned cap) {
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    return std::min(hw - 1, cap);
+}
+
+void WorkerPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (count == 0)
+        return;
+    if (threads_.empty() || count == 1) {
+        for (std::size_t i = 0; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    // Un rango contiguo por participante (los primeros se llevan el resto)
+    const std::size_t participants = threads_.size() + 1;
+    const std::size_t base = count / participants, extra = count % participants;
+    std::size_t begin = 0;
+    for (std::size_t p = 0; p < participants; ++p) {
+        const std::size_t end = begin + base + (p < extra ? 1 : 0);
+        ranges_[p].bounds.store(packRange(begin, end), std::memory_order_relaxed);
+        begin = end;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        active_.store(static_cast<unsigned>(threads_.size()), std::memory_order_relaxed);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    work(0);
+
+    // Esperar a que todos salgan: lo que escribieron queda visible (acquire)
+    while (active_.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+}
+
+void WorkerPool::run(unsigned self) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_)
+                return;
+            seen = generation_;
+        }
+        work(self);
+        active_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void WorkerPool::work(unsigned self) {
+    const std::function<void(std::size_t)>& fn = *job_;
+    std::size_t index;
+    while (takeFront(self, index))
+        fn(index);
+
+    // Los rangos sólo se achican: una pasada por cada víctima alcanza
+    const unsigned participants = static_cast<unsigned>(threads_.size()) + 1;
+    for (unsigned k = 1; k < participants; ++k) {
+        const unsigned victim = (self + k) % participants;
+        while (stealBack(victim, index))
+            fn(index);
+    }
+}
+
+bool WorkerPool::takeFront(unsigned owner, std::size_t& index) {
+    std::atomic<std::uint64_t>& bounds = ranges_[owner].bounds;
+    std::uint64_t cur = bounds.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::uint64_t begin = cur & 0xFFFFFFFFu, end = cur >> 32;
+        if (begin >= end)
+            return false;
+        if (bounds.compare_exchange_weak(cur, packRange(begin + 1, end), std::memory_order_acq_rel)) {
+            index = static_cast<std::size_t>(begin);
+            return true;
+        }
+    }
+}
+
+bool WorkerPool::stealBack(unsigned victim, std::size_t& index) {
+    std::atomic<std::uint64_t>& bounds = ranges_[victim].bounds;
+    std::uint64_t cur = bounds.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::uint64_t begin = cur & 0xFFFFFFFFu, end = cur >> 32;
+        if (begin >= end)
+            return false;
+        if (bounds.compare_exchange_weak(cur, packRange(begin, end - 1), std::memory_order_acq_rel)) {
+            index = static_cast<std::size_t>(end - 1);
+            return true;
+        }
+    }
+}
+
+} // namespace util
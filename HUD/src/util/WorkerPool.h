@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+/**
+ * Pool chico de hilos persistentes para loops paralelos por frame.
+ *
+ * parallelFor(count, fn) reparte [0, count) en un rango contiguo por
+ * participante (los workers + el hilo llamador, que también trabaja). Cada
+ * uno consume su rango desde el frente; al vaciarlo roba desde el fondo de
+ * los rangos ajenos. Un rango es un único atómico de 64 bits (inicio|fin):
+ * tomar y robar son un CAS, sin locks. Así una tarea cara (un instrumento
+ * con muchas marcas) no deja a los demás esperando.
+ *
+ * Los hilos duermen en una condition_variable entre llamadas; parallelFor
+ * vuelve cuando todos salieron del trabajo, así fn y lo que captura pueden
+ * vivir en el stack del llamador. No es reentrante: una llamada a la vez.
+ */
+class WorkerPool {
+public:
+    // workers = hilos extra (0 = ninguno: parallelFor corre en el llamador)
+    explicit WorkerPool(unsigned workers);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+    unsigned workers() const { return static_cast<unsigned>(threads_.size()); }
+
+    // Hilos extra razonables para trabajo de frame: hardware − 1, con tope
+    static unsigned defaultWorkers(unsigned cap);
+
+private:
+    struct alignas(64) Range {
+        std::atomic<std::uint64_t> bounds{0}; // inicio en los 32 bits bajos, fin en los altos
+    };
+
+    void run(unsigned self);
+    void work(unsigned self);
+    bool takeFront(unsigned owner, std::size_t& index);
+    bool stealBack(unsigned victim, std::size_t& index);
+
+    std::vector<std::thread> threads_;
+    std::unique_ptr<Range[]> ranges_; // participante 0 = llamador, 1..N = workers
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::uint64_t generation_ = 0; // una por parallelFor
+    bool stop_ = false;
+
+    const std::function<void(std::size_t)>* job_ = nullptr;
+    std::atomic<unsigned> active_{0}; // workers que todavía no terminaron la llamada actual
+};
+
+} // namespace util